@@ -0,0 +1,383 @@
+/*____________________________________________________________________
+|
+| File: assets.cpp
+|
+| Description: Asset cache.  Every screen used to read its objects and
+|   textures from disk when it started and free them when it ended, so
+|   going from the game over screen back to a new game read everything
+|   again.  Here an asset is found by its files and load flags and
+|   counted each time it is handed out.  When the count goes back to 0
+|   the asset is kept loaded; only when the cache is full is the asset
+|   released the longest ago freed to make room.  A load that finds no
+|   room is not cached, and its release frees it.
+|
+| Functions: Asset_Object
+|            Asset_Object_First_Use
+|            Asset_Texture
+|            Asset_Release_Object
+|            Asset_Release_Texture
+|            Asset_Free_All
+|            Asset_Report
+|             Find_Asset
+|             New_Asset
+|             Release
+|             Free_Asset
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <first_header.h>
+#include "dp.h"
+
+#include <string.h>
+
+#include "assets.h"
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define MAX_ASSETS				128
+#define MAX_ASSET_PATH			128
+
+#define ASSET_OBJECT			0
+#define ASSET_TEXTURE			1
+
+/*___________________
+|
+| Type definitions
+|__________________*/
+
+// A loaded asset and the key it was loaded with
+struct Asset {
+	int type;							// ASSET_OBJECT or ASSET_TEXTURE (-1 marks a free entry)
+	char filename[MAX_ASSET_PATH];
+	char alpha_filename[MAX_ASSET_PATH]; // textures
+	int vertex_format, flags;
+	int copy;							// objects
+	bool used;							// objects: Asset_Object_First_Use was called since it was read
+	gx3dObject *object;
+	gx3dTexture texture;
+	int references;
+	unsigned released;					// when the references went to 0 (for eviction)
+};
+
+/*___________________
+|
+| Function prototypes
+|__________________*/
+
+static Asset *Find_Asset (int type, char *filename, char *alpha_filename, int vertex_format, int flags, int copy);
+static Asset *New_Asset ();
+static void Release (Asset *a);
+static void Free_Asset (Asset *a);
+
+/*___________________
+|
+| Global variables
+|__________________*/
+
+static Asset asset[MAX_ASSETS];
+static bool assets_initialized;
+static unsigned release_clock;
+
+// Since the last report
+static unsigned hits, misses, evictions;
+
+/*____________________________________________________________________
+|
+| Function: Asset_Object
+|
+| Input: Called from Init_LoadingScreen, Init_TitleScreen,
+|   Init_GameScreen, Load_Lods
+| Output: Returns a reference to an object, reading it only if it is not
+|   in the cache.  Returns 0 if it could not be read.
+|___________________________________________________________________*/
+
+gx3dObject *Asset_Object (char *filename, int vertex_format, int flags, int copy)
+{
+	Asset *a = Find_Asset (ASSET_OBJECT, filename, 0, vertex_format, flags, copy);
+	if (a) {
+		a->references++;
+		hits++;
+		return (a->object);
+	}
+
+	gx3dObject *object = 0;
+	gx3d_ReadLWO2File (filename, &object, vertex_format, flags);
+	misses++;
+	if (object == 0)
+		return (0);
+
+	if (strlen (filename) < MAX_ASSET_PATH AND (a = New_Asset ()) != 0) {
+		a->type = ASSET_OBJECT;
+		strcpy (a->filename, filename);
+		a->alpha_filename[0] = 0;
+		a->vertex_format = vertex_format;
+		a->flags = flags;
+		a->copy = copy;
+		a->used = false;
+		a->object = object;
+		a->texture = 0;
+		a->references = 1;
+	}
+
+	return (object);
+}
+
+/*____________________________________________________________________
+|
+| Function: Asset_Object_First_Use
+|
+| Input: Called from Init_GameScreen
+| Output: Returns true the first time it is called for an object since
+|   the object was read from disk (always for an object the cache could
+|   not keep, since its release frees it).
+|___________________________________________________________________*/
+
+bool Asset_Object_First_Use (gx3dObject *object)
+{
+	for (int i = 0; assets_initialized AND i < MAX_ASSETS; i++)
+		if (asset[i].type == ASSET_OBJECT AND asset[i].object == object) {
+			bool first = NOT asset[i].used;
+			asset[i].used = true;
+			return (first);
+		}
+
+	return (true);
+}
+
+/*____________________________________________________________________
+|
+| Function: Asset_Texture
+|
+| Input: Called from Init_LoadingScreen, Init_TitleScreen,
+|   Init_GameScreen, Init_GameOverScreen, Load_Impostor
+| Output: Returns a reference to a texture, loading it only if it is not
+|   in the cache.
+|___________________________________________________________________*/
+
+gx3dTexture Asset_Texture (char *filename, char *alpha_filename, int flags)
+{
+	Asset *a = Find_Asset (ASSET_TEXTURE, filename, alpha_filename, 0, flags, 0);
+	if (a) {
+		a->references++;
+		hits++;
+		return (a->texture);
+	}
+
+	gx3dTexture texture = gx3d_InitTexture_File (filename, alpha_filename, flags);
+	misses++;
+	if (texture == 0)
+		return (0);
+
+	if (strlen (filename) < MAX_ASSET_PATH AND (alpha_filename == 0 OR strlen (alpha_filename) < MAX_ASSET_PATH) AND (a = New_Asset ()) != 0) {
+		a->type = ASSET_TEXTURE;
+		strcpy (a->filename, filename);
+		strcpy (a->alpha_filename, alpha_filename ? alpha_filename : "");
+		a->vertex_format = 0;
+		a->flags = flags;
+		a->copy = 0;
+		a->object = 0;
+		a->texture = texture;
+		a->references = 1;
+	}
+
+	return (texture);
+}
+
+/*____________________________________________________________________
+|
+| Function: Asset_Release_Object
+|
+| Input: Called from Free_TitleScreen, Free_GameScreen,
+|   Free_GameOverScreen
+| Output: Drops a reference to an object (frees it if it is not cached).
+|___________________________________________________________________*/
+
+void Asset_Release_Object (gx3dObject *object)
+{
+	if (object == 0)
+		return;
+
+	for (int i = 0; assets_initialized AND i < MAX_ASSETS; i++)
+		if (asset[i].type == ASSET_OBJECT AND asset[i].object == object) {
+			if (asset[i].references)
+				Release (&asset[i]);
+			return;
+		}
+
+	// Not cached, so this was the only reference
+	gx3d_FreeObject (object);
+}
+
+/*____________________________________________________________________
+|
+| Function: Asset_Release_Texture
+|
+| Input: Called from Free_TitleScreen, Free_GameScreen,
+|   Free_GameOverScreen
+| Output: Drops a reference to a texture (frees it if it is not cached).
+|___________________________________________________________________*/
+
+void Asset_Release_Texture (gx3dTexture texture)
+{
+	if (texture == 0)
+		return;
+
+	for (int i = 0; assets_initialized AND i < MAX_ASSETS; i++)
+		if (asset[i].type == ASSET_TEXTURE AND asset[i].texture == texture) {
+			if (asset[i].references)
+				Release (&asset[i]);
+			return;
+		}
+
+	// Not cached, so this was the only reference
+	gx3d_FreeTexture (texture);
+}
+
+/*____________________________________________________________________
+|
+| Function: Asset_Free_All
+|
+| Input: Called from Render_Free
+| Output: Frees every cached asset and empties the cache.
+|___________________________________________________________________*/
+
+void Asset_Free_All ()
+{
+	if (NOT assets_initialized)
+		return;
+
+	for (int i = 0; i < MAX_ASSETS; i++)
+		if (asset[i].type != -1)
+			Free_Asset (&asset[i]);
+}
+
+/*____________________________________________________________________
+|
+| Function: Asset_Report
+|
+| Input: Called from Render_TitleScreen, Render_GameScreen,
+|   Render_GameOverScreen
+| Output: Writes to DEBUG.TXT the cache hits, misses and evictions since
+|   the last report and the assets loaded, and starts counting again.
+|___________________________________________________________________*/
+
+void Asset_Report (char *screen)
+{
+	char str[200];
+	int loaded = 0, unused = 0;
+
+	for (int i = 0; assets_initialized AND i < MAX_ASSETS; i++)
+		if (asset[i].type != -1) {
+			loaded++;
+			if (asset[i].references == 0)
+				unused++;
+		}
+
+	sprintf (str, "%s: %u asset cache hits, %u misses, %u evicted (%d assets loaded, %d unused)",
+		screen, hits, misses, evictions, loaded, unused);
+	DEBUG_WRITE (str);
+
+	hits = 0;
+	misses = 0;
+	evictions = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Find_Asset
+|
+| Input: Called from Asset_Object, Asset_Texture
+| Output: Returns the cached asset loaded with a key, or 0.
+|___________________________________________________________________*/
+
+static Asset *Find_Asset (int type, char *filename, char *alpha_filename, int vertex_format, int flags, int copy)
+{
+	if (NOT assets_initialized) {
+		for (int i = 0; i < MAX_ASSETS; i++)
+			asset[i].type = -1;
+		assets_initialized = true;
+	}
+
+	for (int i = 0; i < MAX_ASSETS; i++) {
+		Asset *a = &asset[i];
+		if (a->type == type AND a->vertex_format == vertex_format AND a->flags == flags AND a->copy == copy
+			AND strcmp (a->filename, filename) == 0
+			AND strcmp (a->alpha_filename, alpha_filename ? alpha_filename : "") == 0)
+			return (a);
+	}
+
+	return (0);
+}
+
+/*____________________________________________________________________
+|
+| Function: New_Asset
+|
+| Input: Called from Asset_Object, Asset_Texture
+| Output: Returns a free entry, freeing the unused asset released the
+|   longest ago if there is none.  Returns 0 if every asset is in use.
+|___________________________________________________________________*/
+
+static Asset *New_Asset ()
+{
+	Asset *oldest = 0;
+
+	for (int i = 0; i < MAX_ASSETS; i++) {
+		if (asset[i].type == -1)
+			return (&asset[i]);
+		if (asset[i].references == 0 AND (oldest == 0 OR asset[i].released < oldest->released))
+			oldest = &asset[i];
+	}
+
+	if (oldest) {
+		Free_Asset (oldest);
+		evictions++;
+	}
+
+	return (oldest);
+}
+
+/*____________________________________________________________________
+|
+| Function: Release
+|
+| Input: Called from Asset_Release_Object, Asset_Release_Texture
+| Output: Drops a reference, keeping the asset loaded.
+|___________________________________________________________________*/
+
+static void Release (Asset *a)
+{
+	if (--a->references == 0)
+		a->released = release_clock++;
+}
+
+/*____________________________________________________________________
+|
+| Function: Free_Asset
+|
+| Input: Called from Asset_Free_All, New_Asset
+| Output: Frees an asset and its entry.
+|___________________________________________________________________*/
+
+static void Free_Asset (Asset *a)
+{
+	if (a->type == ASSET_OBJECT)
+		gx3d_FreeObject (a->object);
+	else
+		gx3d_FreeTexture (a->texture);
+	a->type = -1;
+	a->references = 0;
+}
@@ -0,0 +1,38 @@
+/*____________________________________________________________________
+|
+| File: assets.h
+|
+| Description: Cache of the objects and textures loaded from disk,
+|   shared between the screens.  Each load hands out a counted reference
+|   to the asset already loaded with the same files and flags, and assets
+|   nobody holds stay loaded for the next screen that asks for them.
+|   Include after dp.h.
+|___________________________________________________________________*/
+
+// Loads an object from a LightWave file, or takes another reference to
+// the one already loaded with the same file, formats and copy number.
+// Objects are shared with their layer matrices, so users that set the
+// same layer differently need different copy numbers.  Returns 0 if the
+// file could not be read.
+gx3dObject *Asset_Object (char *filename, int vertex_format, int flags, int copy);
+
+// Returns true the first time it is called for an object since it was
+// read from disk, so set up that stays with the object (like attaching
+// a skeleton) is done once per load
+bool Asset_Object_First_Use (gx3dObject *object);
+
+// Loads a texture (alpha_filename may be 0), or takes another reference
+// to the one already loaded with the same files and flags
+gx3dTexture Asset_Texture (char *filename, char *alpha_filename, int flags);
+
+// Drops a reference.  The asset stays loaded, until the cache needs its
+// room, in case a screen asks for it again.
+void Asset_Release_Object (gx3dObject *object);
+void Asset_Release_Texture (gx3dTexture texture);
+
+// Frees every asset the cache holds, whether or not it is still used
+void Asset_Free_All ();
+
+// Writes to DEBUG.TXT the loads found in the cache (hits) and read from
+// disk (misses) since the last report
+void Asset_Report (char *screen);
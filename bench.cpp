@@ -0,0 +1,671 @@
+/*____________________________________________________________________
+|
+| File: bench.cpp
+|
+| Description: Headless benchmarks for the gameplay simulation.
+|   - Per-step enemy update: the Hoshu and Hoshu laser update of the
+|     game before the simulation used the structure of arrays store
+|     (one struct per Hoshu with its laser inside) against Sim_Update of
+|     sim.cpp, at 100, 1,000 and 10,000 enemies.  Both sides keep the
+|     population constant by respawning recycled Hoshus at the front.
+|   - Sphere batch kernel: time per candidate sphere for the scalar and
+|     vector paths of Collide_Sphere_Batch.
+|   - Job scaling: Sim_Update with 10,000 Hoshus and their lasers over
+|     1 to N job threads.
+|   - Asset loading: time until every file of a list is read, and the
+|     MB/s, with 1 to N reader threads.  Reads the files named on the
+|     command line (for example bench Objects\*.lwo Objects\Images\*.bmp),
+|     else files it writes itself.  Files that are in the system file
+|     cache already time memory, not the disk.
+|
+|   Build: g++ -O2 -DMAX_ENEMY_COUNT=10000 -DMAX_PROJECTILE_COUNT=16384 bench.cpp sim.cpp collide.cpp jobs.cpp readahead.cpp -lpthread -o bench
+|   (build without the counts to time the shipping 100 enemies,
+|   add -mavx2 to time the AVX2 path)
+|
+| Functions: main
+|             Kernel_Bench
+|             Job_Bench
+|             Load_Bench
+|             Old_Init
+|             Old_Update
+|             New_Init
+|             New_Update
+|             Spawn_New
+|             Random_Float
+|             Seconds
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+
+#include "sim.h"
+#include "collide.h"
+#include "jobs.h"
+#include "readahead.h"
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define BENCH_STEPS			2000
+#define BENCH_RUNS			5 // the best run is reported
+#define BENCH_SPAWN_Z		3000.0f // same as Spawn_Hoshu
+#define BENCH_RECYCLE_Z		-200.0f // same as ground_init_z
+#define BENCH_RAIU_HP		1000000000 // enough that the character survives every laser
+#define BENCH_KERNEL_COUNT	100000 // most candidate spheres in a kernel batch
+#define BENCH_KERNEL_TESTS	20000000 // candidates tested per timing
+#define BENCH_JOB_COUNT		10000 // Hoshus in the job scaling workload
+#define BENCH_LOAD_FILES	64 // files written when none are given
+#define BENCH_LOAD_SIZE		(2 * 1024 * 1024) // bytes per file written
+
+/*___________________
+|
+| Type definitions
+|__________________*/
+
+// Layout of a laser before the projectile pool
+struct Old_Laser {
+	simSphere sphere;
+	simVector pos;
+	simVector distance;
+	simTrajectory trajectory;
+	bool hit;
+	int hit_index;
+	float world_shift;
+	bool destroyed;
+	bool draw;
+	float hit_timer;
+};
+
+// Layout of a Hoshu before the structure of arrays store
+struct Old_Hoshu {
+	simSphere sphere;
+	simVector pos;
+	float angle;
+	int lv;
+	int hp;
+	int score_amt;
+	int exp_amt;
+	int gun_damage;
+	unsigned gun_delay;
+	unsigned gun_timer;
+	float fire_rate;
+	Old_Laser laser[1];
+	int laser_index;
+	float explosion_timer;
+	int explosion_type;
+	bool blade_mark_1;
+	bool blade_mark_2;
+	bool draw;
+};
+
+/*___________________
+|
+| Function prototypes
+|__________________*/
+
+static void Kernel_Bench ();
+static void Job_Bench ();
+static void Load_Bench (int argc, char **argv);
+static void Old_Init (int n);
+static void Old_Update ();
+static void New_Init (int n);
+static void New_Update ();
+static void Spawn_New (float z);
+static float Random_Float ();
+static double Seconds ();
+
+/*___________________
+|
+| Global variables
+|__________________*/
+
+static Old_Hoshu old_hoshu[MAX_ENEMY_COUNT];
+static int old_count;
+static simSphere raiu_sphere = { { 0, 3, 0 }, 2 };
+static simSphere hoshu_sphere = { { 0, 3, 0 }, 3 };
+static simSphere laser_sphere = { { 0, 0, 0 }, 0.5f };
+static int old_raiu_hp;
+static SimFrame *frame; // the simulation's own frame, written to set up the Hoshus
+static SimInput input;
+static int new_count;
+static unsigned random_state;
+static float kernel_x[BENCH_KERNEL_COUNT], kernel_y[BENCH_KERNEL_COUNT], kernel_z[BENCH_KERNEL_COUNT], kernel_radius[BENCH_KERNEL_COUNT];
+static unsigned kernel_hits[COLLIDE_MASK_WORDS(BENCH_KERNEL_COUNT)], kernel_scalar_hits[COLLIDE_MASK_WORDS(BENCH_KERNEL_COUNT)];
+
+/*____________________________________________________________________
+|
+| Function: main
+|
+| Input: -
+| Output: Prints the time per step for both updates, then the sphere
+|   batch kernel, job scaling and asset loading timings.
+|___________________________________________________________________*/
+
+int main (int argc, char **argv)
+{
+	int counts[] = { 100, 1000, 10000 };
+
+	printf ("%8s %14s %14s %8s %14s\n", "enemies", "old (us/step)", "sim (us/step)", "speedup", "lasers old/sim");
+	for (int c = 0; c < 3; c++) {
+		int n = counts[c];
+		if (n > MAX_ENEMY_COUNT OR n > MAX_PROJECTILE_COUNT) {
+			printf ("%8d skipped (build with -DMAX_ENEMY_COUNT=%d -DMAX_PROJECTILE_COUNT=%d)\n", n, n, n);
+			continue;
+		}
+
+		// Best of several runs, so a run slowed down by the system does not count
+		double old_time = 0, new_time = 0;
+		for (int r = 0; r < BENCH_RUNS; r++) {
+			Old_Init (n);
+			double start = Seconds();
+			for (int s = 0; s < BENCH_STEPS; s++)
+				Old_Update ();
+			double time = (Seconds() - start) / BENCH_STEPS * 1e6;
+			if (r == 0 OR time < old_time)
+				old_time = time;
+
+			New_Init (n);
+			start = Seconds();
+			for (int s = 0; s < BENCH_STEPS; s++)
+				New_Update ();
+			time = (Seconds() - start) / BENCH_STEPS * 1e6;
+			if (r == 0 OR time < new_time)
+				new_time = time;
+		}
+
+		int old_lasers = 0;
+		for (int i = 0; i < n; i++)
+			old_lasers += old_hoshu[i].laser[0].draw;
+
+		printf ("%8d %14.2f %14.2f %7.2fx %7d/%d\n", n, old_time, new_time, old_time / new_time, old_lasers, frame->projectiles.count);
+	}
+	printf ("\n");
+
+	Kernel_Bench ();
+	printf ("\n");
+
+	Job_Bench ();
+	printf ("\n");
+
+	Load_Bench (argc, argv);
+
+	return 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Kernel_Bench
+|
+| Input: Called from main
+| Output: Prints the time per candidate sphere for the scalar and the
+|   vector sphere batch tests, for small and large batches.
+|___________________________________________________________________*/
+
+static void Kernel_Bench ()
+{
+	int counts[] = { 16, 1000, BENCH_KERNEL_COUNT };
+	simSphere query = { { 0, 3, 0 }, 2 };
+
+	// Candidates scattered around the query so that some of them overlap
+	for (int i = 0; i < BENCH_KERNEL_COUNT; i++) {
+		kernel_x[i] = (float)(i % 41) - 20;
+		kernel_y[i] = 3;
+		kernel_z[i] = (float)(i % 53) - 26;
+		kernel_radius[i] = 3;
+	}
+
+	printf ("%8s %14s %14s %8s %6s\n", "spheres", "scalar (ns)", "batch (ns)", "speedup", "hits");
+	for (int c = 0; c < 3; c++) {
+		int n = counts[c];
+		int repeat = BENCH_KERNEL_TESTS / n;
+		int scalar_hits = 0, batch_hits = 0;
+
+		double start = Seconds();
+		for (int r = 0; r < repeat; r++) {
+			query.center.x = (float)(r & 1); // keep the compiler from hoisting the test out of the loop
+			scalar_hits += Collide_Sphere_Batch_Scalar (&query, kernel_x, kernel_y, kernel_z, kernel_radius, n, kernel_scalar_hits);
+		}
+		double scalar_time = (Seconds() - start) / ((double)repeat * n) * 1e9;
+
+		start = Seconds();
+		for (int r = 0; r < repeat; r++) {
+			query.center.x = (float)(r & 1);
+			batch_hits += Collide_Sphere_Batch (&query, kernel_x, kernel_y, kernel_z, kernel_radius, n, kernel_hits);
+		}
+		double batch_time = (Seconds() - start) / ((double)repeat * n) * 1e9;
+
+		// Both paths must agree
+		if (scalar_hits != batch_hits OR memcmp (kernel_hits, kernel_scalar_hits, COLLIDE_MASK_WORDS(n) * sizeof(unsigned)))
+			printf ("%8d hit masks differ\n", n);
+		else
+			printf ("%8d %14.3f %14.3f %7.2fx %6d\n", n, scalar_time, batch_time, scalar_time / batch_time, batch_hits / repeat);
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Job_Bench
+|
+| Input: Called from main
+| Output: Prints the time per step of Sim_Update for every number of
+|   job threads from 1 to the number of hardware threads.
+|___________________________________________________________________*/
+
+static void Job_Bench ()
+{
+	int max_threads = (int)std::thread::hardware_concurrency ();
+	double one_thread_time = 0;
+	unsigned one_thread_state = 0;
+
+	if (BENCH_JOB_COUNT > MAX_ENEMY_COUNT OR BENCH_JOB_COUNT > MAX_PROJECTILE_COUNT) {
+		printf ("job scaling skipped (build with -DMAX_ENEMY_COUNT=%d -DMAX_PROJECTILE_COUNT=%d)\n", BENCH_JOB_COUNT, BENCH_JOB_COUNT);
+		return;
+	}
+	if (max_threads < 1)
+		max_threads = 1;
+
+	printf ("%8s %14s %8s (%d Hoshus, %d hardware threads)\n", "threads", "us/step", "speedup", BENCH_JOB_COUNT, max_threads);
+	for (int threads = 1; threads <= max_threads; threads++) {
+		Jobs_Init (threads);
+		New_Init (BENCH_JOB_COUNT);
+
+		double start = Seconds();
+		for (int s = 0; s < BENCH_STEPS; s++)
+			New_Update ();
+		double time = (Seconds() - start) / BENCH_STEPS * 1e6;
+		Jobs_Free ();
+
+		// Every thread count must leave the game in the same state
+		unsigned state = frame->projectiles.count + (unsigned)frame->raiu.hp;
+		for (int k = 0; k < frame->enemies.count; k++) {
+			int i = HOSHU_SLOT(&frame->enemies, k);
+			state = state * 31 + frame->enemies.gun_timer[i] + (unsigned)(frame->enemies.angle[i] * 1000) + (unsigned)frame->enemies.pos[i].z;
+		}
+		if (threads == 1) {
+			one_thread_time = time;
+			one_thread_state = state;
+		}
+		if (state != one_thread_state)
+			printf ("%8d results differ\n", threads);
+		else
+			printf ("%8d %14.2f %7.2fx\n", threads, time, one_thread_time / time);
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Load_Bench
+|
+| Input: Called from main
+| Output: Prints the time until every file of the list is read and the
+|   MB/s, for 1 to N reader threads.  Each thread count reads the list
+|   once before it is timed, so every count starts from the same cache.
+|___________________________________________________________________*/
+
+static void Load_Bench (int argc, char **argv)
+{
+	static char names[BENCH_LOAD_FILES][32];
+	char *files[MAX_READ_AHEAD_FILES];
+	int count = 0;
+	bool written = false;
+	int max_threads = (int)std::thread::hardware_concurrency ();
+	double one_thread_time = 0;
+
+	for (int i = 1; i < argc AND count < MAX_READ_AHEAD_FILES; i++)
+		files[count++] = argv[i];
+
+	// No files given, so write some
+	if (count == 0) {
+		char *data = new char [BENCH_LOAD_SIZE];
+		for (int i = 0; i < BENCH_LOAD_SIZE; i++)
+			data[i] = (char)(i * 7);
+		for (int i = 0; i < BENCH_LOAD_FILES; i++) {
+			sprintf (names[i], "bench_load_%02d.tmp", i);
+			FILE *fp = fopen (names[i], "wb");
+			if (fp == 0)
+				break;
+			fwrite (data, 1, BENCH_LOAD_SIZE, fp);
+			fclose (fp);
+			files[count++] = names[i];
+		}
+		delete [] data;
+		written = true;
+	}
+	if (count == 0) {
+		printf ("asset loading skipped (no files to read)\n");
+		return;
+	}
+	if (max_threads < 1)
+		max_threads = 1;
+	if (max_threads > MAX_READ_AHEAD_THREADS)
+		max_threads = MAX_READ_AHEAD_THREADS;
+
+	printf ("%8s %14s %8s %8s (%d files)\n", "threads", "ms to ready", "MB/s", "speedup", count);
+	for (int threads = 1; threads <= max_threads; threads++) {
+		Read_Ahead_Start (files, count, threads);
+		Read_Ahead_Wait ();
+
+		double start = Seconds();
+		Read_Ahead_Start (files, count, threads);
+		Read_Ahead_Wait ();
+		double time = Seconds() - start;
+		double mb = Read_Ahead_Bytes_Read () / (1024.0 * 1024.0);
+		int files_read = Read_Ahead_Files_Read ();
+		Read_Ahead_Stop ();
+
+		if (threads == 1)
+			one_thread_time = time;
+		if (files_read != count)
+			printf ("%8d only %d files read\n", threads, files_read);
+		else
+			printf ("%8d %14.2f %8.0f %7.2fx\n", threads, time * 1000, mb / time, one_thread_time / time);
+	}
+
+	if (written)
+		for (int i = 0; i < count; i++)
+			remove (files[i]);
+}
+
+/*____________________________________________________________________
+|
+| Function: Old_Init
+|
+| Input: Called from main
+| Output: Spawns n Hoshus evenly spread along z in the old layout.
+|___________________________________________________________________*/
+
+static void Old_Init (int n)
+{
+	random_state = 1;
+	old_count = n;
+	old_raiu_hp = BENCH_RAIU_HP;
+
+	for (int i = 0; i < MAX_ENEMY_COUNT; i++) {
+		Old_Hoshu *hoshu = &old_hoshu[i];
+		*hoshu = Old_Hoshu();
+		hoshu->draw = (i < n);
+		hoshu->pos = { (float)(i % 196) - 98, 0, BENCH_RECYCLE_Z + (BENCH_SPAWN_Z - BENCH_RECYCLE_Z) * (i + 1) / n };
+		hoshu->sphere = hoshu_sphere;
+		hoshu->sphere.center.x = hoshu->pos.x;
+		hoshu->sphere.center.z = hoshu->pos.z;
+		hoshu->hp = 100;
+		hoshu->gun_damage = 10;
+		hoshu->gun_delay = 1000;
+		hoshu->fire_rate = Random_Float() * 0.1f;
+		hoshu->explosion_timer = -1;
+		hoshu->explosion_type = -1;
+		hoshu->laser[0].hit_timer = -1;
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Old_Update
+|
+| Input: Called from main
+| Output: One step of the Hoshu and Hoshu laser update as the game
+|   did it before the structure of arrays store, without the drawing
+|   and sounds.  The character does not swing its blade.  Recycled Hoshus
+|   are respawned in the same slot.
+|___________________________________________________________________*/
+
+static void Old_Update ()
+{
+	float distance = NORMAL_SPEED * (SIM_STEP_TIME / 1000.0f);
+
+	// The game went over every slot here, which is n when n is MAX_ENEMY_COUNT
+	for (int i = 0; i < old_count; i++)
+		if (old_hoshu[i].draw)
+			if (old_hoshu[i].gun_timer < old_hoshu[i].gun_delay)
+				old_hoshu[i].gun_timer += SIM_STEP_TIME;
+
+	for (int i = 0; i < old_count; i++) {
+		Old_Hoshu *hoshu = &old_hoshu[i];
+
+		if (hoshu->draw) {
+
+			// Recycle, then respawn at the front to keep the population constant
+			if (hoshu->pos.z <= BENCH_RECYCLE_Z) {
+				hoshu->pos.z = BENCH_SPAWN_Z;
+				hoshu->sphere.center.z = hoshu->pos.z;
+				hoshu->gun_timer = 0;
+			}
+			else {
+				hoshu->pos.z -= distance;
+				hoshu->sphere.center.z = hoshu->pos.z;
+
+				// Blade is inactive
+				if (hoshu->blade_mark_1)
+					hoshu->blade_mark_1 = false;
+				if (hoshu->blade_mark_2)
+					hoshu->blade_mark_2 = false;
+
+				if (hoshu->explosion_timer >= 0) {
+					if (hoshu->explosion_timer <= FX_NORMAL_DURATION)
+						hoshu->explosion_timer += SIM_STEP_TIME;
+					else
+						hoshu->draw = false;
+				}
+				else {
+					// Angle between (0,0,-1) and the view vector to the character
+					float view_x = -(0 - hoshu->pos.x);
+					float view_z = (0 - hoshu->pos.z);
+					float length = sqrtf(view_x * view_x + view_z * view_z);
+					float angle = 0;
+					if (length > 0) {
+						float cosine = -view_z / length;
+						if (cosine > 1)
+							cosine = 1;
+						else if (cosine < -1)
+							cosine = -1;
+						angle = acosf(cosine) * 57.29577951f;
+					}
+					if (view_x < 0)
+						angle *= -1;
+					if (angle >= 0 AND angle > 80)
+						angle = 80;
+					else if (angle < 0 AND angle < -80)
+						angle = -80;
+					hoshu->angle = angle;
+
+					Old_Laser *laser = &hoshu->laser[hoshu->laser_index];
+					if (hoshu->gun_timer >= hoshu->gun_delay AND NOT laser->draw AND hoshu->fire_rate >= Random_Float()) {
+						laser->sphere = laser_sphere;
+						laser->sphere.radius *= HOSHU_LASER_SCALE;
+						laser->pos = hoshu->sphere.center;
+						laser->pos.y -= 0.5f;
+						laser->sphere.center = laser->pos;
+						laser->trajectory.velocity = 750.0f;
+						laser->hit = false;
+						simVector *direction = &laser->trajectory.direction;
+						direction->x = -sinf(angle / 57.29577951f);
+						direction->y = 0;
+						direction->z = -cosf(angle / 57.29577951f);
+						float d = sqrtf(direction->x * direction->x + direction->y * direction->y + direction->z * direction->z);
+						direction->x /= d;
+						direction->y /= d;
+						direction->z /= d;
+						laser->draw = true;
+						hoshu->laser_index = (hoshu->laser_index + 1) % 1;
+						hoshu->gun_timer = 0;
+					}
+				}
+			}
+		}
+
+		Old_Laser *laser = &hoshu->laser[0];
+		if (laser->draw) {
+			if (laser->destroyed AND laser->trajectory.velocity == 750.0f)
+				laser->trajectory.velocity *= 0.10f;
+			float laser_distance = laser->trajectory.velocity * (SIM_STEP_TIME / 1000.0f);
+
+			if (fabsf(laser->pos.z) >= MAX_PROJECTILE_DISTANCE) {
+				laser->hit_timer = -1;
+				laser->draw = false;
+				laser->distance = { 0, 0, 0 };
+				laser->sphere = laser_sphere;
+				laser->pos = hoshu->pos;
+				laser->world_shift = 0;
+				laser->destroyed = false;
+				laser->trajectory = { { 0, 0, -1 }, 0 };
+			}
+			else {
+				// Distance to the character on the xz plane
+				float dx = raiu_sphere.center.x - laser->sphere.center.x;
+				float dz = raiu_sphere.center.z - laser->sphere.center.z;
+				float d = sqrtf(dx * dx + dz * dz);
+				if (d <= raiu_sphere.radius * 2 AND fabsf(dx) <= raiu_sphere.radius) {
+					if (NOT laser->hit AND NOT laser->destroyed) {
+						old_raiu_hp -= hoshu->gun_damage;
+						laser->hit = true;
+					}
+					laser->hit_timer = 0;
+				}
+				if (laser->hit_timer >= 0) {
+					if (laser->hit_timer <= FX_NORMAL_DURATION)
+						laser->hit_timer += SIM_STEP_TIME;
+					else {
+						laser->hit_timer = -1;
+						laser->draw = false;
+						laser->distance = { 0, 0, 0 };
+						laser->sphere = laser_sphere;
+						laser->pos = hoshu->pos;
+						laser->world_shift = 0;
+						laser->destroyed = false;
+						laser->trajectory = { { 0, 0, -1 }, 0 };
+					}
+				}
+				laser->pos.x += laser->trajectory.direction.x * laser_distance;
+				laser->pos.y += laser->trajectory.direction.y * laser_distance;
+				laser->pos.z += laser->trajectory.direction.z * laser_distance;
+				laser->sphere.center = laser->pos;
+			}
+		}
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: New_Init
+|
+| Input: Called from main, Job_Bench
+| Output: Starts a game in sim.cpp that is already running, with n
+|   Hoshus evenly spread along z.
+|___________________________________________________________________*/
+
+static void New_Init (int n)
+{
+	SimConfig config = { raiu_sphere, hoshu_sphere, laser_sphere, { { 0, 0, 0 }, 5 }, 98, 1 };
+
+	random_state = 1;
+	new_count = n;
+	input = SimInput();
+	input.view = { 0, 0, 1 };
+
+	// Sim_Get_Frame returns the simulation's own (non const) frame, so the bench can skip the entrance and the slow spawning
+	Sim_Init (&config);
+	frame = (SimFrame *)Sim_Get_Frame ();
+	frame->state = STATE_RUNNING;
+	frame->raiu.hp = BENCH_RAIU_HP;
+	for (int i = 0; i < n; i++)
+		Spawn_New (BENCH_RECYCLE_Z + (BENCH_SPAWN_Z - BENCH_RECYCLE_Z) * (i + 1) / n);
+}
+
+/*____________________________________________________________________
+|
+| Function: New_Update
+|
+| Input: Called from main, Job_Bench
+| Output: Runs one step of Sim_Update, then respawns the Hoshus it
+|   removed at the front.
+|___________________________________________________________________*/
+
+static void New_Update ()
+{
+	Sim_Update (&input, SIM_STEP_TIME);
+
+	while (frame->enemies.count < new_count)
+		Spawn_New (BENCH_SPAWN_Z + frame->scroll);
+}
+
+/*____________________________________________________________________
+|
+| Function: Spawn_New
+|
+| Input: Called from New_Init, New_Update
+| Output: Adds a Hoshu at z to the back of the ring, set up the
+|   same way as Spawn_Hoshu does.
+|___________________________________________________________________*/
+
+static void Spawn_New (float z)
+{
+	Enemy *enemies = &frame->enemies;
+	int i = HOSHU_SLOT(enemies, enemies->count);
+	unsigned id = enemies->next_id++;
+
+	enemies->count++;
+	enemies->live++;
+	enemies->active[i] = true;
+	enemies->id[i] = id;
+	enemies->pos[i] = { (float)(id % 196) - 98, 0, z };
+	enemies->sphere[i] = hoshu_sphere;
+	enemies->sphere[i].center.x = enemies->pos[i].x;
+	enemies->sphere[i].center.z = z;
+	enemies->angle[i] = 0;
+	enemies->lv[i] = 1;
+	enemies->hp[i] = 100;
+	enemies->score_amt[i] = 200;
+	enemies->exp_amt[i] = 100;
+	enemies->gun_damage[i] = 10;
+	enemies->gun_delay[i] = 1000;
+	enemies->gun_timer[i] = 0;
+	enemies->fire_rate[i] = Random_Float() * 0.1f;
+	enemies->explosion_timer[i] = -1;
+	enemies->explosion_type[i] = -1;
+	enemies->blade_mark_1[i] = false;
+	enemies->blade_mark_2[i] = false;
+	enemies->laser_index[i] = -1;
+}
+
+/*____________________________________________________________________
+|
+| Function: Random_Float
+|
+| Input: Called from Old_Init, Old_Update, Spawn_New
+| Output: Returns a repeatable random number from 0 to 1.
+|___________________________________________________________________*/
+
+static float Random_Float ()
+{
+	random_state = random_state * 1664525 + 1013904223;
+	return ((random_state >> 8) / 16777216.0f);
+}
+
+/*____________________________________________________________________
+|
+| Function: Seconds
+|
+| Input: Called from main
+| Output: Returns a monotonic time in seconds.
+|___________________________________________________________________*/
+
+static double Seconds ()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,644 @@
+/*____________________________________________________________________
+|
+| File: bundler.cpp
+|
+| Description: Offline asset bundler.  Packs loose asset files into one
+|   bundle: each asset starts on a page boundary, with a table of
+|   contents sorted by name at the end, so a loader that maps the file
+|   can use the assets where they lie.
+|   - color.bmp+alpha.bmp: a texture, the gray level of the alpha file
+|     merged into the color file as 32 bit BGRA pixels
+|   - other .bmp files: a texture with opaque alpha
+|   - .mesh files (from meshcook.cpp): a cooked mesh
+|   - anything else (.lwo, .wav, .gxm, ...): the file as it is
+|   @list reads more arguments from a file, one per line.  Then it maps
+|   the bundle it wrote and prints the time to read every loose file
+|   against the time to touch every asset in the bundle.
+|
+|   Usage: bundler game.bun Objects\raiu.lwo Objects\Images\hp.bmp+Objects\Images\hp_fa.bmp ...
+|   Build: g++ -O2 bundler.cpp -o bundler
+|
+| Functions: main
+|             Add_Argument
+|             Add_Asset
+|             Asset_Name
+|             Read_File
+|             Decode_BMP
+|             Write_Bundle
+|             Compare_Entries
+|             Report
+|             Find_Entry
+|             Map_File
+|             Unmap_File
+|             Seconds
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define MAX_BUNDLE_ASSETS		512
+#define MAX_LINE				260
+
+#define BUNDLE_MAGIC			0x4E42544F // "OTBN"
+#define BUNDLE_VERSION			1
+#define BUNDLE_ALIGN			4096 // every asset starts on a page
+#define BUNDLE_NAME_SIZE		64
+
+// Kinds of assets in a bundle
+#define BUNDLE_FILE				0 // bytes of a loose file, as they are
+#define BUNDLE_TEXTURE			1 // 32 bit BGRA pixels, bottom row first, with the alpha file merged in
+#define BUNDLE_MESH				2 // cooked mesh (from meshcook.cpp)
+
+/*___________________
+|
+| Type definitions
+|__________________*/
+
+// Start of a bundle
+struct Bundle_Header {
+	unsigned magic;
+	unsigned version;
+	unsigned count;						// entries in the table of contents
+	unsigned toc_offset;				// offset of the first entry
+};
+
+// Table of contents entry.  Names are the paths the game loads the
+// assets with, in lower case with backslashes.
+struct Bundle_Entry {
+	char name[BUNDLE_NAME_SIZE];
+	unsigned type;
+	unsigned offset;					// from the start of the bundle
+	unsigned size;						// bytes
+	unsigned width, height;				// textures
+	unsigned reserved[3];
+};
+
+// An asset read from its loose files
+struct Asset {
+	Bundle_Entry entry;
+	unsigned char *data;
+	char *files[2];						// loose files it was made from
+	int num_files;
+};
+
+/*___________________
+|
+| Function prototypes
+|__________________*/
+
+static bool Add_Argument (char *arg);
+static bool Add_Asset (char *arg);
+static bool Asset_Name (char *path, char *name);
+static unsigned char *Read_File (char *filename, unsigned *size);
+static unsigned char *Decode_BMP (char *filename, unsigned *width, unsigned *height);
+static bool Write_Bundle (char *filename);
+static int Compare_Entries (const void *a, const void *b);
+static void Report (char *filename);
+static const Bundle_Entry *Find_Entry (const unsigned char *bundle, size_t size, char *name);
+static const unsigned char *Map_File (char *filename, size_t *size);
+static void Unmap_File (const unsigned char *data, size_t size);
+static double Seconds ();
+
+/*___________________
+|
+| Global variables
+|__________________*/
+
+static Asset assets[MAX_BUNDLE_ASSETS];
+static int num_assets;
+
+#ifdef _WIN32
+static HANDLE map_file = INVALID_HANDLE_VALUE, map_mapping;
+#endif
+
+/*____________________________________________________________________
+|
+| Function: main
+|
+| Input: -
+| Output: Writes the bundle named first from the assets named after it.
+|   Returns 0 on success.
+|___________________________________________________________________*/
+
+int main (int argc, char **argv)
+{
+	if (argc < 3) {
+		printf ("usage: bundler bundle asset... (color.bmp+alpha.bmp merges a texture, @list reads a list)\n");
+		return 1;
+	}
+
+	for (int i = 2; i < argc; i++)
+		if (NOT Add_Argument (argv[i]))
+			return 1;
+
+	if (NOT Write_Bundle (argv[1]))
+		return 1;
+
+	Report (argv[1]);
+
+	return 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Add_Argument
+|
+| Input: Called from main
+| Output: Adds the asset of an argument, or those of a list file.
+|   Returns false on error.
+|___________________________________________________________________*/
+
+static bool Add_Argument (char *arg)
+{
+	char line[MAX_LINE];
+
+	if (arg[0] != '@')
+		return (Add_Asset (arg));
+
+	FILE *fp = fopen (arg + 1, "r");
+	if (fp == 0) {
+		printf ("can't open list %s\n", arg + 1);
+		return (false);
+	}
+	bool ok = true;
+	while (ok AND fgets (line, sizeof(line), fp)) {
+		line[strcspn (line, "\r\n")] = 0;
+		if (line[0] AND line[0] != '#')
+			ok = Add_Asset (strdup (line));
+	}
+	fclose (fp);
+
+	return (ok);
+}
+
+/*____________________________________________________________________
+|
+| Function: Add_Asset
+|
+| Input: Called from Add_Argument
+| Output: Reads an asset from its loose files.  Returns false on error.
+|___________________________________________________________________*/
+
+static bool Add_Asset (char *arg)
+{
+	if (num_assets == MAX_BUNDLE_ASSETS) {
+		printf ("more than %d assets\n", MAX_BUNDLE_ASSETS);
+		return (false);
+	}
+
+	Asset *a = &assets[num_assets];
+	memset (a, 0, sizeof(Asset));
+	a->files[0] = arg;
+	a->num_files = 1;
+	char *plus = strchr (arg, '+');
+	if (plus) {
+		*plus = 0;
+		a->files[1] = plus + 1;
+		a->num_files = 2;
+	}
+
+	if (NOT Asset_Name (a->files[0], a->entry.name)) {
+		printf ("%s: name longer than %d characters\n", a->files[0], BUNDLE_NAME_SIZE - 1);
+		return (false);
+	}
+	for (int i = 0; i < num_assets; i++)
+		if (strcmp (assets[i].entry.name, a->entry.name) == 0) {
+			printf ("%s: already in the bundle\n", a->files[0]);
+			return (false);
+		}
+
+	// Textures are decoded and merged, other files taken as they are
+	size_t len = strlen (a->entry.name);
+	if (len > 4 AND strcmp (a->entry.name + len - 4, ".bmp") == 0) {
+		unsigned width, height, alpha_width, alpha_height;
+		a->data = Decode_BMP (a->files[0], &width, &height);
+		if (a->data == 0)
+			return (false);
+		if (a->num_files == 2) {
+			unsigned char *alpha = Decode_BMP (a->files[1], &alpha_width, &alpha_height);
+			if (alpha == 0)
+				return (false);
+			if (alpha_width != width OR alpha_height != height) {
+				printf ("%s: not the size of %s\n", a->files[1], a->files[0]);
+				return (false);
+			}
+			for (unsigned i = 0; i < width * height; i++) {
+				unsigned char *p = &alpha[i * 4];
+				a->data[i * 4 + 3] = (unsigned char)((p[0] + p[1] + p[2]) / 3);
+			}
+			free (alpha);
+		}
+		a->entry.type = BUNDLE_TEXTURE;
+		a->entry.size = width * height * 4;
+		a->entry.width = width;
+		a->entry.height = height;
+	}
+	else {
+		if (a->num_files == 2) {
+			printf ("%s: only .bmp files can be merged\n", a->files[0]);
+			return (false);
+		}
+		a->data = Read_File (a->files[0], &a->entry.size);
+		if (a->data == 0)
+			return (false);
+		a->entry.type = len > 5 AND strcmp (a->entry.name + len - 5, ".mesh") == 0 ? BUNDLE_MESH : BUNDLE_FILE;
+	}
+	num_assets++;
+
+	return (true);
+}
+
+/*____________________________________________________________________
+|
+| Function: Asset_Name
+|
+| Input: Called from Add_Asset, Find_Entry
+| Output: Writes a path in lower case with backslashes, the name the
+|   asset has in the bundle.  Returns false if it does not fit.
+|___________________________________________________________________*/
+
+static bool Asset_Name (char *path, char *name)
+{
+	int i;
+
+	for (i = 0; path[i]; i++) {
+		if (i == BUNDLE_NAME_SIZE - 1)
+			return (false);
+		name[i] = path[i] == '/' ? '\\' : (char)tolower ((unsigned char)path[i]);
+	}
+	memset (name + i, 0, BUNDLE_NAME_SIZE - i);
+
+	return (true);
+}
+
+/*____________________________________________________________________
+|
+| Function: Read_File
+|
+| Input: Called from Add_Asset, Decode_BMP
+| Output: Returns the bytes of a whole file (free them), or 0 if it
+|   can't be read.
+|___________________________________________________________________*/
+
+static unsigned char *Read_File (char *filename, unsigned *size)
+{
+	FILE *fp = fopen (filename, "rb");
+	if (fp == 0) {
+		printf ("can't open %s\n", filename);
+		return (0);
+	}
+	fseek (fp, 0, SEEK_END);
+	long n = ftell (fp);
+	fseek (fp, 0, SEEK_SET);
+
+	unsigned char *data = (unsigned char *) malloc (n > 0 ? n : 1);
+	if (n < 0 OR data == 0 OR fread (data, 1, n, fp) != (size_t)n) {
+		printf ("can't read %s\n", filename);
+		free (data);
+		data = 0;
+	}
+	fclose (fp);
+	*size = (unsigned)n;
+
+	return (data);
+}
+
+/*____________________________________________________________________
+|
+| Function: Decode_BMP
+|
+| Input: Called from Add_Asset
+| Output: Returns the pixels of an uncompressed 8, 24 or 32 bit BMP
+|   file as 32 bit BGRA, bottom row first, with opaque alpha (free
+|   them).  Returns 0 if the file can't be read or decoded.
+|___________________________________________________________________*/
+
+static unsigned char *Decode_BMP (char *filename, unsigned *width, unsigned *height)
+{
+	unsigned size;
+
+	unsigned char *file = Read_File (filename, &size);
+	if (file == 0)
+		return (0);
+
+	// BITMAPFILEHEADER and BITMAPINFOHEADER fields (little endian)
+	#define U16(o)	((unsigned)file[o] | (unsigned)file[(o) + 1] << 8)
+	#define U32(o)	(U16(o) | U16((o) + 2) << 16)
+	unsigned char *pixels = 0;
+	if (size >= 54 AND file[0] == 'B' AND file[1] == 'M') {
+		unsigned bits_offset = U32(10), info_size = U32(14), bit_count = U16(28), compression = U32(30);
+		int w = (int)U32(18), h = (int)U32(22);
+		bool top_down = h < 0;
+		if (top_down)
+			h = -h;
+		unsigned row_size = (((unsigned)w * bit_count + 31) / 32) * 4;
+		bool valid = w > 0 AND h > 0 AND w <= 16384 AND h <= 16384 AND
+			(bit_count == 8 OR bit_count == 24 OR bit_count == 32) AND
+			(compression == 0 OR (compression == 3 AND bit_count == 32)) AND
+			bits_offset <= size AND (unsigned long long)row_size * h <= size - bits_offset AND
+			(bit_count != 8 OR (info_size <= size AND 14 + 256 * 4 <= size - info_size));
+		if (valid)
+			pixels = (unsigned char *) malloc ((size_t)w * h * 4);
+		if (pixels) {
+			const unsigned char *palette = file + 14 + info_size;
+			for (int y = 0; y < h; y++) {
+				const unsigned char *src = file + bits_offset + (size_t)row_size * (top_down ? h - 1 - y : y);
+				unsigned char *dst = pixels + (size_t)y * w * 4;
+				for (int x = 0; x < w; x++, dst += 4) {
+					const unsigned char *p = bit_count == 8 ? palette + src[x] * 4 : src + x * (bit_count / 8);
+					dst[0] = p[0];
+					dst[1] = p[1];
+					dst[2] = p[2];
+					dst[3] = 255;
+				}
+			}
+			*width = (unsigned)w;
+			*height = (unsigned)h;
+		}
+	}
+	#undef U16
+	#undef U32
+	free (file);
+
+	if (pixels == 0)
+		printf ("%s: not an uncompressed 8, 24 or 32 bit BMP file\n", filename);
+
+	return (pixels);
+}
+
+/*____________________________________________________________________
+|
+| Function: Write_Bundle
+|
+| Input: Called from main
+| Output: Writes the assets, each on a page boundary, then the table of
+|   contents sorted by name.  Returns false on error.
+|___________________________________________________________________*/
+
+static bool Write_Bundle (char *filename)
+{
+	static unsigned char zero[BUNDLE_ALIGN];
+	Bundle_Entry *toc = new Bundle_Entry [num_assets > 0 ? num_assets : 1];
+	Bundle_Header header = { BUNDLE_MAGIC, BUNDLE_VERSION, (unsigned)num_assets, 0 };
+	unsigned long long offset = BUNDLE_ALIGN;
+
+	FILE *fp = fopen (filename, "wb");
+	if (fp == 0) {
+		printf ("can't create %s\n", filename);
+		delete [] toc;
+		return (false);
+	}
+
+	// The header is rewritten at the end, once the table's place is known
+	bool ok = fwrite (zero, 1, BUNDLE_ALIGN, fp) == BUNDLE_ALIGN;
+	for (int i = 0; i < num_assets AND ok; i++) {
+		Asset *a = &assets[i];
+		unsigned pad = (unsigned)((BUNDLE_ALIGN - a->entry.size % BUNDLE_ALIGN) % BUNDLE_ALIGN);
+		a->entry.offset = (unsigned)offset;
+		toc[i] = a->entry;
+		ok = fwrite (a->data, 1, a->entry.size, fp) == a->entry.size AND fwrite (zero, 1, pad, fp) == pad;
+		offset += a->entry.size + pad;
+		if (offset + (unsigned long long)num_assets * sizeof(Bundle_Entry) > 0xFFFFFFFFu) {
+			printf ("%s: bundle larger than 4 GB\n", filename);
+			ok = false;
+		}
+	}
+
+	qsort (toc, num_assets, sizeof(Bundle_Entry), Compare_Entries);
+	header.toc_offset = (unsigned)offset;
+	if (ok)
+		ok = fwrite (toc, sizeof(Bundle_Entry), num_assets, fp) == (size_t)num_assets AND
+			fseek (fp, 0, SEEK_SET) == 0 AND fwrite (&header, sizeof(header), 1, fp) == 1;
+	if (fclose (fp) != 0)
+		ok = false;
+	delete [] toc;
+
+	if (NOT ok)
+		printf ("can't write %s\n", filename);
+
+	return (ok);
+}
+
+/*____________________________________________________________________
+|
+| Function: Compare_Entries
+|
+| Input: Called from Write_Bundle (through qsort)
+| Output: Orders table of contents entries by name.
+|___________________________________________________________________*/
+
+static int Compare_Entries (const void *a, const void *b)
+{
+	return (strncmp (((const Bundle_Entry *)a)->name, ((const Bundle_Entry *)b)->name, BUNDLE_NAME_SIZE));
+}
+
+/*____________________________________________________________________
+|
+| Function: Report
+|
+| Input: Called from main
+| Output: Maps the bundle that was written, checks that every asset is
+|   found in it, and prints the time to read the loose files against
+|   the time to touch every page of the assets in the bundle.  Both run
+|   from the system file cache, so this times the opens and reads saved
+|   rather than the disk.
+|___________________________________________________________________*/
+
+static void Report (char *filename)
+{
+	unsigned long long bytes = 0;
+	unsigned pages = 0, sum = 0, size;
+	size_t bundle_size;
+	int files = 0;
+
+	double start = Seconds();
+	for (int i = 0; i < num_assets; i++)
+		for (int f = 0; f < assets[i].num_files; f++) {
+			unsigned char *data = Read_File (assets[i].files[f], &size);
+			if (data) {
+				bytes += size;
+				sum += data[0];
+				free (data);
+			}
+			files++;
+		}
+	double loose_time = Seconds() - start;
+
+	start = Seconds();
+	const unsigned char *bundle = Map_File (filename, &bundle_size);
+	if (bundle == 0) {
+		printf ("can't map %s\n", filename);
+		return;
+	}
+	for (int i = 0; i < num_assets; i++) {
+		const Bundle_Entry *e = Find_Entry (bundle, bundle_size, assets[i].files[0]);
+		if (e == 0) {
+			printf ("%s: missing from the bundle\n", assets[i].files[0]);
+			continue;
+		}
+		const unsigned char *data = bundle + e->offset;
+		for (unsigned o = 0; o < e->size; o += BUNDLE_ALIGN, pages++)
+			sum += data[o];
+	}
+	double bundle_time = Seconds() - start;
+	Unmap_File (bundle, bundle_size);
+
+	printf ("%d assets packed from %d files (%.1f MB)\n", num_assets, files, bytes / (1024.0 * 1024.0));
+	printf ("loose files: %d opens, %.2f ms\n", files, loose_time * 1000);
+	printf ("bundle:      1 open, %u pages touched, %.2f ms (checksum %u)\n", pages, bundle_time * 1000, sum & 0xFF);
+}
+
+/*____________________________________________________________________
+|
+| Function: Find_Entry
+|
+| Input: Called from Report
+| Output: Returns the entry of an asset in a mapped bundle, found by a
+|   binary search of its table of contents.  Returns 0 if the bundle
+|   doesn't have it or is not a valid bundle of this version.
+|___________________________________________________________________*/
+
+static const Bundle_Entry *Find_Entry (const unsigned char *bundle, size_t size, char *name)
+{
+	char key[BUNDLE_NAME_SIZE];
+
+	// Check the header and that the table of contents is in the file
+	const Bundle_Header *header = (const Bundle_Header *)bundle;
+	bool valid = size >= sizeof(Bundle_Header) AND
+		header->magic == BUNDLE_MAGIC AND header->version == BUNDLE_VERSION AND
+		header->toc_offset % sizeof(unsigned) == 0 AND header->toc_offset <= size AND
+		header->count <= (size - header->toc_offset) / sizeof(Bundle_Entry);
+	if (NOT valid OR NOT Asset_Name (name, key))
+		return (0);
+
+	const Bundle_Entry *toc = (const Bundle_Entry *)(bundle + header->toc_offset);
+	int low = 0, high = (int)header->count - 1;
+	while (low <= high) {
+		int mid = (low + high) / 2;
+		int cmp = strncmp (key, toc[mid].name, BUNDLE_NAME_SIZE);
+		if (cmp == 0) {
+			// An entry that points outside the file is as good as missing
+			const Bundle_Entry *e = &toc[mid];
+			if (e->offset > size OR e->size > size - e->offset)
+				return (0);
+			return (e);
+		}
+		if (cmp < 0)
+			high = mid - 1;
+		else
+			low = mid + 1;
+	}
+
+	return (0);
+}
+
+/*____________________________________________________________________
+|
+| Function: Map_File
+|
+| Input: Called from Report
+| Output: Maps a whole file read only.  Returns 0 on failure.
+|___________________________________________________________________*/
+
+static const unsigned char *Map_File (char *filename, size_t *size)
+{
+	void *data;
+
+#ifdef _WIN32
+	LARGE_INTEGER file_size;
+
+	map_file = CreateFileA (filename, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, 0);
+	if (map_file == INVALID_HANDLE_VALUE)
+		return (0);
+	map_mapping = 0;
+	data = 0;
+	if (GetFileSizeEx (map_file, &file_size) AND file_size.QuadPart > 0)
+		map_mapping = CreateFileMappingA (map_file, 0, PAGE_READONLY, 0, 0, 0);
+	if (map_mapping)
+		data = MapViewOfFile (map_mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == 0) {
+		if (map_mapping)
+			CloseHandle (map_mapping);
+		CloseHandle (map_file);
+		map_file = INVALID_HANDLE_VALUE;
+		return (0);
+	}
+	*size = (size_t)file_size.QuadPart;
+#else
+	struct stat st;
+
+	int fd = open (filename, O_RDONLY);
+	if (fd < 0)
+		return (0);
+	data = MAP_FAILED;
+	if (fstat (fd, &st) == 0 AND st.st_size > 0)
+		data = mmap (0, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close (fd);
+	if (data == MAP_FAILED)
+		return (0);
+	*size = (size_t)st.st_size;
+#endif
+
+	return ((const unsigned char *)data);
+}
+
+/*____________________________________________________________________
+|
+| Function: Unmap_File
+|
+| Input: Called from Report
+| Output: Unmaps a file mapped by Map_File.
+|___________________________________________________________________*/
+
+static void Unmap_File (const unsigned char *data, size_t size)
+{
+#ifdef _WIN32
+	UnmapViewOfFile (data);
+	CloseHandle (map_mapping);
+	CloseHandle (map_file);
+	map_file = INVALID_HANDLE_VALUE;
+#else
+	munmap ((void *)data, size);
+#endif
+}
+
+/*____________________________________________________________________
+|
+| Function: Seconds
+|
+| Input: Called from Report
+| Output: Returns a monotonic time in seconds.
+|___________________________________________________________________*/
+
+static double Seconds ()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
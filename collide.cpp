@@ -0,0 +1,221 @@
+/*____________________________________________________________________
+|
+| File: collide.cpp
+|
+| Description: Batch sphere overlap tests.  Compares squared distances
+|   against squared radii, so no square roots are taken.  The vector
+|   paths handle 8 (AVX2) or 4 (SSE2) spheres at a time and the scalar
+|   loop finishes the rest.
+|
+| Functions: Collide_Sphere_Batch
+|            Collide_Sphere_Batch_Scalar
+|            Collide_Sphere_Batch_Parallel
+|             Collide_Scalar
+|             Collide_Job
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <string.h>
+#include <atomic>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLIDE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "sim.h"
+#include "collide.h"
+#include "jobs.h"
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#define COLLIDE_JOB_WORDS	128 // hit mask words per job range (4096 spheres)
+
+/*___________________
+|
+| Type definitions
+|__________________*/
+
+// A batch split over the job threads
+struct Collide_Batch {
+	const simSphere *query;
+	const float *x, *y, *z, *radius;
+	int count;
+	unsigned *hits;
+	std::atomic<int> num_hits;
+};
+
+/*___________________
+|
+| Function prototypes
+|__________________*/
+
+static int Collide_Scalar (const simSphere *query, const float *x, const float *y, const float *z, const float *radius, int start, int count, unsigned *hits);
+static void Collide_Job (void *data, int start, int end);
+
+/*___________________
+|
+| Global variables
+|__________________*/
+
+// Number of bits set in a 4 bit mask
+static const int bit_count[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+/*____________________________________________________________________
+|
+| Function: Collide_Sphere_Batch
+|
+| Input: Called from Update_Blade, Update_Health_Pad, Collide_Job
+| Output: Sets a bit in hits for every sphere in the batch that overlaps
+|   the query sphere.  Returns the number of overlapping spheres.
+|___________________________________________________________________*/
+
+int Collide_Sphere_Batch (const simSphere *query, const float *x, const float *y, const float *z, const float *radius, int count, unsigned *hits)
+{
+	int i = 0;
+	int num_hits = 0;
+
+	memset (hits, 0, COLLIDE_MASK_WORDS(count) * sizeof(unsigned));
+
+	// Groups of 8 and 4 never straddle a 32 bit mask word
+#if defined(__AVX2__)
+	__m256 qx8 = _mm256_set1_ps(query->center.x);
+	__m256 qy8 = _mm256_set1_ps(query->center.y);
+	__m256 qz8 = _mm256_set1_ps(query->center.z);
+	__m256 qr8 = _mm256_set1_ps(query->radius);
+
+	for (; i + 8 <= count; i += 8) {
+		__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), qx8);
+		__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), qy8);
+		__m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + i), qz8);
+		__m256 r = _mm256_add_ps(_mm256_loadu_ps(radius + i), qr8);
+		__m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+		unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(d2, _mm256_mul_ps(r, r), _CMP_LE_OQ));
+		if (mask) {
+			hits[i >> 5] |= mask << (i & 31);
+			num_hits += bit_count[mask & 0xF] + bit_count[mask >> 4];
+		}
+	}
+#endif
+
+#if defined(COLLIDE_SSE2)
+	__m128 qx4 = _mm_set1_ps(query->center.x);
+	__m128 qy4 = _mm_set1_ps(query->center.y);
+	__m128 qz4 = _mm_set1_ps(query->center.z);
+	__m128 qr4 = _mm_set1_ps(query->radius);
+
+	for (; i + 4 <= count; i += 4) {
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), qx4);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), qy4);
+		__m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), qz4);
+		__m128 r = _mm_add_ps(_mm_loadu_ps(radius + i), qr4);
+		__m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		unsigned mask = (unsigned)_mm_movemask_ps(_mm_cmple_ps(d2, _mm_mul_ps(r, r)));
+		if (mask) {
+			hits[i >> 5] |= mask << (i & 31);
+			num_hits += bit_count[mask];
+		}
+	}
+#endif
+
+	return (num_hits + Collide_Scalar (query, x, y, z, radius, i, count, hits));
+}
+
+/*____________________________________________________________________
+|
+| Function: Collide_Sphere_Batch_Scalar
+|
+| Input: Called from the benchmark
+| Output: Same as Collide_Sphere_Batch without the vector paths.
+|___________________________________________________________________*/
+
+int Collide_Sphere_Batch_Scalar (const simSphere *query, const float *x, const float *y, const float *z, const float *radius, int count, unsigned *hits)
+{
+	memset (hits, 0, COLLIDE_MASK_WORDS(count) * sizeof(unsigned));
+
+	return (Collide_Scalar (query, x, y, z, radius, 0, count, hits));
+}
+
+/*____________________________________________________________________
+|
+| Function: Collide_Sphere_Batch_Parallel
+|
+| Input: Called from Update_Projectiles
+| Output: Same as Collide_Sphere_Batch.  Large batches are split into
+|   ranges of whole mask words, so no two threads write the same word.
+|___________________________________________________________________*/
+
+int Collide_Sphere_Batch_Parallel (const simSphere *query, const float *x, const float *y, const float *z, const float *radius, int count, unsigned *hits)
+{
+	Collide_Batch batch;
+
+	batch.query = query;
+	batch.x = x;
+	batch.y = y;
+	batch.z = z;
+	batch.radius = radius;
+	batch.count = count;
+	batch.hits = hits;
+	batch.num_hits.store (0);
+
+	if (count <= 0)
+		return (0);
+	Jobs_Parallel_For (Collide_Job, &batch, COLLIDE_MASK_WORDS(count), COLLIDE_JOB_WORDS);
+
+	return (batch.num_hits.load ());
+}
+
+/*____________________________________________________________________
+|
+| Function: Collide_Job
+|
+| Input: Called from Collide_Sphere_Batch_Parallel (on any job thread)
+| Output: Tests the spheres of mask words start to end - 1.
+|___________________________________________________________________*/
+
+static void Collide_Job (void *data, int start, int end)
+{
+	Collide_Batch *batch = (Collide_Batch *)data;
+	int first = start * 32;
+	int last = end * 32 < batch->count ? end * 32 : batch->count;
+
+	int num_hits = Collide_Sphere_Batch (batch->query, batch->x + first, batch->y + first, batch->z + first, batch->radius + first, last - first, batch->hits + start);
+	batch->num_hits.fetch_add (num_hits, std::memory_order_relaxed);
+}
+
+/*____________________________________________________________________
+|
+| Function: Collide_Scalar
+|
+| Input: Called from Collide_Sphere_Batch, Collide_Sphere_Batch_Scalar
+| Output: Tests spheres start to count - 1, one at a time.  The hit
+|   mask must already be cleared.
+|___________________________________________________________________*/
+
+static int Collide_Scalar (const simSphere *query, const float *x, const float *y, const float *z, const float *radius, int start, int count, unsigned *hits)
+{
+	int num_hits = 0;
+
+	for (int i = start; i < count; i++) {
+		float dx = x[i] - query->center.x;
+		float dy = y[i] - query->center.y;
+		float dz = z[i] - query->center.z;
+		float r = radius[i] + query->radius;
+		if (dx * dx + dy * dy + dz * dz <= r * r) {
+			hits[i >> 5] |= 1u << (i & 31);
+			num_hits++;
+		}
+	}
+
+	return (num_hits);
+}
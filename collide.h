@@ -0,0 +1,47 @@
+/*____________________________________________________________________
+|
+| File: collide.h
+|
+| Description: Batch sphere overlap tests for the gameplay simulation.
+|   Include after sim.h.
+|___________________________________________________________________*/
+
+// Number of unsigned words needed for the hit mask of count spheres
+#define COLLIDE_MASK_WORDS(count)	(((count) + 31) / 32)
+
+// Tests one sphere against a batch of spheres stored as separate arrays.
+// Sets bit (i % 32) of hits[i / 32] when sphere i overlaps the query
+// (touching counts).  Uses SSE2 or AVX2 when the build targets them.
+// Returns the number of overlapping spheres.
+int Collide_Sphere_Batch (
+  const simSphere *query,
+  const float     *x,
+  const float     *y,
+  const float     *z,
+  const float     *radius,
+  int              count,
+  unsigned        *hits );	// COLLIDE_MASK_WORDS(count) words
+
+// Same as Collide_Sphere_Batch, one sphere at a time
+int Collide_Sphere_Batch_Scalar (
+  const simSphere *query,
+  const float     *x,
+  const float     *y,
+  const float     *z,
+  const float     *radius,
+  int              count,
+  unsigned        *hits );
+
+// Same as Collide_Sphere_Batch, split over the job threads when the
+// batch is large enough to be worth it
+int Collide_Sphere_Batch_Parallel (
+  const simSphere *query,
+  const float     *x,
+  const float     *y,
+  const float     *z,
+  const float     *radius,
+  int              count,
+  unsigned        *hits );
+
+// Returns true if bit i of a hit mask is set
+#define COLLIDE_HIT(hits,i)	(((hits)[(i) >> 5] >> ((i) & 31)) & 1)
@@ -0,0 +1,188 @@
+/*____________________________________________________________________
+|
+| File: cull.cpp
+|
+| Description: View frustum culling of bounding spheres.  A sphere is
+|   culled when it is entirely behind one of the six planes (its signed
+|   distance is below -radius).  The planes are built in view space and
+|   moved to world space once per frame, so the spheres are tested where
+|   they are.  The vector paths test 8 (AVX2) or 4 (SSE2) spheres at a
+|   time and the scalar loop finishes the rest.
+|
+| Functions: Cull_Init_Frustum
+|            Cull_Sphere_Batch
+|             Cull_Scalar
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <first_header.h>
+#include "dp.h"
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CULL_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "cull.h"
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define DEGREES_TO_RADIANS(_d_)	((_d_) * (float)3.14159265 / (float)180.0)
+
+/*___________________
+|
+| Function prototypes
+|__________________*/
+
+static int Cull_Scalar (const Cull_Frustum *frustum, const float *x, const float *y, const float *z, const float *radius, int start, int count, unsigned *visible);
+
+/*___________________
+|
+| Global variables
+|__________________*/
+
+// Number of bits set in a 4 bit mask
+static const int bit_count[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+/*____________________________________________________________________
+|
+| Function: Cull_Init_Frustum
+|
+| Input: Called from Render_GameScreen
+| Output: Builds the world space planes of the frustum of a view matrix
+|   (row vectors, as gx3d uses) and a projection.
+|___________________________________________________________________*/
+
+void Cull_Init_Frustum (Cull_Frustum *frustum, gx3dMatrix *view, float fov, float aspect, float near_plane, float far_plane)
+{
+	float ty = tanf (DEGREES_TO_RADIANS(fov) / 2);
+	float tx = ty * aspect;
+	float sy = 1 / sqrtf (1 + ty * ty), cy = ty * sy;
+	float sx = 1 / sqrtf (1 + tx * tx), cx = tx * sx;
+
+	// View space planes (looking down +z): near, far, left, right, bottom, top
+	float plane[CULL_PLANES][4] = {
+		{   0,   0,  1, -near_plane },
+		{   0,   0, -1,  far_plane  },
+		{  sx,   0, cx,  0 },
+		{ -sx,   0, cx,  0 },
+		{   0,  sy, cy,  0 },
+		{   0, -sy, cy,  0 }
+	};
+
+	// A world point p is at p * view in view space, so a view space plane
+	// (n, d) is (view3x3 * n, d + n . translation) in world space
+	for (int i = 0; i < CULL_PLANES; i++) {
+		float *p = plane[i];
+		frustum->nx[i] = view->_00 * p[0] + view->_01 * p[1] + view->_02 * p[2];
+		frustum->ny[i] = view->_10 * p[0] + view->_11 * p[1] + view->_12 * p[2];
+		frustum->nz[i] = view->_20 * p[0] + view->_21 * p[1] + view->_22 * p[2];
+		frustum->d[i] = p[3] + view->_30 * p[0] + view->_31 * p[1] + view->_32 * p[2];
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Cull_Sphere_Batch
+|
+| Input: Called from Render_GameScreen, Draw_Hoshus
+| Output: Sets a bit in visible for every sphere in the batch that is at
+|   least partly inside the frustum.  Returns the number of visible
+|   spheres.
+|___________________________________________________________________*/
+
+int Cull_Sphere_Batch (const Cull_Frustum *frustum, const float *x, const float *y, const float *z, const float *radius, int count, unsigned *visible)
+{
+	int i = 0;
+	int num_visible = 0;
+
+	memset (visible, 0, CULL_MASK_WORDS(count) * sizeof(unsigned));
+
+	// Groups of 8 and 4 never straddle a 32 bit mask word
+#if defined(__AVX2__)
+	for (; i + 8 <= count; i += 8) {
+		__m256 px = _mm256_loadu_ps(x + i);
+		__m256 py = _mm256_loadu_ps(y + i);
+		__m256 pz = _mm256_loadu_ps(z + i);
+		__m256 nr = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(radius + i));
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (int j = 0; j < CULL_PLANES; j++) {
+			__m256 dist = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(frustum->nx[j])), _mm256_mul_ps(py, _mm256_set1_ps(frustum->ny[j]))),
+										_mm256_add_ps(_mm256_mul_ps(pz, _mm256_set1_ps(frustum->nz[j])), _mm256_set1_ps(frustum->d[j])));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, nr, _CMP_GE_OQ));
+		}
+		unsigned mask = (unsigned)_mm256_movemask_ps(inside);
+		if (mask) {
+			visible[i >> 5] |= mask << (i & 31);
+			num_visible += bit_count[mask & 0xF] + bit_count[mask >> 4];
+		}
+	}
+#endif
+
+#if defined(CULL_SSE2)
+	for (; i + 4 <= count; i += 4) {
+		__m128 px = _mm_loadu_ps(x + i);
+		__m128 py = _mm_loadu_ps(y + i);
+		__m128 pz = _mm_loadu_ps(z + i);
+		__m128 nr = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (int j = 0; j < CULL_PLANES; j++) {
+			__m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(frustum->nx[j])), _mm_mul_ps(py, _mm_set1_ps(frustum->ny[j]))),
+									 _mm_add_ps(_mm_mul_ps(pz, _mm_set1_ps(frustum->nz[j])), _mm_set1_ps(frustum->d[j])));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, nr));
+		}
+		unsigned mask = (unsigned)_mm_movemask_ps(inside);
+		if (mask) {
+			visible[i >> 5] |= mask << (i & 31);
+			num_visible += bit_count[mask];
+		}
+	}
+#endif
+
+	return (num_visible + Cull_Scalar (frustum, x, y, z, radius, i, count, visible));
+}
+
+/*____________________________________________________________________
+|
+| Function: Cull_Scalar
+|
+| Input: Called from Cull_Sphere_Batch
+| Output: Tests spheres start to count - 1, one at a time.  The visible
+|   mask must already be cleared.
+|___________________________________________________________________*/
+
+static int Cull_Scalar (const Cull_Frustum *frustum, const float *x, const float *y, const float *z, const float *radius, int start, int count, unsigned *visible)
+{
+	int num_visible = 0;
+
+	for (int i = start; i < count; i++) {
+		bool inside = true;
+		for (int j = 0; j < CULL_PLANES AND inside; j++)
+			inside = frustum->nx[j] * x[i] + frustum->ny[j] * y[i] + frustum->nz[j] * z[i] + frustum->d[j] >= -radius[i];
+		if (inside) {
+			visible[i >> 5] |= 1u << (i & 31);
+			num_visible++;
+		}
+	}
+
+	return (num_visible);
+}
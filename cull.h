@@ -0,0 +1,42 @@
+/*____________________________________________________________________
+|
+| File: cull.h
+|
+| Description: Batch view frustum culling of bounding spheres.
+|   Include after dp.h.
+|___________________________________________________________________*/
+
+#define CULL_PLANES				6
+
+// Number of unsigned words needed for the visible mask of count spheres
+#define CULL_MASK_WORDS(count)	(((count) + 31) / 32)
+
+// Returns true if bit i of a visible mask is set
+#define CULL_VISIBLE(visible,i)	(((visible)[(i) >> 5] >> ((i) & 31)) & 1)
+
+// World space planes of a view frustum (a point p is in front of plane i
+// when nx[i] * p.x + ny[i] * p.y + nz[i] * p.z + d[i] >= 0)
+struct Cull_Frustum {
+	float nx[CULL_PLANES];
+	float ny[CULL_PLANES];
+	float nz[CULL_PLANES];
+	float d[CULL_PLANES];
+};
+
+// Builds the frustum of a view matrix and a projection.  fov is taken
+// as the vertical field of view (degrees), and aspect as width / height,
+// so the frustum is never narrower than the projection.
+void Cull_Init_Frustum (Cull_Frustum *frustum, gx3dMatrix *view, float fov, float aspect, float near_plane, float far_plane);
+
+// Tests a batch of spheres stored as separate arrays against a frustum.
+// Sets bit (i % 32) of visible[i / 32] when sphere i is at least partly
+// inside.  Uses SSE2 or AVX2 when the build targets them.  Returns the
+// number of visible spheres.
+int Cull_Sphere_Batch (
+  const Cull_Frustum *frustum,
+  const float        *x,
+  const float        *y,
+  const float        *z,
+  const float        *radius,
+  int                 count,
+  unsigned           *visible );	// CULL_MASK_WORDS(count) words
@@ -0,0 +1,647 @@
+/*____________________________________________________________________
+|
+| File: drawlist.cpp
+|
+| Description: Sort key command buffer for the game screen.  The key
+|   of every draw packs, from the high bits down:
+|     pass, blend mode, material, texture, depth    (sky and opaque)
+|     pass, blend mode, depth (far first), material, texture  (alpha)
+|   and the index of the draw in its low 16 bits, so sorting the keys
+|   alone orders the draws and keeps equal keys in recording order.
+|   Executing the sorted draws only changes the render state that
+|   differs from the draw before.
+|   Instanced draws record the matrices of all the instances of a mesh
+|   in one command, which sets the state once and then only the matrices
+|   between the instances.  gx3d has no instanced draw call, so each
+|   instance is still drawn on its own, but the commands (and state
+|   changes) no longer grow with the number of instances.
+|   The commands, gx3d draws and gx3d state changes of every frame are
+|   counted for Draw_List_Report.
+|
+| Functions: Draw_List_Set_Pass
+|            Draw_List_Set_Material
+|            Draw_List_Begin
+|            Draw_List_Transform
+|            Draw_List_Object
+|            Draw_List_Instances
+|            Draw_List_Billboard
+|            Draw_List_Particles
+|            Draw_List_Clear
+|            Draw_List_Execute
+|            Draw_List_Frame_Stats
+|            Draw_List_Report
+|             Add_Command
+|             Texture_Id
+|             Depth
+|             Apply_Transform
+|             Draw_Instances
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <first_header.h>
+#include "dp.h"
+
+#include <algorithm>
+
+#include "drawlist.h"
+#include "renderstate.h"
+#include "transform.h"
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define MAX_DRAW_COMMANDS		8192
+#define MAX_DRAW_TRANSFORMS		4096
+#define MAX_DRAW_MATRICES		8192 // instance matrices
+#define MAX_INSTANCE_LAYERS		4
+#define MAX_DRAW_TEXTURES		256 // textures told apart by the sort key in one frame
+#define DRAW_MAX_DEPTH			((float)5000.0) // draws further away sort as equally far
+
+#define DRAW_OBJECT				0
+#define DRAW_LAYER				1
+#define DRAW_BILLBOARD			2
+#define DRAW_PARTICLES			3
+#define DRAW_INSTANCES			4
+
+// Sort key fields
+#define KEY_INDEX_BITS			16
+#define KEY_DEPTH_BITS			24
+#define KEY_TEXTURE_BITS		8
+#define KEY_MATERIAL_BITS		4
+#define KEY_PASS_SHIFT			54
+#define KEY_BLEND_SHIFT			52
+#define KEY_MATERIAL_SHIFT		48 // opaque
+#define KEY_TEXTURE_SHIFT		40 // opaque
+#define KEY_DEPTH_SHIFT			16 // opaque
+#define KEY_FAR_SHIFT			28 // alpha
+#define KEY_ALPHA_MATERIAL_SHIFT 24 // alpha
+#define KEY_ALPHA_TEXTURE_SHIFT	16 // alpha
+
+/*___________________
+|
+| Type definitions
+|__________________*/
+
+typedef unsigned long long DrawKey;
+
+// A recorded draw
+struct Draw_Command {
+	int type;							// DRAW_OBJECT, DRAW_LAYER, DRAW_BILLBOARD, DRAW_PARTICLES or DRAW_INSTANCES
+	int pass, blend, material;
+	gx3dTexture texture;
+	int transform;						// -1 keeps the transforms already set
+	gx3dObject *object;
+	gx3dObjectLayer *layer;
+	int alpha_test;						// DRAW_BLEND_ALPHA_TEST reference value
+	gx3dMatrix matrix;					// texture matrix (billboards) or particle system matrix
+	gx3dParticleSystem particles;
+	gx3dVector heading;					// particle systems face this way
+	int num_layers;						// instanced layers (0 draws the object)
+	gx3dObjectLayer *layers[MAX_INSTANCE_LAYERS];
+	int first_matrix, count;			// instance matrices
+};
+
+// Matrix set before a draw
+struct Draw_Transform {
+	gx3dObject *object;
+	gx3dObjectLayer *layer;				// 0 sets the object matrix
+	gx3dMatrix matrix;
+};
+
+// Projection and fog of a pass
+struct Draw_Pass {
+	float fov, near_plane, far_plane;
+	bool fog;
+};
+
+// Render state of a material id
+struct Draw_Material {
+	gx3dMaterialData *data;
+	gx3dColor ambient;
+	bool specular;
+};
+
+/*___________________
+|
+| Function prototypes
+|__________________*/
+
+static Draw_Command *Add_Command (int pass, int blend, int material, gx3dTexture texture, gx3dVector *center);
+static int Texture_Id (gx3dTexture texture);
+static unsigned Depth (gx3dVector *center);
+static void Apply_Transform (Draw_Transform *t);
+static void Draw_Instances (Draw_Command *c);
+
+/*___________________
+|
+| Global variables
+|__________________*/
+
+static Draw_Pass draw_pass[MAX_DRAW_PASSES];
+static Draw_Material draw_material[MAX_DRAW_MATERIALS];
+
+// The frame being recorded
+static Draw_Command command[MAX_DRAW_COMMANDS];
+static DrawKey key[MAX_DRAW_COMMANDS];
+static int num_commands;
+static Draw_Transform draw_transform[MAX_DRAW_TRANSFORMS];
+static int num_transforms;
+static gx3dMatrix instance_matrix[MAX_DRAW_MATRICES];
+static int num_matrices;
+static gx3dTexture texture_table[MAX_DRAW_TEXTURES];
+static int num_textures;
+static gx3dVector eye_position, eye_forward;
+
+// Commands executed, gx3d draws and gx3d state changes (material,
+// texture and texture matrix) in the current frame, the last frame and
+// all the frames since the last report
+static unsigned commands_run, draws, state_changes;
+static unsigned last_commands, last_draws, last_state_changes;
+static unsigned total_commands, total_draws, total_state_changes, total_frames;
+
+/*____________________________________________________________________
+|
+| Function: Draw_List_Set_Pass
+|
+| Input: Called from Init_GameScreen
+| Output: Sets the projection and fog of a pass.
+|___________________________________________________________________*/
+
+void Draw_List_Set_Pass (int pass, float fov, float near_plane, float far_plane, bool fog)
+{
+	draw_pass[pass].fov = fov;
+	draw_pass[pass].near_plane = near_plane;
+	draw_pass[pass].far_plane = far_plane;
+	draw_pass[pass].fog = fog;
+}
+
+/*____________________________________________________________________
+|
+| Function: Draw_List_Set_Material
+|
+| Input: Called from Init_GameScreen
+| Output: Sets the render state of a material id.
+|___________________________________________________________________*/
+
+void Draw_List_Set_Material (int material, gx3dMaterialData *data, gx3dColor ambient, bool specular)
+{
+	draw_material[material].data = data;
+	draw_material[material].ambient = ambient;
+	draw_material[material].specular = specular;
+}
+
+/*____________________________________________________________________
+|
+| Function: Draw_List_Begin
+|
+| Input: Called from Render_GameScreen
+| Output: Empties the list and sets the eye used for depth sorting.
+|   Keeps the counts of the frame that ended and starts new ones.
+|___________________________________________________________________*/
+
+void Draw_List_Begin (gx3dVector *eye, gx3dVector *forward)
+{
+	last_commands = commands_run;
+	last_draws = draws;
+	last_state_changes = state_changes;
+	total_commands += commands_run;
+	total_draws += draws;
+	total_state_changes += state_changes;
+	total_frames++;
+	commands_run = 0;
+	draws = 0;
+	state_changes = 0;
+
+	Draw_List_Clear ();
+	eye_position = *eye;
+	eye_forward = *forward;
+}
+
+/*____________________________________________________________________
+|
+| Function: Draw_List_Transform
+|
+| Input: Called from Render_GameScreen, Queue_FX
+| Output: Records the matrix of an object or object layer.  Returns the
+|   transform id for the draws that use it (-1 if the list is full).
+|___________________________________________________________________*/
+
+int Draw_List_Transform (gx3dObject *object, gx3dObjectLayer *layer, gx3dMatrix *m)
+{
+	if (num_transforms == MAX_DRAW_TRANSFORMS)
+		return (-1);
+
+	Draw_Transform *t = &draw_transform[num_transforms];
+	t->object = object;
+	t->layer = layer;
+	t->matrix = *m;
+
+	return (num_transforms++);
+}
+
+/*____________________________________________________________________
+|
+| Function: Draw_List_Object
+|
+| Input: Called from Render_GameScreen
+| Output: Records a draw of an object (layer is 0) or object layer.
+|___________________________________________________________________*/
+
+void Draw_List_Object (int pass, int blend, int material, gx3dTexture texture, int transform_id, gx3dObject *object, gx3dObjectLayer *layer, gx3dVector *center)
+{
+	Draw_Command *c = Add_Command (pass, blend, material, texture, center);
+	if (c == 0)
+		return;
+
+	c->type = layer ? DRAW_LAYER : DRAW_OBJECT;
+	c->transform = transform_id;
+	c->object = object;
+	c->layer = layer;
+}
+
+/*____________________________________________________________________
+|
+| Function: Draw_List_Instances
+|
+| Input: Called from Render_GameScreen, Draw_Hoshus
+| Output: Records one draw of all the instances of an object or of its
+|   layers.  Instances past the room left in the list are dropped.
+|___________________________________________________________________*/
+
+void Draw_List_Instances (int pass, int blend, int material, gx3dTexture texture, gx3dObject *object, int num_layers, gx3dObjectLayer **layers, gx3dMatrix *matrices, int count)
+{
+	int per_instance = num_layers ? num_layers : 1;
+
+	if (count > (MAX_DRAW_MATRICES - num_matrices) / per_instance)
+		count = (MAX_DRAW_MATRICES - num_matrices) / per_instance;
+	if (count <= 0 OR num_layers > MAX_INSTANCE_LAYERS)
+		return;
+
+	// Sort by the instance nearest the eye (or farthest from it when blended back to front)
+	gx3dVector center, c;
+	unsigned depth = 0, d;
+	for (int i = 0; i < count; i++) {
+		gx3dMatrix *m = &matrices[i * per_instance];
+		c = { m->_30, m->_31, m->_32 };
+		d = Depth (&c);
+		if (i == 0 OR (pass == DRAW_PASS_ALPHA ? d > depth : d < depth)) {
+			center = c;
+			depth = d;
+		}
+	}
+
+	Draw_Command *cmd = Add_Command (pass, blend, material, texture, &center);
+	if (cmd == 0)
+		return;
+
+	cmd->type = DRAW_INSTANCES;
+	cmd->transform = -1;
+	cmd->object = object;
+	cmd->num_layers = num_layers;
+	for (int i = 0; i < num_layers; i++)
+		cmd->layers[i] = layers[i];
+	cmd->first_matrix = num_matrices;
+	cmd->count = count;
+
+	for (int i = 0; i < count * per_instance; i++)
+		instance_matrix[num_matrices++] = matrices[i];
+}
+
+/*____________________________________________________________________
+|
+| Function: Draw_List_Billboard
+|
+| Input: Called from Queue_FX
+| Output: Records an alpha tested billboard draw in the alpha pass.
+|___________________________________________________________________*/
+
+void Draw_List_Billboard (int material, gx3dTexture texture, int transform_id, gx3dObjectLayer *layer, gx3dMatrix *texture_matrix, int alpha_test, gx3dVector *center)
+{
+	Draw_Command *c = Add_Command (DRAW_PASS_ALPHA, DRAW_BLEND_ALPHA_TEST, material, texture, center);
+	if (c == 0)
+		return;
+
+	c->type = DRAW_BILLBOARD;
+	c->transform = transform_id;
+	c->layer = layer;
+	c->alpha_test = alpha_test;
+	c->matrix = *texture_matrix;
+}
+
+/*____________________________________________________________________
+|
+| Function: Draw_List_Particles
+|
+| Input: Called from Render_GameScreen
+| Output: Records an alpha tested particle system draw in the alpha
+|   pass (the particle system is updated by the caller).
+|___________________________________________________________________*/
+
+void Draw_List_Particles (int material, gx3dParticleSystem particles, gx3dMatrix *m, gx3dVector *heading, int alpha_test, gx3dVector *center)
+{
+	Draw_Command *c = Add_Command (DRAW_PASS_ALPHA, DRAW_BLEND_ALPHA_TEST, material, 0, center);
+	if (c == 0)
+		return;
+
+	c->type = DRAW_PARTICLES;
+	c->transform = -1;
+	c->particles = particles;
+	c->matrix = *m;
+	c->heading = *heading;
+	c->alpha_test = alpha_test;
+}
+
+/*____________________________________________________________________
+|
+| Function: Draw_List_Clear
+|
+| Input: Called from Render_GameScreen, Draw_List_Begin,
+|   Draw_List_Execute
+| Output: Drops all recorded draws and transforms.
+|___________________________________________________________________*/
+
+void Draw_List_Clear ()
+{
+	num_commands = 0;
+	num_transforms = 0;
+	num_matrices = 0;
+	num_textures = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Draw_List_Execute
+|
+| Input: Called from Render_GameScreen
+| Output: Sorts the recorded draws by key and draws them, setting only
+|   the render state that changes from one draw to the next (through
+|   the render state cache).  Leaves alpha testing, the texture matrix
+|   and specular lighting disabled and alpha blending enabled.
+|___________________________________________________________________*/
+
+void Draw_List_Execute ()
+{
+	int pass = -1, material = -1, transform_id = -1;
+	gx3dTexture texture = 0;
+	bool texture_set = false;
+
+	std::sort (key, key + num_commands);
+	commands_run += num_commands;
+
+	for (int k = 0; k < num_commands; k++) {
+		Draw_Command *c = &command[key[k] & ((1 << KEY_INDEX_BITS) - 1)];
+
+		if (c->pass != pass) {
+			Draw_Pass *p = &draw_pass[c->pass];
+			Render_State_Projection (p->fov, p->near_plane, p->far_plane);
+			Render_State_Fog (p->fog);
+			pass = c->pass;
+		}
+
+		Render_State_Alpha_Blending (c->blend != DRAW_BLEND_NONE);
+		Render_State_Alpha_Testing (c->blend == DRAW_BLEND_ALPHA_TEST, c->alpha_test);
+
+		if (c->material != material) {
+			Draw_Material *m = &draw_material[c->material];
+			gx3d_SetMaterial (m->data);
+			state_changes++;
+			Render_State_Ambient_Light (m->ambient);
+			Render_State_Specular_Lighting (m->specular);
+			material = c->material;
+		}
+
+		Render_State_Texture_Matrix (c->type == DRAW_BILLBOARD);
+		if (c->type == DRAW_BILLBOARD) {
+			gx3d_SetTextureMatrix (0, &c->matrix);
+			state_changes++;
+		}
+
+		if (c->type != DRAW_PARTICLES AND (NOT texture_set OR c->texture != texture)) {
+			gx3d_SetTexture (0, c->texture);
+			state_changes++;
+			texture = c->texture;
+			texture_set = true;
+		}
+
+		if (c->transform >= 0 AND c->transform != transform_id) {
+			Apply_Transform (&draw_transform[c->transform]);
+			transform_id = c->transform;
+		}
+
+		switch (c->type) {
+		case DRAW_OBJECT:
+			gx3d_DrawObject (c->object, 0);
+			draws++;
+			break;
+		case DRAW_LAYER:
+		case DRAW_BILLBOARD:
+			gx3d_DrawObjectLayer (c->layer, 0);
+			draws++;
+			break;
+		case DRAW_PARTICLES:
+			gx3d_SetParticleSystemMatrix (c->particles, &c->matrix);
+			gx3d_DrawParticleSystem (c->particles, &c->heading, false);
+			draws++;
+			break;
+		case DRAW_INSTANCES:
+			Draw_Instances (c);
+			transform_id = -1; // the object matrices were changed
+			break;
+		}
+	}
+
+	// Leave the state the 2D graphics expect
+	Render_State_Alpha_Testing (false, 0);
+	Render_State_Texture_Matrix (false);
+	Render_State_Specular_Lighting (false);
+	Render_State_Alpha_Blending (true);
+
+	Draw_List_Clear ();
+}
+
+/*____________________________________________________________________
+|
+| Function: Draw_List_Frame_Stats
+|
+| Input: Called from Draw_List_Report
+| Output: Returns the commands executed, gx3d draws and gx3d state
+|   changes of the last whole frame.
+|___________________________________________________________________*/
+
+void Draw_List_Frame_Stats (unsigned *frame_commands, unsigned *frame_draws, unsigned *frame_state_changes)
+{
+	*frame_commands = last_commands;
+	*frame_draws = last_draws;
+	*frame_state_changes = last_state_changes;
+}
+
+/*____________________________________________________________________
+|
+| Function: Draw_List_Report
+|
+| Input: Called from Render_GameScreen
+| Output: Writes to DEBUG.TXT the average commands executed, gx3d draws
+|   and gx3d state changes per frame since the last report, and starts
+|   counting again.
+|___________________________________________________________________*/
+
+void Draw_List_Report (char *screen)
+{
+	char str[200];
+	unsigned frame_commands, frame_draws, frame_state_changes;
+
+	Draw_List_Frame_Stats (&frame_commands, &frame_draws, &frame_state_changes);
+	if (total_frames) {
+		sprintf (str, "%s: %u draw commands, %u gx3d draws, %u gx3d state changes per frame (last frame %u, %u, %u) over %u frames",
+			screen, total_commands / total_frames, total_draws / total_frames, total_state_changes / total_frames,
+			frame_commands, frame_draws, frame_state_changes, total_frames);
+		DEBUG_WRITE (str);
+	}
+
+	total_commands = 0;
+	total_draws = 0;
+	total_state_changes = 0;
+	total_frames = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Add_Command
+|
+| Input: Called from Draw_List_Object, Draw_List_Instances,
+|   Draw_List_Billboard, Draw_List_Particles
+| Output: Takes the next command and builds its sort key.  Returns 0 if
+|   the list is full.
+|___________________________________________________________________*/
+
+static Draw_Command *Add_Command (int pass, int blend, int material, gx3dTexture texture, gx3dVector *center)
+{
+	if (num_commands == MAX_DRAW_COMMANDS)
+		return (0);
+
+	int index = num_commands++;
+	Draw_Command *c = &command[index];
+	c->pass = pass;
+	c->blend = blend;
+	c->material = material;
+	c->texture = texture;
+
+	DrawKey depth = Depth (center);
+	DrawKey k = ((DrawKey)pass << KEY_PASS_SHIFT) | ((DrawKey)blend << KEY_BLEND_SHIFT) | (DrawKey)index;
+	if (pass == DRAW_PASS_ALPHA) {
+		k |= (((1 << KEY_DEPTH_BITS) - 1) - depth) << KEY_FAR_SHIFT;
+		k |= (DrawKey)material << KEY_ALPHA_MATERIAL_SHIFT;
+		k |= (DrawKey)Texture_Id (texture) << KEY_ALPHA_TEXTURE_SHIFT;
+	}
+	else {
+		k |= (DrawKey)material << KEY_MATERIAL_SHIFT;
+		k |= (DrawKey)Texture_Id (texture) << KEY_TEXTURE_SHIFT;
+		k |= depth << KEY_DEPTH_SHIFT;
+	}
+	key[index] = k;
+
+	return (c);
+}
+
+/*____________________________________________________________________
+|
+| Function: Texture_Id
+|
+| Input: Called from Add_Command
+| Output: Returns a small id for a texture, the same for every draw of
+|   the frame that uses it.
+|___________________________________________________________________*/
+
+static int Texture_Id (gx3dTexture texture)
+{
+	for (int i = 0; i < num_textures; i++)
+		if (texture_table[i] == texture)
+			return (i);
+
+	// Past the table the textures share the last id (the draws are still correct, just not grouped)
+	if (num_textures == MAX_DRAW_TEXTURES)
+		return (MAX_DRAW_TEXTURES - 1);
+	texture_table[num_textures] = texture;
+
+	return (num_textures++);
+}
+
+/*____________________________________________________________________
+|
+| Function: Depth
+|
+| Input: Called from Add_Command
+| Output: Returns the distance of center in front of the eye, scaled to
+|   KEY_DEPTH_BITS bits.
+|___________________________________________________________________*/
+
+static unsigned Depth (gx3dVector *center)
+{
+	float d = (center->x - eye_position.x) * eye_forward.x + (center->y - eye_position.y) * eye_forward.y + (center->z - eye_position.z) * eye_forward.z;
+
+	if (d <= 0)
+		return (0);
+	if (d >= DRAW_MAX_DEPTH)
+		return ((1 << KEY_DEPTH_BITS) - 1);
+
+	return ((unsigned)(d / DRAW_MAX_DEPTH * ((1 << KEY_DEPTH_BITS) - 1)));
+}
+
+/*____________________________________________________________________
+|
+| Function: Apply_Transform
+|
+| Input: Called from Draw_List_Execute
+| Output: Sets the matrices of a transform on its object.
+|___________________________________________________________________*/
+
+static void Apply_Transform (Draw_Transform *t)
+{
+	Transform_Set (t->object, t->layer, &t->matrix);
+	if (t->layer)
+		Transform_Update (t->object);
+}
+
+/*____________________________________________________________________
+|
+| Function: Draw_Instances
+|
+| Input: Called from Draw_List_Execute
+| Output: Draws every instance of an instanced command with the state
+|   already set, only changing the matrices between instances.
+|___________________________________________________________________*/
+
+static void Draw_Instances (Draw_Command *c)
+{
+	gx3dMatrix *m = &instance_matrix[c->first_matrix];
+
+	if (c->num_layers == 0) {
+		for (int i = 0; i < c->count; i++, m++) {
+			Transform_Set (c->object, 0, m);
+			gx3d_DrawObject (c->object, 0);
+		}
+		draws += c->count;
+		return;
+	}
+
+	for (int i = 0; i < c->count; i++) {
+		for (int j = 0; j < c->num_layers; j++, m++)
+			Transform_Set (c->object, c->layers[j], m);
+		Transform_Update (c->object);
+		for (int j = 0; j < c->num_layers; j++)
+			gx3d_DrawObjectLayer (c->layers[j], 0);
+	}
+	draws += c->count * c->num_layers;
+}
@@ -0,0 +1,68 @@
+/*____________________________________________________________________
+|
+| File: drawlist.h
+|
+| Description: Command buffer for the 3D draws of a frame.  Draws are
+|   recorded with a 64 bit sort key, sorted once and executed, so that
+|   every render state change happens once per run of equal keys.
+|   Include after dp.h.
+|___________________________________________________________________*/
+
+// Passes, executed in this order
+#define DRAW_PASS_SKY			0 // sorted like DRAW_PASS_OPAQUE
+#define DRAW_PASS_OPAQUE		1 // sorted by state, then front to back
+#define DRAW_PASS_ALPHA			2 // sorted back to front, then by state
+#define MAX_DRAW_PASSES			3
+
+// Blend modes
+#define DRAW_BLEND_NONE			0
+#define DRAW_BLEND_ALPHA		1
+#define DRAW_BLEND_ALPHA_TEST	2 // alpha blending with alpha testing
+
+#define MAX_DRAW_MATERIALS		16
+
+// Sets the projection and fog used for a pass
+void Draw_List_Set_Pass (int pass, float fov, float near_plane, float far_plane, bool fog);
+
+// Sets the material, ambient light and specular lighting used for a
+// material id (0 to MAX_DRAW_MATERIALS - 1)
+void Draw_List_Set_Material (int material, gx3dMaterialData *data, gx3dColor ambient, bool specular);
+
+// Starts a new frame.  Depth is measured from eye along forward.
+void Draw_List_Begin (gx3dVector *eye, gx3dVector *forward);
+
+// Records a transform for the draws that follow: sets the matrix of a
+// layer of the object (or of the whole object when layer is 0).
+// Returns its id (-1 if none are left).
+int Draw_List_Transform (gx3dObject *object, gx3dObjectLayer *layer, gx3dMatrix *m);
+
+// Records a draw of a whole object (layer 0) or of one of its layers.
+// center is the point used for depth sorting (in view of the eye).
+void Draw_List_Object (int pass, int blend, int material, gx3dTexture texture, int transform, gx3dObject *object, gx3dObjectLayer *layer, gx3dVector *center);
+
+// Records one draw of count instances of an object (num_layers is 0) or
+// of some of its layers.  matrices holds num_layers matrices per instance
+// (one object matrix when num_layers is 0), and every layer is drawn for
+// every instance with the same state.  Sorts by the nearest instance
+// (the farthest one in the alpha pass).
+void Draw_List_Instances (int pass, int blend, int material, gx3dTexture texture, gx3dObject *object, int num_layers, gx3dObjectLayer **layers, gx3dMatrix *matrices, int count);
+
+// Records an alpha tested billboard layer drawn with a texture matrix
+void Draw_List_Billboard (int material, gx3dTexture texture, int transform, gx3dObjectLayer *layer, gx3dMatrix *texture_matrix, int alpha_test, gx3dVector *center);
+
+// Records an alpha tested particle system draw
+void Draw_List_Particles (int material, gx3dParticleSystem particles, gx3dMatrix *m, gx3dVector *heading, int alpha_test, gx3dVector *center);
+
+// Drops everything recorded since Draw_List_Begin
+void Draw_List_Clear ();
+
+// Sorts and draws everything recorded, then clears the list
+void Draw_List_Execute ();
+
+// Gets the commands executed, gx3d draws and gx3d state changes of the
+// last whole frame
+void Draw_List_Frame_Stats (unsigned *commands, unsigned *draws, unsigned *state_changes);
+
+// Writes to DEBUG.TXT the commands, draws and state changes per frame
+// since the last report
+void Draw_List_Report (char *screen);
@@ -0,0 +1,137 @@
+/*____________________________________________________________________
+|
+| File: glyphs.cpp
+|
+| Description: Glyph batches for the HUD and game over numbers.  Every
+|   digit used to be a copy of billboards.lwo drawn with its own texture
+|   and texture matrix.  Now they all share one billboard layer: a batch
+|   keeps the layer matrix of each glyph and is drawn grouped by glyph,
+|   so the texture is set once and the texture matrix once per glyph
+|   shown.  Numbers are formatted straight into glyphs, without strings.
+|
+| Functions: Glyphs_Begin
+|            Glyphs_Add
+|            Glyphs_Add_Number
+|            Glyphs_Draw
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <first_header.h>
+#include "dp.h"
+
+#include "glyphs.h"
+#include "transform.h"
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define NUM_GLYPHS	(GLYPH_ATLAS_SIZE * GLYPH_ATLAS_SIZE)
+
+/*____________________________________________________________________
+|
+| Function: Glyphs_Begin
+|
+| Input: Called from Update_HUD, Render_GameOverScreen
+| Output: Empties a batch.
+|___________________________________________________________________*/
+
+void Glyphs_Begin (GlyphBatch *batch)
+{
+	batch->count = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Glyphs_Add
+|
+| Input: Called from Glyphs_Add_Number
+| Output: Adds a glyph after the others of the same cell (dropped if the
+|   batch is full).
+|___________________________________________________________________*/
+
+void Glyphs_Add (GlyphBatch *batch, int glyph, gx3dVector *position, float scale)
+{
+	gx3dMatrix s, t;
+	int i;
+
+	if (batch->count == MAX_GLYPHS OR glyph < 0 OR glyph >= NUM_GLYPHS)
+		return;
+
+	// Make room after the last glyph with a cell not past this one
+	for (i = batch->count; i > 0 AND batch->glyph[i - 1].glyph > glyph; i--)
+		batch->glyph[i] = batch->glyph[i - 1];
+	batch->count++;
+
+	batch->glyph[i].glyph = glyph;
+	gx3d_GetScaleMatrix (&s, scale, scale, scale);
+	gx3d_GetTranslateMatrix (&t, position->x, position->y, position->z);
+	gx3d_MultiplyMatrix (&s, &t, &batch->glyph[i].m);
+}
+
+/*____________________________________________________________________
+|
+| Function: Glyphs_Add_Number
+|
+| Input: Called from Update_HUD, Render_GameOverScreen
+| Output: Adds the digits of a number, right aligned in its slots.
+|   Digits that do not fit lose their left side.
+|___________________________________________________________________*/
+
+void Glyphs_Add_Number (GlyphBatch *batch, unsigned value, int num_slots, gx3dVector *slots, float scale, bool show_zeros)
+{
+	int j = num_slots - 1;
+
+	// At least one digit, even for 0
+	do {
+		Glyphs_Add (batch, value % 10, &slots[j--], scale);
+		value /= 10;
+	} while (value AND j >= 0);
+
+	if (show_zeros)
+		for (; j >= 0; j--)
+			Glyphs_Add (batch, 0, &slots[j], scale);
+}
+
+/*____________________________________________________________________
+|
+| Function: Glyphs_Draw
+|
+| Input: Called from Render_GameScreen, Render_GameOverScreen
+| Output: Draws every glyph of a batch.
+|___________________________________________________________________*/
+
+void Glyphs_Draw (GlyphBatch *batch, gx3dObject *object, gx3dObjectLayer *layer, gx3dTexture atlas)
+{
+	gx3dMatrix m;
+
+	if (batch->count == 0)
+		return;
+
+	gx3d_SetTexture (0, atlas);
+
+	for (int i = 0; i < batch->count; i++) {
+		Glyph *g = &batch->glyph[i];
+
+		// Offset the texture coordinates to the glyph's cell
+		if (i == 0 OR g->glyph != batch->glyph[i - 1].glyph) {
+			gx3d_GetTranslateTextureMatrix (&m, (float)(g->glyph % GLYPH_ATLAS_SIZE) / GLYPH_ATLAS_SIZE, (float)(g->glyph / GLYPH_ATLAS_SIZE) / GLYPH_ATLAS_SIZE);
+			gx3d_SetTextureMatrix (0, &m);
+		}
+
+		Transform_Set (object, layer, &g->m);
+		Transform_Update (object);
+		gx3d_DrawObjectLayer (layer, 0);
+	}
+}
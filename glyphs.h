@@ -0,0 +1,40 @@
+/*____________________________________________________________________
+|
+| File: glyphs.h
+|
+| Description: Batches of digits drawn from the 4x4 font atlas.  A batch
+|   is filled when the numbers it shows change and drawn every frame
+|   with a single billboard layer.
+|   Include after dp.h.
+|___________________________________________________________________*/
+
+#define MAX_GLYPHS			32 // glyphs in a batch
+#define GLYPH_ATLAS_SIZE	4  // the atlas is GLYPH_ATLAS_SIZE x GLYPH_ATLAS_SIZE glyphs
+
+// A glyph placed in a batch
+struct Glyph {
+	int glyph;							// cell of the atlas
+	gx3dMatrix m;						// billboard layer matrix
+};
+
+// Glyphs kept sorted by cell, so drawing sets each texture offset once
+struct GlyphBatch {
+	Glyph glyph[MAX_GLYPHS];
+	int count;
+};
+
+// Empties a batch
+void Glyphs_Begin (GlyphBatch *batch);
+
+// Adds a glyph (cell of the atlas, left to right then top to bottom: the
+// digits '0' to '9' are glyphs 0 to 9) centered at position
+void Glyphs_Add (GlyphBatch *batch, int glyph, gx3dVector *position, float scale);
+
+// Adds the decimal digits of value, right aligned in slots (the position
+// of each of the num_slots digits).  Slots left of the number show '0'
+// when show_zeros is set.
+void Glyphs_Add_Number (GlyphBatch *batch, unsigned value, int num_slots, gx3dVector *slots, float scale, bool show_zeros);
+
+// Draws a batch with a billboard layer of object and the atlas texture
+// (the caller enables the texture matrix)
+void Glyphs_Draw (GlyphBatch *batch, gx3dObject *object, gx3dObjectLayer *layer, gx3dTexture atlas);
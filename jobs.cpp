@@ -0,0 +1,442 @@
+/*____________________________________________________________________
+|
+| File: jobs.cpp
+|
+| Description: Work-stealing thread pool.
+|   - Every thread has a queue of ranges.  A job's ranges are dealt out
+|     over all the queues; a thread pops the newest range of its own
+|     queue and steals the oldest range of another queue when its own
+|     is empty.  Threads that are not workers share queue 0.
+|   - A job keeps a count of unfinished ranges.  The thread that
+|     finishes the last range marks the job as finished.
+|   - Jobs_Wait runs ranges instead of blocking, so the calling thread
+|     does its share of the work (and nested jobs can't deadlock).
+|   - Idle workers spin briefly, then sleep until ranges are queued.
+|
+| Functions: Jobs_Init
+|            Jobs_Free
+|            Jobs_Num_Threads
+|            Jobs_Parallel_For
+|             Jobs_Add
+|             Jobs_Wait
+|             Jobs_Worker
+|             Job_Pending
+|             Push_Range
+|             Take_Range
+|             Run_Range
+|             Wake_Workers
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "jobs.h"
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define MAX_JOB_THREADS		32
+#define MAX_JOBS			64 // jobs that can be queued or running at once
+#define JOB_QUEUE_SIZE		1024 // ranges a queue can hold (power of 2)
+#define JOB_SPIN_COUNT		256 // looks for work before an idle worker sleeps
+
+// Handle of a queued job (0 is a job that is already done)
+typedef unsigned JobHandle;
+
+/*___________________
+|
+| Type definitions
+|__________________*/
+
+// A range of indices of a job
+struct Job_Range {
+	int job;							// slot in job[]
+	int start, end;
+};
+
+// Ranges queued for one thread
+struct Job_Queue {
+	std::mutex lock;
+	Job_Range range[JOB_QUEUE_SIZE];
+	unsigned head, tail;				// others steal at head, the owner pushes and pops at tail
+};
+
+// A job
+struct Job {
+	JobFunction function;
+	void *data;
+	int count, grain;
+	std::atomic<JobHandle> handle;		// slot + MAX_JOBS * generation (never 0)
+	std::atomic<int> remaining;			// ranges not finished
+	std::atomic<bool> finished;			// the last range has finished (the slot is free)
+};
+
+/*___________________
+|
+| Function prototypes
+|__________________*/
+
+static JobHandle Jobs_Add (JobFunction function, void *data, int count, int grain);
+static void Jobs_Wait (JobHandle handle);
+static void Jobs_Worker (int index);
+static bool Job_Pending (JobHandle handle);
+static void Push_Range (int queue_index, Job_Range *range);
+static bool Take_Range (Job_Range *range);
+static void Run_Range (Job_Range *range);
+static void Wake_Workers ();
+
+/*___________________
+|
+| Global variables
+|__________________*/
+
+static std::thread worker[MAX_JOB_THREADS];
+static int num_threads; // 0 while the workers are stopped
+static std::atomic<bool> running;
+static thread_local int thread_index; // queue of the current thread (0 for threads that are not workers)
+
+// Queued ranges
+static Job_Queue queue[MAX_JOB_THREADS];
+static std::atomic<int> num_queued;
+
+// Jobs (slot allocation is guarded by jobs_lock)
+static Job job[MAX_JOBS];
+static std::mutex jobs_lock;
+static unsigned next_generation;
+static int next_slot;
+
+// Sleeping workers
+static std::mutex sleep_lock;
+static std::condition_variable wake;
+
+/*____________________________________________________________________
+|
+| Function: Jobs_Init
+|
+| Input: Called from the benchmark
+| Output: Starts threads - 1 worker threads.
+|___________________________________________________________________*/
+
+void Jobs_Init (int threads)
+{
+	Jobs_Free ();
+
+	if (threads <= 0)
+		threads = (int)std::thread::hardware_concurrency ();
+	if (threads < 1)
+		threads = 1;
+	else if (threads > MAX_JOB_THREADS)
+		threads = MAX_JOB_THREADS;
+
+	for (int i = 0; i < MAX_JOBS; i++) {
+		job[i].handle.store (0);
+		job[i].remaining.store (0);
+		job[i].finished.store (true);
+	}
+	for (int i = 0; i < MAX_JOB_THREADS; i++)
+		queue[i].head = queue[i].tail = 0;
+	num_queued.store (0);
+	next_generation = 1;
+	next_slot = 0;
+
+	num_threads = threads;
+	running.store (true);
+	for (int i = 1; i < num_threads; i++)
+		worker[i] = std::thread (Jobs_Worker, i);
+}
+
+/*____________________________________________________________________
+|
+| Function: Jobs_Free
+|
+| Input: Called from Jobs_Init, the benchmark
+| Output: Stops the worker threads.
+|___________________________________________________________________*/
+
+void Jobs_Free ()
+{
+	if (num_threads == 0)
+		return;
+
+	running.store (false);
+	Wake_Workers ();
+	for (int i = 1; i < num_threads; i++)
+		worker[i].join ();
+	num_threads = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Jobs_Num_Threads
+|
+| Input: Called from the benchmark
+| Output: Returns the number of threads running jobs.
+|___________________________________________________________________*/
+
+int Jobs_Num_Threads ()
+{
+	return (num_threads > 1 ? num_threads : 1);
+}
+
+/*____________________________________________________________________
+|
+| Function: Jobs_Parallel_For
+|
+| Input: Called from Update_Hoshus, Update_Projectiles,
+|   Collide_Sphere_Batch_Parallel, the benchmark
+| Output: Runs function over indices 0 to count - 1 and returns when
+|   all of them are done.
+|___________________________________________________________________*/
+
+void Jobs_Parallel_For (JobFunction function, void *data, int count, int grain)
+{
+	if (count <= 0)
+		return;
+
+	// Not worth waking the workers for a single range
+	if (num_threads <= 1 OR count <= grain)
+		function (data, 0, count);
+	else
+		Jobs_Wait (Jobs_Add (function, data, count, grain));
+}
+
+/*____________________________________________________________________
+|
+| Function: Jobs_Add
+|
+| Input: Called from Jobs_Parallel_For
+| Output: Deals the ranges of a job out over the queues, starting with
+|   the queue of the current thread.  Returns its handle.
+|___________________________________________________________________*/
+
+static JobHandle Jobs_Add (JobFunction function, void *data, int count, int grain)
+{
+	if (grain < 1)
+		grain = 1;
+
+	// Take a free slot, helping with the queued work while there is none
+	std::unique_lock<std::mutex> lock (jobs_lock);
+	int slot = -1;
+	while (slot == -1) {
+		for (int i = 0; i < MAX_JOBS; i++) {
+			int s = (next_slot + i) % MAX_JOBS;
+			if (job[s].finished.load (std::memory_order_acquire)) {
+				slot = s;
+				break;
+			}
+		}
+		if (slot == -1) {
+			lock.unlock ();
+			Job_Range range;
+			if (Take_Range (&range))
+				Run_Range (&range);
+			else
+				std::this_thread::yield ();
+			lock.lock ();
+		}
+	}
+	next_slot = (slot + 1) % MAX_JOBS;
+
+	Job *j = &job[slot];
+	JobHandle handle = slot + MAX_JOBS * next_generation++;
+	if (next_generation > (0xFFFFFFFFu / MAX_JOBS))
+		next_generation = 1;
+	j->function = function;
+	j->data = data;
+	j->count = count;
+	j->grain = grain;
+	j->remaining.store ((count + grain - 1) / grain);
+	j->finished.store (false);
+	j->handle.store (handle, std::memory_order_release);
+	lock.unlock ();
+
+	int q = thread_index;
+	int start = 0;
+	do {
+		Job_Range range = { slot, start, start + grain < count ? start + grain : count };
+		start = range.end;
+		Push_Range (q, &range);
+		q = (q + 1) % num_threads;
+	} while (start < count);
+
+	Wake_Workers ();
+
+	return (handle);
+}
+
+/*____________________________________________________________________
+|
+| Function: Jobs_Wait
+|
+| Input: Called from Jobs_Parallel_For
+| Output: Runs queued ranges until the job is done.
+|___________________________________________________________________*/
+
+static void Jobs_Wait (JobHandle handle)
+{
+	while (Job_Pending (handle)) {
+		Job_Range range;
+		if (Take_Range (&range))
+			Run_Range (&range);
+		else
+			std::this_thread::yield ();
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Jobs_Worker
+|
+| Input: Called from Jobs_Init (on a worker thread)
+| Output: Runs queued ranges until the workers are stopped.
+|___________________________________________________________________*/
+
+static void Jobs_Worker (int index)
+{
+	int spins = 0;
+
+	thread_index = index;
+
+	while (running.load (std::memory_order_acquire)) {
+		Job_Range range;
+		if (Take_Range (&range)) {
+			Run_Range (&range);
+			spins = 0;
+		}
+		else if (++spins < JOB_SPIN_COUNT)
+			std::this_thread::yield ();
+		else {
+			std::unique_lock<std::mutex> lock (sleep_lock);
+			wake.wait (lock, [] { return num_queued.load () > 0 OR NOT running.load (); });
+			spins = 0;
+		}
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Job_Pending
+|
+| Input: Called from Jobs_Wait
+| Output: Returns true if the job has not finished yet.
+|___________________________________________________________________*/
+
+static bool Job_Pending (JobHandle handle)
+{
+	if (handle == 0)
+		return (false);
+
+	Job *j = &job[handle % MAX_JOBS];
+
+	// A slot that has been reused belongs to a newer job
+	return (j->handle.load (std::memory_order_acquire) == handle AND NOT j->finished.load (std::memory_order_acquire));
+}
+
+/*____________________________________________________________________
+|
+| Function: Push_Range
+|
+| Input: Called from Jobs_Add
+| Output: Adds a range to the back of a queue.  Runs it now if the
+|   queue is full.
+|___________________________________________________________________*/
+
+static void Push_Range (int queue_index, Job_Range *range)
+{
+	Job_Queue *q = &queue[queue_index];
+
+	q->lock.lock ();
+	if (q->tail - q->head == JOB_QUEUE_SIZE) {
+		q->lock.unlock ();
+		Run_Range (range);
+		return;
+	}
+	q->range[q->tail++ & (JOB_QUEUE_SIZE - 1)] = *range;
+	num_queued.fetch_add (1);
+	q->lock.unlock ();
+}
+
+/*____________________________________________________________________
+|
+| Function: Take_Range
+|
+| Input: Called from Jobs_Add, Jobs_Wait, Jobs_Worker
+| Output: Pops the newest range of the current thread's queue, or
+|   steals the oldest range of another queue.  Returns false if every
+|   queue is empty.
+|___________________________________________________________________*/
+
+static bool Take_Range (Job_Range *range)
+{
+	if (num_queued.load (std::memory_order_acquire) <= 0)
+		return (false);
+
+	for (int i = 0; i < num_threads; i++) {
+		Job_Queue *q = &queue[(thread_index + i) % num_threads];
+		bool own = (i == 0);
+
+		q->lock.lock ();
+		if (q->tail != q->head) {
+			if (own)
+				*range = q->range[--q->tail & (JOB_QUEUE_SIZE - 1)];
+			else
+				*range = q->range[q->head++ & (JOB_QUEUE_SIZE - 1)];
+			num_queued.fetch_sub (1);
+			q->lock.unlock ();
+			return (true);
+		}
+		q->lock.unlock ();
+	}
+
+	return (false);
+}
+
+/*____________________________________________________________________
+|
+| Function: Run_Range
+|
+| Input: Called from Jobs_Add, Jobs_Wait, Jobs_Worker, Push_Range
+| Output: Runs a range of a job.  Finishes the job after its last range.
+|___________________________________________________________________*/
+
+static void Run_Range (Job_Range *range)
+{
+	Job *j = &job[range->job];
+
+	if (range->start < range->end)
+		j->function (j->data, range->start, range->end);
+
+	if (j->remaining.fetch_sub (1, std::memory_order_acq_rel) == 1)
+		j->finished.store (true, std::memory_order_release);
+}
+
+/*____________________________________________________________________
+|
+| Function: Wake_Workers
+|
+| Input: Called from Jobs_Free, Jobs_Add
+| Output: Wakes the sleeping workers.
+|___________________________________________________________________*/
+
+static void Wake_Workers ()
+{
+	// Taking the lock orders the change seen by the sleep test before the wake up
+	sleep_lock.lock ();
+	sleep_lock.unlock ();
+	wake.notify_all ();
+}
@@ -0,0 +1,27 @@
+/*____________________________________________________________________
+|
+| File: jobs.h
+|
+| Description: Small work-stealing thread pool for per-frame parallel
+|   work.  A job runs a function over a range of indices, split into
+|   ranges that the threads take from their own queue first and steal
+|   from the other queues when theirs is empty.
+|___________________________________________________________________*/
+
+// Work done on indices start to end - 1
+typedef void (*JobFunction) (void *data, int start, int end);
+
+// Starts the worker threads.  threads counts the calling thread (0 uses
+// one thread per hardware thread).  Without Jobs_Init, every job runs
+// on the calling thread, which is how the game runs.
+void Jobs_Init (int threads);
+
+// Stops the worker threads (call when no jobs are queued)
+void Jobs_Free ();
+
+// Returns the number of threads that run jobs, counting the caller
+int Jobs_Num_Threads ();
+
+// Runs function over indices 0 to count - 1 on all threads and returns
+// when it is done.  Runs on the calling thread alone if count <= grain.
+void Jobs_Parallel_For (JobFunction function, void *data, int count, int grain);
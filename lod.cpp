@@ -0,0 +1,102 @@
+/*____________________________________________________________________
+|
+| File: lod.cpp
+|
+| Description: Level of detail selection.  Each level is drawn down to
+|   a projected size, then the next one takes over.  An object only
+|   switches once its size is LOD_HYSTERESIS past the threshold, so
+|   objects sitting at a threshold do not flicker between two levels.
+|
+| Functions: Lod_Init
+|            Lod_Projected_Size
+|            Lod_Select
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <first_header.h>
+#include "dp.h"
+
+#include <math.h>
+
+#include "lod.h"
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define DEGREES_TO_RADIANS(_d_)	((_d_) * (float)3.14159265 / (float)180.0)
+
+/*____________________________________________________________________
+|
+| Function: Lod_Init
+|
+| Input: Called from Init_GameScreen
+| Output: Sets the thresholds of the levels that were loaded.
+|___________________________________________________________________*/
+
+void Lod_Init (Lod_Set *set, int num_meshes, const float *mesh_size, bool impostor, float impostor_size)
+{
+	if (num_meshes < 1)
+		num_meshes = 1;
+	if (num_meshes > MAX_LOD_LEVELS)
+		num_meshes = MAX_LOD_LEVELS;
+
+	set->num_meshes = num_meshes;
+	set->impostor = impostor;
+	for (int i = 0; i < num_meshes - 1; i++)
+		set->min_size[i] = mesh_size[i];
+	set->min_size[num_meshes - 1] = impostor ? impostor_size : 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Lod_Projected_Size
+|
+| Input: Called from Render_GameScreen, Draw_Hoshus
+| Output: Returns the fraction of the screen height covered by a sphere.
+|___________________________________________________________________*/
+
+float Lod_Projected_Size (float radius, float distance, float fov)
+{
+	if (distance <= radius)
+		return (1);
+
+	return (radius / (distance * tanf (DEGREES_TO_RADIANS(fov) / 2)));
+}
+
+/*____________________________________________________________________
+|
+| Function: Lod_Select
+|
+| Input: Called from Render_GameScreen, Draw_Hoshus
+| Output: Returns the level to draw at a projected size.
+|___________________________________________________________________*/
+
+int Lod_Select (const Lod_Set *set, float size, int level)
+{
+	int last = set->impostor ? set->num_meshes : set->num_meshes - 1;
+
+	if (level < 0)
+		level = 0;
+	if (level > last)
+		level = last;
+
+	// Coarser while smaller than the level's threshold, finer while bigger than the one before
+	while (level < last AND size < set->min_size[level] * (1 - LOD_HYSTERESIS))
+		level++;
+	while (level > 0 AND size > set->min_size[level - 1] * (1 + LOD_HYSTERESIS))
+		level--;
+
+	return (level);
+}
@@ -0,0 +1,32 @@
+/*____________________________________________________________________
+|
+| File: lod.h
+|
+| Description: Level of detail selection by projected size.  Level 0 is
+|   the full mesh, each next level a coarser mesh, and the level after
+|   the last mesh (when there is one) a camera facing impostor.
+|   Include after dp.h.
+|___________________________________________________________________*/
+
+#define MAX_LOD_LEVELS		3			// meshes, not counting the impostor
+#define LOD_HYSTERESIS		((float)0.15) // sizes must go this much past a threshold to switch back
+
+// Detail levels of an object
+struct Lod_Set {
+	int num_meshes;						// mesh levels loaded (at least the full mesh)
+	bool impostor;						// is there an impostor after the last mesh?
+	float min_size[MAX_LOD_LEVELS];		// smallest projected size drawn with each level (smaller uses the next one)
+};
+
+// Sets up the levels of an object.  mesh_size holds the smallest size of
+// each mesh level but the last, impostor_size the smallest size of the
+// last mesh when there is an impostor.
+void Lod_Init (Lod_Set *set, int num_meshes, const float *mesh_size, bool impostor, float impostor_size);
+
+// Returns the height of a sphere on screen, as a fraction of the screen
+// height, seen from distance with a vertical field of view (degrees)
+float Lod_Projected_Size (float radius, float distance, float fov);
+
+// Returns the level to draw at a projected size, starting from the level
+// drawn last (num_meshes is the impostor)
+int Lod_Select (const Lod_Set *set, float size, int level);
@@ -28,6 +28,8 @@
 #include <rom8x8.h>
 
 #include "main.h"
+#include "sim.h"
+#include "prefetch.h"
 #include "position.h"
 #include "render.h"
 
@@ -295,6 +297,8 @@ void Program_Run (void)
 
 	  quit = Render_Game_Loop(&state); 
   }
+
+  Prefetch_Stop ();
 }
 
 /*____________________________________________________________________
@@ -0,0 +1,1184 @@
+/*____________________________________________________________________
+|
+| File: meshcook.cpp
+|
+| Description: Offline mesh cooker.  Converts LightWave (LWO2) objects
+|   into cooked meshes, written next to each object with a .mesh
+|   extension and meant to be used where they are read, with nothing to
+|   parse:
+|   - Polygons are split into triangles, with normals smoothed between
+|     faces less than COOK_SMOOTH_ANGLE apart and texture coordinates
+|     from the first TXUV map (per polygon ones override).
+|   - Vertices that come out the same once quantized are merged.
+|   - Triangles are reordered for the post-transform cache (Forsyth's
+|     linear-speed method), then vertices in the order they are used.
+|   Prints, per mesh, the time to build it from the LightWave file
+|   against the time to load it cooked, and the average cache misses
+|   per triangle before and after the reordering.
+|
+|   Usage: meshcook Objects\raiu.lwo Objects\hoshu.lwo ...
+|   Build: g++ -O2 meshcook.cpp -o meshcook
+|
+| Functions: main
+|             Cook
+|             Read_LWO
+|             Read_Layer_Chunk
+|             Build_Mesh
+|             Compare_Poly_UVs
+|             Cook_Layer
+|             Quantize_UV
+|             Weld
+|             Optimize_Cache
+|             Vertex_Score
+|             Write_Mesh
+|             Report_Mesh
+|             Load_Mesh
+|             ACMR
+|             Free_Object
+|             U2
+|             U4
+|             F4
+|             VX
+|             Seconds
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define MESH_MAGIC				0x48534D4F // "OMSH"
+#define MESH_VERSION			1
+#define MESH_NAME_SIZE			32
+#define MESH_CACHE_SIZE			16 // post-transform cache entries assumed by ACMR
+
+#define MAX_COOK_LAYERS			32
+#define COOK_SMOOTH_ANGLE		89.5f // degrees
+#define COOK_LOAD_REPEATS		20 // cooked loads timed per mesh
+
+// Forsyth's scoring constants
+#define FORSYTH_CACHE_SIZE		32
+#define FORSYTH_CACHE_DECAY		1.5f
+#define FORSYTH_LAST_TRI_SCORE	0.75f
+#define FORSYTH_VALENCE_SCALE	2.0f
+#define FORSYTH_VALENCE_POWER	0.5f
+
+#define ID4(a,b,c,d)			((unsigned)(a) << 24 | (unsigned)(b) << 16 | (unsigned)(c) << 8 | (unsigned)(d))
+
+/*___________________
+|
+| Type definitions
+|__________________*/
+
+// Start of a cooked mesh, followed by the layers, the vertices and the
+// indices
+struct Mesh_Header {
+	unsigned magic;
+	unsigned version;
+	unsigned num_layers;
+	unsigned num_vertices;
+	unsigned num_indices;
+	float uv_min[2];					// texture coordinates are uv_min + q / 65535 * uv_scale
+	float uv_scale[2];
+	unsigned reserved;
+};
+
+// A layer of the LightWave object, drawn as one indexed triangle list
+struct Mesh_Layer {
+	char name[MESH_NAME_SIZE];
+	float pivot[3];
+	unsigned first_vertex, num_vertices;
+	unsigned first_index, num_indices;	// indices count from first_vertex
+};
+
+// 20 bytes instead of 32 for float normals and texture coordinates
+struct Mesh_Vertex {
+	float x, y, z;
+	signed char nx, ny, nz, pad;		// normal * 127
+	unsigned short u, v;
+};
+
+// A cooked mesh read back by Load_Mesh
+struct Cooked_Mesh {
+	const Mesh_Header *header;
+	const Mesh_Layer *layer;
+	const Mesh_Vertex *vertex;
+	const unsigned short *index;
+	void *buffer;						// the whole file (free it)
+};
+
+// Texture coordinates of one polygon corner (from a VMAD chunk)
+struct Poly_UV {
+	int poly, point;
+	float u, v;
+};
+
+// A layer as read from the LightWave file
+struct LWO_Layer {
+	char name[MESH_NAME_SIZE];
+	float pivot[3];
+	float *point;						// x, y, z per point
+	int num_points;
+	float *point_uv;					// u, v per point (from VMAP)
+	bool *has_uv;
+	int *poly_start;					// first corner of each polygon in corner
+	int *poly_size;
+	int num_polys;
+	int *corner;						// point of each polygon corner
+	int num_corners;
+	Poly_UV *poly_uv;					// sorted by polygon
+	int num_poly_uvs;
+};
+
+// A layer built into an indexed triangle list
+struct Built_Layer {
+	Mesh_Vertex *vertex;
+	int num_vertices;
+	unsigned short *index;
+	int num_indices;
+	float acmr_before, acmr_after;
+};
+
+// A LightWave object
+struct LWO_Object {
+	LWO_Layer layer[MAX_COOK_LAYERS];
+	int num_layers;
+	char uv_map[64];					// name of the texture map used
+	Built_Layer built[MAX_COOK_LAYERS];
+	float uv_min[2], uv_scale[2];
+};
+
+/*___________________
+|
+| Function prototypes
+|__________________*/
+
+static bool Cook (char *filename);
+static bool Read_LWO (char *filename, LWO_Object *object);
+static bool Read_Layer_Chunk (LWO_Object *object, unsigned id, const unsigned char *data, unsigned size);
+static bool Build_Mesh (LWO_Object *object);
+static int Compare_Poly_UVs (const void *a, const void *b);
+static bool Cook_Layer (LWO_Object *object, LWO_Layer *layer, Built_Layer *built, bool optimize);
+static unsigned short Quantize_UV (float uv, float uv_min, float uv_scale);
+static int Weld (Mesh_Vertex *corner, int num_corners, Mesh_Vertex *vertex, unsigned short *index);
+static void Optimize_Cache (unsigned short *index, int num_indices, int num_vertices);
+static float Vertex_Score (int cache_position, int valence);
+static bool Write_Mesh (char *filename, LWO_Object *object);
+static void Report_Mesh (char *lwo_filename, char *filename, LWO_Object *object, double build_time);
+static bool Load_Mesh (char *filename, Cooked_Mesh *mesh);
+static float ACMR (const unsigned short *index, int num_indices, int num_vertices, int cache_size);
+static void Free_Object (LWO_Object *object);
+static unsigned U2 (const unsigned char *p);
+static unsigned U4 (const unsigned char *p);
+static float F4 (const unsigned char *p);
+static int VX (const unsigned char **p, const unsigned char *end);
+static double Seconds ();
+
+/*____________________________________________________________________
+|
+| Function: main
+|
+| Input: -
+| Output: Cooks every LightWave file named.  Returns 0 if all of them
+|   were cooked.
+|___________________________________________________________________*/
+
+int main (int argc, char **argv)
+{
+	int failed = 0;
+
+	if (argc < 2) {
+		printf ("usage: meshcook object.lwo...\n");
+		return 1;
+	}
+
+	printf ("%-36s %6s %6s %8s %9s %10s %10s\n", "mesh", "tris", "verts", "lwo (ms)", "mesh (ms)", "acmr lwo", "acmr mesh");
+	for (int i = 1; i < argc; i++)
+		if (NOT Cook (argv[i]))
+			failed++;
+
+	return failed ? 1 : 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Cook
+|
+| Input: Called from main
+| Output: Cooks one LightWave file.  Returns false on error.
+|___________________________________________________________________*/
+
+static bool Cook (char *filename)
+{
+	char mesh_filename[260];
+	LWO_Object *object = (LWO_Object *) calloc (1, sizeof(LWO_Object));
+
+	// What loading the LightWave file costs: reading, smoothing and merging
+	double start = Seconds();
+	bool ok = object AND Read_LWO (filename, object) AND Build_Mesh (object);
+	double build_time = Seconds() - start;
+
+	if (ok) {
+		strncpy (mesh_filename, filename, sizeof(mesh_filename) - 6);
+		mesh_filename[sizeof(mesh_filename) - 6] = 0;
+		char *dot = strrchr (mesh_filename, '.');
+		if (dot == 0 OR strchr (dot, '\\') OR strchr (dot, '/'))
+			dot = mesh_filename + strlen (mesh_filename);
+		strcpy (dot, ".mesh");
+
+		// Cook again, this time reordered for the cache
+		for (int i = 0; i < object->num_layers AND ok; i++) {
+			free (object->built[i].vertex);
+			free (object->built[i].index);
+			ok = Cook_Layer (object, &object->layer[i], &object->built[i], true);
+		}
+		ok = ok AND Write_Mesh (mesh_filename, object);
+		if (ok)
+			Report_Mesh (filename, mesh_filename, object, build_time);
+	}
+	if (NOT ok)
+		printf ("%s: not cooked\n", filename);
+
+	if (object)
+		Free_Object (object);
+
+	return (ok);
+}
+
+/*____________________________________________________________________
+|
+| Function: Read_LWO
+|
+| Input: Called from Cook
+| Output: Reads the layers of a LightWave object.  Returns false if the
+|   file can't be read or is not an LWO2 file.
+|___________________________________________________________________*/
+
+static bool Read_LWO (char *filename, LWO_Object *object)
+{
+	FILE *fp = fopen (filename, "rb");
+	if (fp == 0) {
+		printf ("can't open %s\n", filename);
+		return (false);
+	}
+	fseek (fp, 0, SEEK_END);
+	long size = ftell (fp);
+	fseek (fp, 0, SEEK_SET);
+	unsigned char *data = (unsigned char *) malloc (size > 0 ? size : 1);
+	bool ok = data AND size >= 12 AND fread (data, 1, size, fp) == (size_t)size;
+	fclose (fp);
+
+	ok = ok AND U4(data) == ID4('F','O','R','M') AND U4(data + 8) == ID4('L','W','O','2');
+	if (NOT ok)
+		printf ("%s: not an LWO2 file\n", filename);
+
+	// Chunks are an id, a size and the data, padded to an even size
+	unsigned end = ok AND U4(data + 4) + 8 < (unsigned)size ? U4(data + 4) + 8 : (unsigned)size;
+	for (unsigned pos = 12; ok AND pos + 8 <= end; ) {
+		unsigned id = U4(data + pos), chunk_size = U4(data + pos + 4);
+		if (chunk_size > end - pos - 8) {
+			printf ("%s: chunk runs past the end of the file\n", filename);
+			ok = false;
+			break;
+		}
+		ok = Read_Layer_Chunk (object, id, data + pos + 8, chunk_size);
+		if (NOT ok)
+			printf ("%s: bad chunk %c%c%c%c\n", filename, id >> 24, (id >> 16) & 0xFF, (id >> 8) & 0xFF, id & 0xFF);
+		pos += 8 + chunk_size + (chunk_size & 1);
+	}
+	free (data);
+
+	return (ok);
+}
+
+/*____________________________________________________________________
+|
+| Function: Read_Layer_Chunk
+|
+| Input: Called from Read_LWO
+| Output: Adds a chunk to the object: a new layer (LAYR), or the points
+|   (PNTS), texture maps (VMAP, VMAD) or polygons (POLS) of the current
+|   one.  Other chunks are skipped.  Returns false if it is malformed.
+|___________________________________________________________________*/
+
+static bool Read_Layer_Chunk (LWO_Object *object, unsigned id, const unsigned char *data, unsigned size)
+{
+	const unsigned char *p = data, *end = data + size;
+	LWO_Layer *layer = object->num_layers ? &object->layer[object->num_layers - 1] : 0;
+	size_t len;
+
+	// Objects without a LAYR chunk have one unnamed layer
+	if (layer == 0 AND (id == ID4('P','N','T','S') OR id == ID4('V','M','A','P') OR id == ID4('V','M','A','D') OR id == ID4('P','O','L','S')))
+		layer = &object->layer[object->num_layers++];
+
+	switch (id) {
+		case ID4('L','A','Y','R'):
+			if (size < 16 OR object->num_layers == MAX_COOK_LAYERS)
+				return (false);
+			layer = &object->layer[object->num_layers++];
+			for (int i = 0; i < 3; i++)
+				layer->pivot[i] = F4(data + 4 + i * 4);
+			len = strnlen ((const char *)data + 16, size - 16);
+			if (len > MESH_NAME_SIZE - 1)
+				len = MESH_NAME_SIZE - 1;
+			memcpy (layer->name, data + 16, len);
+			layer->name[len] = 0;
+			break;
+
+		case ID4('P','N','T','S'): {
+			if (layer->point)
+				return (false);
+			layer->num_points = size / 12;
+			layer->point = (float *) malloc ((layer->num_points + 1) * 3 * sizeof(float));
+			layer->point_uv = (float *) calloc (layer->num_points + 1, 2 * sizeof(float));
+			layer->has_uv = (bool *) calloc (layer->num_points + 1, sizeof(bool));
+			if (layer->point == 0 OR layer->point_uv == 0 OR layer->has_uv == 0)
+				return (false);
+			for (int i = 0; i < layer->num_points * 3; i++)
+				layer->point[i] = F4(data + i * 4);
+			break;
+		}
+
+		case ID4('V','M','A','P'):
+		case ID4('V','M','A','D'): {
+			if (size < 8 OR U4(data) != ID4('T','X','U','V') OR U2(data + 4) != 2)
+				break;
+			const char *name = (const char *)data + 6;
+			len = strnlen (name, size - 6);
+			if (object->uv_map[0] == 0)
+				strncpy (object->uv_map, name, sizeof(object->uv_map) - 1);
+			if (strncmp (name, object->uv_map, sizeof(object->uv_map) - 1) != 0)
+				break;
+			p = data + 6 + len + 1 + ((len + 1) & 1);
+			if (id == ID4('V','M','A','P')) {
+				while (p < end) {
+					int point = VX(&p, end);
+					if (point < 0 OR p + 8 > end OR point >= layer->num_points)
+						return (false);
+					layer->point_uv[point * 2] = F4(p);
+					layer->point_uv[point * 2 + 1] = F4(p + 4);
+					layer->has_uv[point] = true;
+					p += 8;
+				}
+			}
+			else {
+				int count = layer->num_poly_uvs;
+				layer->poly_uv = (Poly_UV *) realloc (layer->poly_uv, (count + size / 10 + 1) * sizeof(Poly_UV));
+				if (layer->poly_uv == 0)
+					return (false);
+				while (p < end) {
+					Poly_UV *uv = &layer->poly_uv[count];
+					uv->point = VX(&p, end);
+					uv->poly = VX(&p, end);
+					if (uv->point < 0 OR uv->poly < 0 OR p + 8 > end)
+						return (false);
+					uv->u = F4(p);
+					uv->v = F4(p + 4);
+					p += 8;
+					count++;
+				}
+				layer->num_poly_uvs = count;
+			}
+			break;
+		}
+
+		case ID4('P','O','L','S'): {
+			// Only faces (not patches or bones) are drawn
+			if (size < 4 OR U4(data) != ID4('F','A','C','E'))
+				break;
+			if (layer->poly_start)
+				return (false);
+			layer->poly_start = (int *) malloc ((size / 2 + 1) * sizeof(int));
+			layer->poly_size = (int *) malloc ((size / 2 + 1) * sizeof(int));
+			layer->corner = (int *) malloc ((size / 2 + 1) * sizeof(int));
+			if (layer->poly_start == 0 OR layer->poly_size == 0 OR layer->corner == 0)
+				return (false);
+			p = data + 4;
+			while (p + 2 <= end) {
+				int n = U2(p) & 0x3FF;
+				p += 2;
+				layer->poly_start[layer->num_polys] = layer->num_corners;
+				layer->poly_size[layer->num_polys++] = n;
+				for (int i = 0; i < n; i++) {
+					int point = VX(&p, end);
+					if (point < 0 OR point >= layer->num_points)
+						return (false);
+					layer->corner[layer->num_corners++] = point;
+				}
+			}
+			break;
+		}
+	}
+
+	return (true);
+}
+
+/*____________________________________________________________________
+|
+| Function: Build_Mesh
+|
+| Input: Called from Cook
+| Output: Finds the range of the texture coordinates and builds every
+|   layer in polygon order.  Returns false on error.
+|___________________________________________________________________*/
+
+static bool Build_Mesh (LWO_Object *object)
+{
+	float uv_max[2] = { 0, 0 };
+	bool first = true;
+
+	for (int i = 0; i < object->num_layers; i++) {
+		LWO_Layer *layer = &object->layer[i];
+		for (int k = 0; k < layer->num_points + layer->num_poly_uvs; k++) {
+			float uv[2];
+			if (k < layer->num_points) {
+				if (NOT layer->has_uv[k])
+					continue;
+				uv[0] = layer->point_uv[k * 2];
+				uv[1] = layer->point_uv[k * 2 + 1];
+			}
+			else {
+				uv[0] = layer->poly_uv[k - layer->num_points].u;
+				uv[1] = layer->poly_uv[k - layer->num_points].v;
+			}
+			for (int c = 0; c < 2; c++) {
+				if (first OR uv[c] < object->uv_min[c])
+					object->uv_min[c] = uv[c];
+				if (first OR uv[c] > uv_max[c])
+					uv_max[c] = uv[c];
+			}
+			first = false;
+		}
+	}
+	for (int c = 0; c < 2; c++)
+		object->uv_scale[c] = uv_max[c] > object->uv_min[c] ? uv_max[c] - object->uv_min[c] : 1;
+
+	for (int i = 0; i < object->num_layers; i++)
+		if (NOT Cook_Layer (object, &object->layer[i], &object->built[i], false))
+			return (false);
+
+	return (true);
+}
+
+/*____________________________________________________________________
+|
+| Function: Compare_Poly_UVs
+|
+| Input: Called from Cook_Layer (through qsort)
+| Output: Orders polygon texture coordinates by polygon, then point.
+|___________________________________________________________________*/
+
+static int Compare_Poly_UVs (const void *a, const void *b)
+{
+	const Poly_UV *p = (const Poly_UV *)a, *q = (const Poly_UV *)b;
+
+	if (p->poly != q->poly)
+		return (p->poly < q->poly ? -1 : 1);
+	return (p->point < q->point ? -1 : p->point > q->point);
+}
+
+/*____________________________________________________________________
+|
+| Function: Cook_Layer
+|
+| Input: Called from Build_Mesh, Cook
+| Output: Builds the indexed triangle list of a layer: splits polygons
+|   into triangles, smooths normals, quantizes, merges and (if optimize)
+|   reorders for the cache.  Returns false on error.
+|___________________________________________________________________*/
+
+static bool Cook_Layer (LWO_Object *object, LWO_Layer *layer, Built_Layer *built, bool optimize)
+{
+	float smooth_cos = cosf (COOK_SMOOTH_ANGLE * 3.14159265f / 180);
+	int num_tris = 0;
+
+	memset (built, 0, sizeof(Built_Layer));
+	for (int p = 0; p < layer->num_polys; p++)
+		if (layer->poly_size[p] >= 3)
+			num_tris += layer->poly_size[p] - 2;
+	if (num_tris == 0)
+		return (true);
+
+	qsort (layer->poly_uv, layer->num_poly_uvs, sizeof(Poly_UV), Compare_Poly_UVs);
+
+	// Face normals (the cross product of the first and last edges)
+	float *face = (float *) malloc (layer->num_polys * 3 * sizeof(float));
+	// Faces around each point
+	int *point_start = (int *) calloc (layer->num_points + 1, sizeof(int));
+	int *point_face = (int *) malloc ((layer->num_corners + 1) * sizeof(int));
+	Mesh_Vertex *corner = (Mesh_Vertex *) malloc (num_tris * 3 * sizeof(Mesh_Vertex));
+	built->vertex = (Mesh_Vertex *) malloc (num_tris * 3 * sizeof(Mesh_Vertex));
+	built->index = (unsigned short *) malloc (num_tris * 3 * sizeof(unsigned short));
+	bool ok = face AND point_start AND point_face AND corner AND built->vertex AND built->index;
+
+	for (int p = 0; ok AND p < layer->num_polys; p++) {
+		const int *c = &layer->corner[layer->poly_start[p]];
+		float *n = &face[p * 3];
+		n[0] = n[1] = n[2] = 0;
+		if (layer->poly_size[p] < 3)
+			continue;
+		const float *p0 = &layer->point[c[0] * 3], *p1 = &layer->point[c[1] * 3], *pn = &layer->point[c[layer->poly_size[p] - 1] * 3];
+		float a[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+		float b[3] = { pn[0] - p0[0], pn[1] - p0[1], pn[2] - p0[2] };
+		n[0] = a[1] * b[2] - a[2] * b[1];
+		n[1] = a[2] * b[0] - a[0] * b[2];
+		n[2] = a[0] * b[1] - a[1] * b[0];
+		float len = sqrtf (n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+		if (len > 0) {
+			n[0] /= len;
+			n[1] /= len;
+			n[2] /= len;
+		}
+	}
+	for (int k = 0; ok AND k < layer->num_corners; k++)
+		point_start[layer->corner[k] + 1]++;
+	for (int i = 0; ok AND i < layer->num_points; i++)
+		point_start[i + 1] += point_start[i];
+	for (int p = 0; ok AND p < layer->num_polys; p++)
+		for (int k = 0; k < layer->poly_size[p]; k++) {
+			int point = layer->corner[layer->poly_start[p] + k];
+			point_face[point_start[point]++] = p;
+		}
+	for (int i = layer->num_points; ok AND i > 0; i--)
+		point_start[i] = point_start[i - 1];
+	if (ok)
+		point_start[0] = 0;
+
+	// Fan every polygon into triangles
+	int num_corners = 0;
+	for (int p = 0; ok AND p < layer->num_polys; p++) {
+		int size = layer->poly_size[p];
+		for (int t = 1; t + 1 < size; t++) {
+			int k[3] = { 0, t, t + 1 };
+			for (int j = 0; j < 3; j++) {
+				int point = layer->corner[layer->poly_start[p] + k[j]];
+				const float *fn = &face[p * 3];
+				Mesh_Vertex *v = &corner[num_corners++];
+				memset (v, 0, sizeof(Mesh_Vertex));
+				v->x = layer->point[point * 3];
+				v->y = layer->point[point * 3 + 1];
+				v->z = layer->point[point * 3 + 2];
+
+				// Smooth with the faces around the point that are close enough
+				float n[3] = { 0, 0, 0 };
+				for (int f = point_start[point]; f < point_start[point + 1]; f++) {
+					const float *other = &face[point_face[f] * 3];
+					if (other[0] * fn[0] + other[1] * fn[1] + other[2] * fn[2] >= smooth_cos OR point_face[f] == p) {
+						n[0] += other[0];
+						n[1] += other[1];
+						n[2] += other[2];
+					}
+				}
+				float len = sqrtf (n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+				if (len > 0) {
+					v->nx = (signed char)lrintf (n[0] / len * 127);
+					v->ny = (signed char)lrintf (n[1] / len * 127);
+					v->nz = (signed char)lrintf (n[2] / len * 127);
+				}
+
+				// Per polygon texture coordinates override the per point ones
+				float uv[2] = { layer->point_uv[point * 2], layer->point_uv[point * 2 + 1] };
+				Poly_UV key = { p, point, 0, 0 };
+				Poly_UV *found = (Poly_UV *) bsearch (&key, layer->poly_uv, layer->num_poly_uvs, sizeof(Poly_UV), Compare_Poly_UVs);
+				if (found) {
+					uv[0] = found->u;
+					uv[1] = found->v;
+				}
+				v->u = Quantize_UV (uv[0], object->uv_min[0], object->uv_scale[0]);
+				v->v = Quantize_UV (uv[1], object->uv_min[1], object->uv_scale[1]);
+			}
+		}
+	}
+
+	if (ok) {
+		built->num_indices = num_corners;
+		built->num_vertices = Weld (corner, num_corners, built->vertex, built->index);
+		if (built->num_vertices == 0 OR built->num_vertices > 65535) {
+			printf ("layer %s: more than 65535 vertices\n", layer->name);
+			ok = false;
+		}
+	}
+	if (ok) {
+		built->acmr_before = ACMR (built->index, built->num_indices, built->num_vertices, MESH_CACHE_SIZE);
+		if (optimize) {
+			Optimize_Cache (built->index, built->num_indices, built->num_vertices);
+
+			// Vertices in the order the triangles first use them
+			int *remap = (int *) malloc (built->num_vertices * sizeof(int));
+			ok = remap != 0;
+			for (int i = 0; ok AND i < built->num_vertices; i++)
+				remap[i] = -1;
+			int next = 0;
+			for (int i = 0; ok AND i < built->num_indices; i++) {
+				int v = built->index[i];
+				if (remap[v] < 0) {
+					remap[v] = next;
+					corner[next++] = built->vertex[v];
+				}
+				built->index[i] = (unsigned short)remap[v];
+			}
+			if (ok)
+				memcpy (built->vertex, corner, built->num_vertices * sizeof(Mesh_Vertex));
+			free (remap);
+		}
+		built->acmr_after = ACMR (built->index, built->num_indices, built->num_vertices, MESH_CACHE_SIZE);
+	}
+
+	free (face);
+	free (point_start);
+	free (point_face);
+	free (corner);
+
+	return (ok);
+}
+
+/*____________________________________________________________________
+|
+| Function: Quantize_UV
+|
+| Input: Called from Cook_Layer
+| Output: Returns a texture coordinate as a fraction of the range of
+|   the object, in 16 bits.  Corners without one get the nearest end.
+|___________________________________________________________________*/
+
+static unsigned short Quantize_UV (float uv, float uv_min, float uv_scale)
+{
+	long q = lrintf ((uv - uv_min) / uv_scale * 65535);
+
+	if (q < 0)
+		q = 0;
+	if (q > 65535)
+		q = 65535;
+
+	return ((unsigned short)q);
+}
+
+/*____________________________________________________________________
+|
+| Function: Weld
+|
+| Input: Called from Cook_Layer
+| Output: Merges the corners that are the same, bit for bit, into
+|   vertex and writes the index of each corner.  Returns the number of
+|   vertices.
+|___________________________________________________________________*/
+
+static int Weld (Mesh_Vertex *corner, int num_corners, Mesh_Vertex *vertex, unsigned short *index)
+{
+	int table_size = 1;
+	int num_vertices = 0;
+
+	while (table_size < num_corners * 2)
+		table_size <<= 1;
+	int *table = (int *) malloc (table_size * sizeof(int));
+	if (table == 0)
+		return (0);
+	for (int i = 0; i < table_size; i++)
+		table[i] = -1;
+
+	for (int i = 0; i < num_corners; i++) {
+		// FNV-1a over the bytes of the vertex
+		const unsigned char *bytes = (const unsigned char *)&corner[i];
+		unsigned hash = 2166136261u;
+		for (unsigned b = 0; b < sizeof(Mesh_Vertex); b++)
+			hash = (hash ^ bytes[b]) * 16777619u;
+
+		int slot = hash & (table_size - 1);
+		while (table[slot] >= 0 AND memcmp (&vertex[table[slot]], &corner[i], sizeof(Mesh_Vertex)) != 0)
+			slot = (slot + 1) & (table_size - 1);
+		if (table[slot] < 0) {
+			table[slot] = num_vertices;
+			vertex[num_vertices++] = corner[i];
+		}
+		index[i] = (unsigned short)table[slot];
+	}
+	free (table);
+
+	return (num_vertices);
+}
+
+/*____________________________________________________________________
+|
+| Function: Optimize_Cache
+|
+| Input: Called from Cook_Layer
+| Output: Reorders the triangles of an indexed list for the post
+|   transform cache.  Each vertex is scored by its place in a simulated
+|   LRU cache and by how many triangles still use it, and the triangle
+|   with the best score goes next.  Only the triangles of the vertices
+|   that moved in the cache are rescored, and the whole list is only
+|   searched when none of them is left.
+|___________________________________________________________________*/
+
+static void Optimize_Cache (unsigned short *index, int num_indices, int num_vertices)
+{
+	int num_tris = num_indices / 3;
+	int *valence = (int *) calloc (num_vertices + 1, sizeof(int));	// triangles not drawn yet
+	int *tri_start = (int *) calloc (num_vertices + 1, sizeof(int));
+	int *tri_list = (int *) malloc ((num_indices + 1) * sizeof(int));
+	int *cache_position = (int *) malloc ((num_vertices + 1) * sizeof(int));
+	float *vertex_score = (float *) malloc ((num_vertices + 1) * sizeof(float));
+	float *tri_score = (float *) malloc ((num_tris + 1) * sizeof(float));
+	bool *drawn = (bool *) calloc (num_tris + 1, sizeof(bool));
+	unsigned short *out = (unsigned short *) malloc ((num_indices + 1) * sizeof(unsigned short));
+	int cache[FORSYTH_CACHE_SIZE + 3], new_cache[FORSYTH_CACHE_SIZE + 3];
+	int cache_count = 0;
+
+	if (valence AND tri_start AND tri_list AND cache_position AND vertex_score AND tri_score AND drawn AND out) {
+		// Triangles of each vertex
+		for (int i = 0; i < num_indices; i++)
+			valence[index[i]]++;
+		for (int v = 0; v < num_vertices; v++)
+			tri_start[v + 1] = tri_start[v] + valence[v];
+		for (int v = 0; v < num_vertices; v++)
+			valence[v] = 0;
+		for (int i = 0; i < num_indices; i++) {
+			int v = index[i];
+			tri_list[tri_start[v] + valence[v]++] = i / 3;
+		}
+
+		for (int v = 0; v < num_vertices; v++) {
+			cache_position[v] = -1;
+			vertex_score[v] = Vertex_Score (-1, valence[v]);
+		}
+		for (int t = 0; t < num_tris; t++)
+			tri_score[t] = vertex_score[index[t * 3]] + vertex_score[index[t * 3 + 1]] + vertex_score[index[t * 3 + 2]];
+
+		int best = -1, scan = 0;
+		for (int n = 0; n < num_tris; n++) {
+			// Nothing scored from the cache, so take the best triangle left
+			if (best < 0) {
+				while (drawn[scan])
+					scan++;
+				best = scan;
+				for (int t = scan + 1; t < num_tris; t++)
+					if (NOT drawn[t] AND tri_score[t] > tri_score[best])
+						best = t;
+			}
+
+			// Draw it and take it off its vertices
+			drawn[best] = true;
+			for (int j = 0; j < 3; j++) {
+				int v = index[best * 3 + j];
+				out[n * 3 + j] = (unsigned short)v;
+				int *list = &tri_list[tri_start[v]];
+				for (int k = 0; k < valence[v]; k++)
+					if (list[k] == best) {
+						list[k] = list[--valence[v]];
+						break;
+					}
+			}
+
+			// Its vertices go to the front of the cache
+			int new_count = 0;
+			for (int j = 0; j < 3; j++) {
+				int v = index[best * 3 + j];
+				bool dup = false;
+				for (int k = 0; k < new_count; k++)
+					dup = dup OR new_cache[k] == v;
+				if (NOT dup)
+					new_cache[new_count++] = v;
+			}
+			for (int k = 0; k < cache_count; k++) {
+				int v = cache[k];
+				if (v != index[best * 3] AND v != index[best * 3 + 1] AND v != index[best * 3 + 2])
+					new_cache[new_count++] = v;
+			}
+
+			// Rescore the vertices that moved and the triangles they are in
+			for (int k = 0; k < new_count; k++) {
+				int v = new_cache[k];
+				cache_position[v] = k < FORSYTH_CACHE_SIZE ? k : -1;
+				vertex_score[v] = Vertex_Score (cache_position[v], valence[v]);
+			}
+			best = -1;
+			float best_score = -1;
+			for (int k = 0; k < new_count; k++) {
+				int v = new_cache[k];
+				for (int i = 0; i < valence[v]; i++) {
+					int t = tri_list[tri_start[v] + i];
+					tri_score[t] = vertex_score[index[t * 3]] + vertex_score[index[t * 3 + 1]] + vertex_score[index[t * 3 + 2]];
+					if (tri_score[t] > best_score) {
+						best_score = tri_score[t];
+						best = t;
+					}
+				}
+			}
+			cache_count = new_count < FORSYTH_CACHE_SIZE ? new_count : FORSYTH_CACHE_SIZE;
+			memcpy (cache, new_cache, cache_count * sizeof(int));
+		}
+		memcpy (index, out, num_indices * sizeof(unsigned short));
+	}
+
+	free (valence);
+	free (tri_start);
+	free (tri_list);
+	free (cache_position);
+	free (vertex_score);
+	free (tri_score);
+	free (drawn);
+	free (out);
+}
+
+/*____________________________________________________________________
+|
+| Function: Vertex_Score
+|
+| Input: Called from Optimize_Cache
+| Output: Returns the score of a vertex at a cache position (-1 if it
+|   is not in the cache) used by valence triangles not drawn yet.
+|___________________________________________________________________*/
+
+static float Vertex_Score (int cache_position, int valence)
+{
+	float score = 0;
+
+	if (valence == 0)
+		return (-1);
+
+	// The last triangle's vertices score the same, so the next triangle
+	// doesn't just follow the strip
+	if (cache_position >= 0) {
+		if (cache_position < 3)
+			score = FORSYTH_LAST_TRI_SCORE;
+		else
+			score = powf (1 - (float)(cache_position - 3) / (FORSYTH_CACHE_SIZE - 3), FORSYTH_CACHE_DECAY);
+	}
+
+	// Vertices with few triangles left go first, so they leave the cache done
+	return (score + FORSYTH_VALENCE_SCALE * powf ((float)valence, -FORSYTH_VALENCE_POWER));
+}
+
+/*____________________________________________________________________
+|
+| Function: Write_Mesh
+|
+| Input: Called from Cook
+| Output: Writes a cooked mesh file.  Returns false on error.
+|___________________________________________________________________*/
+
+static bool Write_Mesh (char *filename, LWO_Object *object)
+{
+	Mesh_Header header;
+	Mesh_Layer layer[MAX_COOK_LAYERS];
+
+	memset (&header, 0, sizeof(header));
+	memset (layer, 0, sizeof(layer));
+	header.magic = MESH_MAGIC;
+	header.version = MESH_VERSION;
+	header.num_layers = object->num_layers;
+	for (int c = 0; c < 2; c++) {
+		header.uv_min[c] = object->uv_min[c];
+		header.uv_scale[c] = object->uv_scale[c];
+	}
+	for (int i = 0; i < object->num_layers; i++) {
+		memcpy (layer[i].name, object->layer[i].name, MESH_NAME_SIZE);
+		memcpy (layer[i].pivot, object->layer[i].pivot, sizeof(layer[i].pivot));
+		layer[i].first_vertex = header.num_vertices;
+		layer[i].num_vertices = object->built[i].num_vertices;
+		layer[i].first_index = header.num_indices;
+		layer[i].num_indices = object->built[i].num_indices;
+		header.num_vertices += layer[i].num_vertices;
+		header.num_indices += layer[i].num_indices;
+	}
+
+	FILE *fp = fopen (filename, "wb");
+	if (fp == 0) {
+		printf ("can't create %s\n", filename);
+		return (false);
+	}
+	bool ok = fwrite (&header, sizeof(header), 1, fp) == 1 AND
+		fwrite (layer, sizeof(Mesh_Layer), object->num_layers, fp) == (size_t)object->num_layers;
+	for (int i = 0; i < object->num_layers AND ok; i++)
+		ok = fwrite (object->built[i].vertex, sizeof(Mesh_Vertex), object->built[i].num_vertices, fp) == (size_t)object->built[i].num_vertices;
+	for (int i = 0; i < object->num_layers AND ok; i++)
+		ok = fwrite (object->built[i].index, sizeof(unsigned short), object->built[i].num_indices, fp) == (size_t)object->built[i].num_indices;
+	if (fclose (fp) != 0)
+		ok = false;
+	if (NOT ok)
+		printf ("can't write %s\n", filename);
+
+	return (ok);
+}
+
+/*____________________________________________________________________
+|
+| Function: Report_Mesh
+|
+| Input: Called from Cook
+| Output: Loads the cooked mesh back, checks it against what was cooked
+|   and prints its sizes, load times and cache misses per triangle.
+|___________________________________________________________________*/
+
+static void Report_Mesh (char *lwo_filename, char *filename, LWO_Object *object, double build_time)
+{
+	Cooked_Mesh mesh;
+	int num_tris = 0, num_vertices = 0;
+	float misses_before = 0, misses_after = 0;
+
+	double start = Seconds();
+	bool ok = true;
+	for (int r = 0; r < COOK_LOAD_REPEATS AND ok; r++) {
+		ok = Load_Mesh (filename, &mesh);
+		if (ok AND r + 1 < COOK_LOAD_REPEATS)
+			free (mesh.buffer);
+	}
+	double load_time = (Seconds() - start) / COOK_LOAD_REPEATS;
+	if (NOT ok) {
+		printf ("%s: can't load it back\n", filename);
+		return;
+	}
+
+	for (int i = 0; i < object->num_layers; i++) {
+		Built_Layer *b = &object->built[i];
+		const Mesh_Layer *l = &mesh.layer[i];
+		if (l->num_vertices != (unsigned)b->num_vertices OR l->num_indices != (unsigned)b->num_indices OR
+			memcmp (&mesh.vertex[l->first_vertex], b->vertex, b->num_vertices * sizeof(Mesh_Vertex)) != 0 OR
+			memcmp (&mesh.index[l->first_index], b->index, b->num_indices * sizeof(unsigned short)) != 0)
+			ok = false;
+		num_tris += b->num_indices / 3;
+		num_vertices += b->num_vertices;
+		misses_before += b->acmr_before * (b->num_indices / 3);
+		misses_after += b->acmr_after * (b->num_indices / 3);
+	}
+	free (mesh.buffer);
+	if (NOT ok) {
+		printf ("%s: does not load back as cooked\n", filename);
+		return;
+	}
+
+	if (num_tris)
+		printf ("%-36s %6d %6d %8.2f %9.3f %10.3f %10.3f\n", lwo_filename, num_tris, num_vertices,
+			build_time * 1000, load_time * 1000, misses_before / num_tris, misses_after / num_tris);
+	else
+		printf ("%-36s %6d %6d %8.2f %9.3f %10s %10s\n", lwo_filename, 0, 0, build_time * 1000, load_time * 1000, "-", "-");
+}
+
+/*____________________________________________________________________
+|
+| Function: Load_Mesh
+|
+| Input: Called from Report_Mesh
+| Output: Reads a cooked mesh file in one read and points mesh into it,
+|   after checking that the parts the header announces lie inside the
+|   file and that every index stays in its layer.  Returns true on
+|   success.
+|___________________________________________________________________*/
+
+static bool Load_Mesh (char *filename, Cooked_Mesh *mesh)
+{
+	memset (mesh, 0, sizeof(Cooked_Mesh));
+
+	FILE *fp = fopen (filename, "rb");
+	if (fp == 0)
+		return (false);
+	fseek (fp, 0, SEEK_END);
+	long size = ftell (fp);
+	fseek (fp, 0, SEEK_SET);
+
+	unsigned char *bytes = size > 0 ? (unsigned char *) malloc (size) : 0;
+	bool ok = bytes AND fread (bytes, 1, size, fp) == (size_t)size;
+	fclose (fp);
+
+	const Mesh_Header *header = (const Mesh_Header *)bytes;
+	ok = ok AND (size_t)size >= sizeof(Mesh_Header) AND header->magic == MESH_MAGIC AND header->version == MESH_VERSION;
+	if (NOT ok) {
+		free (bytes);
+		return (false);
+	}
+
+	unsigned long long layers_size = (unsigned long long)header->num_layers * sizeof(Mesh_Layer);
+	unsigned long long vertices_size = (unsigned long long)header->num_vertices * sizeof(Mesh_Vertex);
+	unsigned long long indices_size = (unsigned long long)header->num_indices * sizeof(unsigned short);
+	if (sizeof(Mesh_Header) + layers_size + vertices_size + indices_size > (unsigned long long)size) {
+		free (bytes);
+		return (false);
+	}
+
+	const Mesh_Layer *layer = (const Mesh_Layer *)(bytes + sizeof(Mesh_Header));
+	const Mesh_Vertex *vertex = (const Mesh_Vertex *)((const unsigned char *)layer + layers_size);
+	const unsigned short *index = (const unsigned short *)((const unsigned char *)vertex + vertices_size);
+
+	// Every layer's indices must stay inside its own vertices
+	for (unsigned i = 0; i < header->num_layers AND ok; i++) {
+		const Mesh_Layer *l = &layer[i];
+		if (l->first_vertex > header->num_vertices OR l->num_vertices > header->num_vertices - l->first_vertex OR
+			l->first_index > header->num_indices OR l->num_indices > header->num_indices - l->first_index OR
+			l->num_indices % 3 != 0)
+			ok = false;
+		for (unsigned k = 0; k < l->num_indices AND ok; k++)
+			if (index[l->first_index + k] >= l->num_vertices)
+				ok = false;
+	}
+	if (NOT ok) {
+		free (bytes);
+		return (false);
+	}
+
+	mesh->header = header;
+	mesh->layer = layer;
+	mesh->vertex = vertex;
+	mesh->index = index;
+	mesh->buffer = bytes;
+
+	return (true);
+}
+
+/*____________________________________________________________________
+|
+| Function: ACMR
+|
+| Input: Called from Cook_Layer
+| Output: Returns the average post-transform cache misses per triangle
+|   of an indexed triangle list, for a FIFO cache of cache_size entries.
+|___________________________________________________________________*/
+
+static float ACMR (const unsigned short *index, int num_indices, int num_vertices, int cache_size)
+{
+	int *cached_at = (int *) malloc ((num_vertices > 0 ? num_vertices : 1) * sizeof(int));
+	int misses = 0;
+
+	if (num_indices < 3 OR cached_at == 0) {
+		free (cached_at);
+		return (0);
+	}
+
+	// A vertex is in the cache while fewer than cache_size misses came after its own
+	for (int i = 0; i < num_vertices; i++)
+		cached_at[i] = -cache_size - 1;
+	for (int i = 0; i < num_indices; i++) {
+		int v = index[i];
+		if (misses - cached_at[v] > cache_size) {
+			cached_at[v] = misses;
+			misses++;
+		}
+	}
+	free (cached_at);
+
+	return ((float)misses / (num_indices / 3));
+}
+
+/*____________________________________________________________________
+|
+| Function: Free_Object
+|
+| Input: Called from Cook
+| Output: Frees a LightWave object and what was built from it.
+|___________________________________________________________________*/
+
+static void Free_Object (LWO_Object *object)
+{
+	for (int i = 0; i < MAX_COOK_LAYERS; i++) {
+		LWO_Layer *layer = &object->layer[i];
+		free (layer->point);
+		free (layer->point_uv);
+		free (layer->has_uv);
+		free (layer->poly_start);
+		free (layer->poly_size);
+		free (layer->corner);
+		free (layer->poly_uv);
+		free (object->built[i].vertex);
+		free (object->built[i].index);
+	}
+	free (object);
+}
+
+/*____________________________________________________________________
+|
+| Function: U2
+|
+| Input: Called from Read_Layer_Chunk, VX
+| Output: Returns a big endian 16 bit value.
+|___________________________________________________________________*/
+
+static unsigned U2 (const unsigned char *p)
+{
+	return ((unsigned)p[0] << 8 | p[1]);
+}
+
+/*____________________________________________________________________
+|
+| Function: U4
+|
+| Input: Called from Read_LWO, Read_Layer_Chunk, F4, VX
+| Output: Returns a big endian 32 bit value.
+|___________________________________________________________________*/
+
+static unsigned U4 (const unsigned char *p)
+{
+	return ((unsigned)p[0] << 24 | (unsigned)p[1] << 16 | (unsigned)p[2] << 8 | p[3]);
+}
+
+/*____________________________________________________________________
+|
+| Function: F4
+|
+| Input: Called from Read_Layer_Chunk
+| Output: Returns a big endian float.
+|___________________________________________________________________*/
+
+static float F4 (const unsigned char *p)
+{
+	unsigned u = U4(p);
+	float f;
+
+	memcpy (&f, &u, sizeof(f));
+	return (f);
+}
+
+/*____________________________________________________________________
+|
+| Function: VX
+|
+| Input: Called from Read_Layer_Chunk
+| Output: Returns a variable length index (2 bytes, or 4 starting with
+|   0xFF) and moves past it.  Returns -1 if it runs past end.
+|___________________________________________________________________*/
+
+static int VX (const unsigned char **p, const unsigned char *end)
+{
+	int i;
+
+	if (*p + 2 > end OR ((*p)[0] == 0xFF AND *p + 4 > end))
+		return (-1);
+	if ((*p)[0] == 0xFF) {
+		i = (int)(U4(*p) & 0xFFFFFF);
+		*p += 4;
+	}
+	else {
+		i = (int)U2(*p);
+		*p += 2;
+	}
+
+	return (i);
+}
+
+/*____________________________________________________________________
+|
+| Function: Seconds
+|
+| Input: Called from Cook, Report_Mesh
+| Output: Returns a monotonic time in seconds.
+|___________________________________________________________________*/
+
+static double Seconds ()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -25,6 +25,7 @@
 
 #include "dp.h"
 
+#include "sim.h"
 #include "position.h"
 #include "render.h"
 
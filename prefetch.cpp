@@ -0,0 +1,204 @@
+/*____________________________________________________________________
+|
+| File: prefetch.cpp
+|
+| Description: Asset prefetching.  gx3d creates objects and textures
+|   on the render thread only, and decodes them there from the files,
+|   so the work is split in two:
+|   - The reader threads (readahead.cpp) read every file of the list
+|     once, a file per thread at a time, so that the loads that follow
+|     come from memory (the system file cache) instead of the disk.
+|   - Prefetch_Step, on the render thread, creates the objects and
+|     textures whose files are all read through the asset cache, in
+|     list order, and drops its reference right away, so they stay
+|     loaded unused until the next screen asks for them.
+|   Files read ahead are only worth something if the next screen loads
+|   them, so a list that goes stale is just dropped.
+|
+| Functions: Prefetch_Start
+|            Prefetch_Step
+|            Prefetch_Stop
+|            Prefetch_Report
+|             Asset_Read
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <first_header.h>
+#include "dp.h"
+
+#include <chrono>
+#include <stdio.h>
+
+#include "assets.h"
+#include "readahead.h"
+#include "prefetch.h"
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define MAX_PREFETCH_ASSETS		(MAX_READ_AHEAD_FILES / 2) // a texture has up to two files
+
+/*___________________
+|
+| Function prototypes
+|__________________*/
+
+static bool Asset_Read (int i, bool *found);
+
+/*___________________
+|
+| Global variables
+|__________________*/
+
+static const Prefetch_Asset *list;
+static int list_count;
+
+// Files of the list, as given to the reader threads
+static char *files[MAX_READ_AHEAD_FILES];
+static int first_file[MAX_PREFETCH_ASSETS];	// first file of each asset
+static int num_files[MAX_PREFETCH_ASSETS];
+static int files_count;
+
+static int num_created;					// assets of the list looked at by Prefetch_Step
+static int assets_created;				// created in the asset cache
+
+/*____________________________________________________________________
+|
+| Function: Prefetch_Start
+|
+| Input: Called from Render_TitleScreen, Init_GameScreen
+| Output: Starts reading the files of a list of assets in the
+|   background.
+|___________________________________________________________________*/
+
+void Prefetch_Start (const Prefetch_Asset *assets, int count)
+{
+	Prefetch_Stop ();
+
+	list = assets;
+	list_count = count < MAX_PREFETCH_ASSETS ? count : MAX_PREFETCH_ASSETS;
+	num_created = 0;
+	assets_created = 0;
+
+	files_count = 0;
+	for (int i = 0; i < list_count; i++) {
+		first_file[i] = files_count;
+		files[files_count++] = assets[i].filename;
+		if (assets[i].type == PREFETCH_TEXTURE AND assets[i].alpha_filename)
+			files[files_count++] = assets[i].alpha_filename;
+		num_files[i] = files_count - first_file[i];
+	}
+
+	Read_Ahead_Start (files, files_count, 0);
+}
+
+/*____________________________________________________________________
+|
+| Function: Prefetch_Step
+|
+| Input: Called from Render_TitleScreen
+| Output: Creates, in the asset cache, the objects and textures of the
+|   list whose files were read, until budget milliseconds are used or
+|   the next asset is not read yet.
+|___________________________________________________________________*/
+
+void Prefetch_Step (float budget)
+{
+	auto start = std::chrono::steady_clock::now ();
+	bool found;
+
+	while (num_created < list_count AND Asset_Read (num_created, &found)) {
+		const Prefetch_Asset *a = &list[num_created];
+		if (found) {
+			if (a->type == PREFETCH_OBJECT) {
+				gx3dObject *object = Asset_Object (a->filename, a->vertex_format, a->flags, 0);
+				Asset_Release_Object (object);
+				assets_created++;
+			}
+			else if (a->type == PREFETCH_TEXTURE) {
+				gx3dTexture texture = Asset_Texture (a->filename, a->alpha_filename, a->flags);
+				Asset_Release_Texture (texture);
+				assets_created++;
+			}
+		}
+		num_created++;
+
+		std::chrono::duration<float, std::milli> used = std::chrono::steady_clock::now () - start;
+		if (used.count () >= budget)
+			break;
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Prefetch_Stop
+|
+| Input: Called from Prefetch_Start, Program_Run
+| Output: Stops the reader threads (after the reads they are doing)
+|   and drops the list.
+|___________________________________________________________________*/
+
+void Prefetch_Stop ()
+{
+	Read_Ahead_Stop ();
+
+	list = 0;
+	list_count = 0;
+	files_count = 0;
+	num_created = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Prefetch_Report
+|
+| Input: Called from Init_GameScreen, Init_GameOverScreen
+| Output: Writes to DEBUG.TXT how many files of the list were read and
+|   assets created ahead of the screen that needs them.
+|___________________________________________________________________*/
+
+void Prefetch_Report (char *screen)
+{
+	char str[200];
+
+	if (list == 0)
+		return;
+
+	sprintf (str, "%s: %d of %d files prefetched (%u KB read), %d of %d assets created ahead",
+		screen, Read_Ahead_Files_Read (), files_count, (unsigned)(Read_Ahead_Bytes_Read () / 1024), assets_created, list_count);
+	DEBUG_WRITE (str);
+}
+
+/*____________________________________________________________________
+|
+| Function: Asset_Read
+|
+| Input: Called from Prefetch_Step
+| Output: Returns true once every file of asset i of the list was read.
+|   Sets found to false if one of them could not be opened.
+|___________________________________________________________________*/
+
+static bool Asset_Read (int i, bool *found)
+{
+	*found = true;
+	for (int f = first_file[i]; f < first_file[i] + num_files[i]; f++) {
+		bool file_found;
+		if (NOT Read_Ahead_Done (f, &file_found))
+			return (false);
+		*found = *found AND file_found;
+	}
+
+	return (true);
+}
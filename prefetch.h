@@ -0,0 +1,40 @@
+/*____________________________________________________________________
+|
+| File: prefetch.h
+|
+| Description: Loads the assets of the next screen ahead of time.  A
+|   few reader threads read the files of a list of assets, and the screen
+|   showing meanwhile creates the ones that were read in the asset cache
+|   a little at a time, so the next screen finds them there.
+|   Include after dp.h.
+|___________________________________________________________________*/
+
+// Kinds of prefetched assets
+#define PREFETCH_OBJECT		0 // created in the asset cache
+#define PREFETCH_TEXTURE	1 // created in the asset cache
+#define PREFETCH_FILE		2 // only read ahead (sounds, motions, scripts)
+
+// An asset of the next screen, with the key it is loaded with
+struct Prefetch_Asset {
+	int type;
+	char *filename;
+	char *alpha_filename;				// textures (may be 0)
+	int vertex_format;					// objects
+	int flags;
+};
+
+// Starts reading the files of a list of assets on the reader threads,
+// dropping the list before it.  The list must stay valid until the
+// next call to Prefetch_Start or Prefetch_Stop.
+void Prefetch_Start (const Prefetch_Asset *assets, int count);
+
+// Creates the objects and textures of the list whose files were read,
+// for about budget milliseconds (at least one).  Call once a frame, on
+// the render thread, while the screen has time to spare.
+void Prefetch_Step (float budget);
+
+// Stops the reader threads and drops the list
+void Prefetch_Stop ();
+
+// Writes to DEBUG.TXT how much of the list was read and created ahead
+void Prefetch_Report (char *screen);
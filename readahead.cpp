@@ -0,0 +1,243 @@
+/*____________________________________________________________________
+|
+| File: readahead.cpp
+|
+| Description: Reading files ahead.  The reader threads take the files
+|   of the list in order from a shared atomic index, so several reads
+|   are in flight at once and the disk sees a deeper queue, while each
+|   file is read front to back in large chunks.  A file is marked done
+|   in its own atomic state, so whoever waits on the list can use each
+|   file as soon as it is in, whatever order the threads finish in.
+|
+| Functions: Read_Ahead_Start
+|            Read_Ahead_Done
+|            Read_Ahead_Files_Read
+|            Read_Ahead_Bytes_Read
+|            Read_Ahead_Wait
+|            Read_Ahead_Stop
+|             Reader_Run
+|             Read_File
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+#include "readahead.h"
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define READ_AHEAD_CHUNK		(1024 * 1024) // bytes read at a time
+
+// States of a file of the list
+#define FILE_PENDING			0
+#define FILE_FOUND				1
+#define FILE_MISSING			2
+
+/*___________________
+|
+| Function prototypes
+|__________________*/
+
+static void Reader_Run ();
+static bool Read_File (char *filename, char *buffer);
+
+/*___________________
+|
+| Global variables
+|__________________*/
+
+static std::thread readers[MAX_READ_AHEAD_THREADS];
+static int num_readers;
+static std::atomic<bool> stopping;
+
+// The list (set before the reader threads start, then only read)
+static char **list;
+static int list_count;
+
+// Written by the reader threads
+static std::atomic<int> next_file;		// next file of the list to take
+static std::atomic<char> state[MAX_READ_AHEAD_FILES];
+static std::atomic<int> files_read;
+static std::atomic<unsigned long long> bytes_read;
+
+/*____________________________________________________________________
+|
+| Function: Read_Ahead_Start
+|
+| Input: Called from Prefetch_Start, Load_Bench
+| Output: Starts reading a list of files in the background.
+|___________________________________________________________________*/
+
+void Read_Ahead_Start (char **filenames, int count, int threads)
+{
+	Read_Ahead_Stop ();
+
+	list = filenames;
+	list_count = count < MAX_READ_AHEAD_FILES ? count : MAX_READ_AHEAD_FILES;
+	for (int i = 0; i < list_count; i++)
+		state[i].store (FILE_PENDING);
+	next_file.store (0);
+	files_read.store (0);
+	bytes_read.store (0);
+
+	if (threads <= 0)
+		threads = (int)std::thread::hardware_concurrency ();
+	if (threads < 1)
+		threads = 1;
+	if (threads > MAX_READ_AHEAD_THREADS)
+		threads = MAX_READ_AHEAD_THREADS;
+	if (threads > list_count)
+		threads = list_count;
+
+	stopping.store (false);
+	for (num_readers = 0; num_readers < threads; num_readers++)
+		readers[num_readers] = std::thread (Reader_Run);
+}
+
+/*____________________________________________________________________
+|
+| Function: Read_Ahead_Done
+|
+| Input: Called from Asset_Read
+| Output: Returns true once file i was read, setting found.
+|___________________________________________________________________*/
+
+bool Read_Ahead_Done (int i, bool *found)
+{
+	if (i < 0 OR i >= list_count)
+		return (false);
+
+	char s = state[i].load (std::memory_order_acquire);
+	*found = (s == FILE_FOUND);
+
+	return (s != FILE_PENDING);
+}
+
+/*____________________________________________________________________
+|
+| Function: Read_Ahead_Files_Read
+|
+| Input: Called from Prefetch_Report, Load_Bench
+| Output: Returns the number of files of the list that were read.
+|___________________________________________________________________*/
+
+int Read_Ahead_Files_Read ()
+{
+	return (files_read.load ());
+}
+
+/*____________________________________________________________________
+|
+| Function: Read_Ahead_Bytes_Read
+|
+| Input: Called from Prefetch_Report, Load_Bench
+| Output: Returns the number of bytes read from the list.
+|___________________________________________________________________*/
+
+unsigned long long Read_Ahead_Bytes_Read ()
+{
+	return (bytes_read.load ());
+}
+
+/*____________________________________________________________________
+|
+| Function: Read_Ahead_Wait
+|
+| Input: Called from Load_Bench
+| Output: Returns when the reader threads are done with the list.
+|___________________________________________________________________*/
+
+void Read_Ahead_Wait ()
+{
+	for (int i = 0; i < num_readers; i++)
+		if (readers[i].joinable ())
+			readers[i].join ();
+	num_readers = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Read_Ahead_Stop
+|
+| Input: Called from Read_Ahead_Start, Prefetch_Stop, Load_Bench
+| Output: Stops the reader threads and drops the list.
+|___________________________________________________________________*/
+
+void Read_Ahead_Stop ()
+{
+	stopping.store (true);
+	Read_Ahead_Wait ();
+
+	list = 0;
+	list_count = 0;
+	files_read.store (0);
+}
+
+/*____________________________________________________________________
+|
+| Function: Reader_Run
+|
+| Input: Called from Read_Ahead_Start (on a reader thread)
+| Output: Reads the next file of the list nobody has taken, until the
+|   end of the list or until it is stopped.
+|___________________________________________________________________*/
+
+static void Reader_Run ()
+{
+	char *buffer = (char *) malloc (READ_AHEAD_CHUNK);
+	if (buffer == 0)
+		return;
+
+	for (;;) {
+		int i = next_file.fetch_add (1);
+		if (i >= list_count OR stopping.load ())
+			break;
+		bool found = Read_File (list[i], buffer);
+		state[i].store (found ? FILE_FOUND : FILE_MISSING, std::memory_order_release);
+		files_read.fetch_add (1);
+	}
+
+	free (buffer);
+}
+
+/*____________________________________________________________________
+|
+| Function: Read_File
+|
+| Input: Called from Reader_Run (on a reader thread)
+| Output: Reads a whole file, dropping what was read.  Returns false if
+|   the file could not be opened.
+|___________________________________________________________________*/
+
+static bool Read_File (char *filename, char *buffer)
+{
+	size_t n;
+
+	FILE *fp = fopen (filename, "rb");
+	if (fp == 0)
+		return (false);
+
+	// The reads are as large as the buffer, so skip the stdio buffer
+	setvbuf (fp, 0, _IONBF, 0);
+	while ((n = fread (buffer, 1, READ_AHEAD_CHUNK, fp)) > 0 AND NOT stopping.load ())
+		bytes_read.fetch_add (n);
+	fclose (fp);
+
+	return (true);
+}
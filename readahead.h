@@ -0,0 +1,35 @@
+/*____________________________________________________________________
+|
+| File: readahead.h
+|
+| Description: Reads a list of files ahead of time on a few reader
+|   threads, so that the loads that follow come from the system file
+|   cache instead of the disk.  Needs nothing from gx3d, so the load
+|   benchmark can time it on its own.
+|___________________________________________________________________*/
+
+#define MAX_READ_AHEAD_FILES	256
+#define MAX_READ_AHEAD_THREADS	8
+
+// Starts reading a list of files on threads reader threads (0 uses one
+// per hardware thread, up to MAX_READ_AHEAD_THREADS), dropping the list
+// before it.  The filenames must stay valid until the next call to
+// Read_Ahead_Start or Read_Ahead_Stop.
+void Read_Ahead_Start (char **filenames, int count, int threads);
+
+// Returns true once file i of the list was read.  Sets found to false
+// if it could not be opened.
+bool Read_Ahead_Done (int i, bool *found);
+
+// Returns the number of files of the list that were read
+int Read_Ahead_Files_Read ();
+
+// Returns the number of bytes read since Read_Ahead_Start
+unsigned long long Read_Ahead_Bytes_Read ();
+
+// Waits until every file of the list was read
+void Read_Ahead_Wait ();
+
+// Stops the reader threads (after the read each is doing) and drops
+// the list
+void Read_Ahead_Stop ();
@@ -15,8 +15,18 @@
 #include <first_header.h>
 #include "dp.h"
 
+#include "sim.h"
+#include "simthread.h"
 #include "render.h"
 #include "position.h"
+#include "drawlist.h"
+#include "glyphs.h"
+#include "renderstate.h"
+#include "cull.h"
+#include "lod.h"
+#include "transform.h"
+#include "assets.h"
+#include "prefetch.h"
 
 /*___________________
 |
@@ -27,36 +37,51 @@
 #define FULL_SCREEN_NEAR_PLANE  ((float)0.1)
 #define FULL_SCREEN_FAR_PLANE   ((float)100.0)
 #define FULL_SCREEN_FOV			((float)50.0)
+#define PREFETCH_FRAME_BUDGET	((float)4.0) // milliseconds a title screen frame spends creating game screen assets
 
 // Game Screen
 #define GAME_NEAR_PLANE         ((float)0.1)
 #define GAME_FAR_PLANE          ((float)5000.0)
 #define GAME_FOV				((float)80.0)
-#define MAX_STRUCTURE_COUNT		10
+#define GAME_DOME_FAR_PLANE		((float)3500.0) // far plane of everything inside the skydome
+#define GAME_FOG_START			((float)2000.0)
+#define GAME_FOG_END			((float)3000.0) // anything further is fully fogged
+#define MAX_CULL_BOUNDS			(MAX_PROJECTILE_COUNT + MAX_ENEMY_COUNT)
+#define HOSHU_IMPOSTOR_SIZE		((float)0.015) // projected size (fraction of the screen height) under which Hoshus are impostors
+#define STRUCTURE_IMPOSTOR_SIZE	((float)0.04)
+#define IMPOSTOR_ALPHA_TEST		100
 #define MAX_STRUCTURE_LIGHTS	5
-#define MAX_ENEMY_COUNT			100
-#define MAX_GAME_TIME			359999000 // 99 hrs 59 mins 59 secs all in milliseconds
 #define MAX_SCORE_FONTS			9
 #define MAX_HP_FONTS			4
 #define MAX_LV_FONTS			2
 #define MAX_TIME_FONTS			2
 #define MAX_DEFEATED_FONTS		6
-#define NORMAL_SPEED			((float) 100.0) // ((float)60.0) // feet per second
-#define RAIU_MAX_HP				1000
-#define HOSHU_MAX_HP			100
-#define HOSHU_MAX_LV			10
-#define HOSHU_SCORE				200
-#define HOSHU_EXP				100
-#define MAX_SCORE				999999999
-#define MAX_LV					10
-#define MAX_GROUND_LENGTH		((float)5000.0)
-#define MAX_PROJECTILE_DISTANCE 4000 // 4000 ft max projectile distance
-#define RAIU_MAX_LASER_COUNT	20
-#define HOSHU_MAX_LASER_COUNT	1
-#define FX_NORMAL_DURATION		1000 // 1 second
-#define STRUCTURE_SIDE_LEFT		-1
-#define STRUCTURE_SIDE_RIGHT	1
-#define STRUCTURE_SIDE_BOTH		0
+
+// HUD layout
+#define HUD_HP_SCALE			((float)0.25)
+#define HUD_HP_X				((float)-1.40)
+#define HUD_HP_Y				((float)-0.75)
+#define HUD_HP_FONT_SCALE		((float)0.04)
+#define HUD_LV_FONT_SCALE		((float)0.08)
+#define HUD_SCORE_FONT_SCALE	((float)0.08)
+
+// HUD parts to rebuild
+#define HUD_DIRTY_HP			1
+#define HUD_DIRTY_LV			2
+#define HUD_DIRTY_SCORE			4
+#define HUD_DIRTY_ALL			(HUD_DIRTY_HP | HUD_DIRTY_LV | HUD_DIRTY_SCORE)
+
+// Draw list materials (material, ambient light and specular lighting)
+#define DRAW_MATERIAL_SKY			0
+#define DRAW_MATERIAL_GROUND		1
+#define DRAW_MATERIAL_STRUCTURES	2
+#define DRAW_MATERIAL_FENCE			3
+#define DRAW_MATERIAL_RAIU			4
+#define DRAW_MATERIAL_HOSHU			5
+#define DRAW_MATERIAL_RED_LASER		6
+#define DRAW_MATERIAL_BLUE_LASER	7
+#define DRAW_MATERIAL_FX			8
+#define DRAW_MATERIAL_PARTICLES		9
 
 // Game Over Screen
 #define WINNING_SCORE			100000 // score needed to reach in order to win the game
@@ -66,6 +91,9 @@
 #define SCREENSHOT_FILENAME		"screenshots\\Omega Thunder-screenshot "
 #define SCREENSHOT_GAMEOVER		"screenshots\\Omega Thunder-game over "
 
+// Every layer lookup by name in this file goes through Find_Layer, so Report_Layer_Lookups counts all of them
+#define gx3d_GetObjectLayer(object,name)	Find_Layer(object, name)
+
 /*___________________
 |
 | Function prototypes
@@ -87,10 +115,27 @@ static void Init_GameScreen();
 bool Render_GameScreen(int *state);
 static void Free_GameScreen();
 static gx3dMotion *Load_Motion(gx3dMotionSkeleton *mskeleton, char *filename, int fps, gx3dMotionMetadataRequest *metadata_requested, int num_metadata_requested, bool load_all_metadata);
-static void Display_Fonts(gx3dObject *billboards[], char buf[], int buf_size, int max_index, gx3dMatrix m, gx3dTexture tex, bool show_zeros);
-static void Display_Font(gx3dObject *billboard, char ch, gx3dMatrix m, gx3dTexture tex);
+static void Draw_Hoshus(const SimFrame *sim, const SimDraw *draw, gx3dVector billboard_normal, unsigned elapsed_time);
+static void Init_HUD();
+static void Update_HUD(const SimFrame *sim);
 static void Play_FX(gx3dTexture effect, gx3dVector normal, gx3dVector position, gx3dVector scale, float duration, unsigned time, int alpha_test, bool repeat);
-float Inverse_Lerp(float start, float end, float t);
+static void Queue_FX(gx3dTexture effect, gx3dVector normal, gx3dVector position, gx3dVector scale, float duration, unsigned time, int alpha_test, bool repeat);
+static bool FX_Matrices(gx3dVector normal, gx3dVector position, gx3dVector scale, float duration, unsigned time, bool repeat, gx3dMatrix *world, gx3dMatrix *texture);
+static simSphere To_Sim_Sphere(gx3dSphere *sphere);
+static gx3dVector To_Gx3d_Vector(simVector v);
+static gx3dVector Projectile_Position(const SimFrame *sim, const SimDraw *draw, int i);
+static gx3dObjectLayer *Find_Layer(gx3dObject *object, char *name);
+static void Report_Layer_Lookups(char *screen, unsigned lookups);
+static void Begin_Cull();
+static void Add_Cull_Bound(gx3dVector center, float radius, int index);
+static void Cull();
+static void Report_Culling(char *screen);
+static int Load_Lods(char *format, gx3dObject **objects, int vertex_format, int flags);
+static gx3dTexture Load_Impostor(char *filename, char *alpha_filename);
+static bool File_Exists(char *filename);
+static float Eye_Distance(gx3dVector *point);
+static void Queue_Impostor(gx3dTexture impostor, int material, gx3dVector normal, gx3dVector position, float size);
+static void Report_Lod(char *screen);
 static void Update_Light(gx3dLight *light, gx3dColor color, gx3dVector *position, float range, unsigned time_elapsed, bool flicker);
 static void Update_Light(gx3dLight *light, gx3dColor color, gx3dVector *position, float range, unsigned time_elapsed, bool flicker, float constant, float linear, float quadratic);
 
@@ -119,6 +164,7 @@ static void Free_GameOverScreen();
 			}										  \
 	if (NOT quit) {                                   \
 		gxRestoreDirectX ();						  \
+		Render_State_Reset ();						  \
 		evFlushEvents ();							  \
 		msHideMouse ();                               \
 	}                                                 \
@@ -152,6 +198,7 @@ static void Free_GameOverScreen();
 
 //========== Matrices ==========//
 gx3dMatrix m, m1, m2, m3, m4, m5;
+static gx3dMatrix instance_matrix[MAX_PROJECTILE_COUNT + 2 * MAX_ENEMY_COUNT]; // gathered for an instanced draw
 
 //========== Vectors ==========//
 gx3dVector v, v1, v2;
@@ -222,18 +269,9 @@ static gx3dMaterialData material_red_laser = {
 
 //========== Lights ==========//
 gx3dLightData light_data, lightdata;
-gx3dLight dir_light, explosion_light;
+gx3dLight dir_light, explosion_light, raiu_light, heal_pad_light;
 
 //========== Object Structures ==========//
-// Structure for world structures
-struct World_Structures {
-	int type;
-	gx3dVector pos;
-	int side;				// (-1) left | (0) both left and right | (1) right
-	bool spawned;			// is the structure currently spawned?
-	bool rotated = false;	// has the structure already been rotated when needed?
-};
-
 // Structure for lights used by the world structures
 struct Structure_Lights {
 	gx3dLight light;				// light
@@ -246,79 +284,24 @@ struct Floor_Lights {
 	gx3dVector pos;
 };
 
-// Structure for the electric fence (or health pad)
-struct Health_Pad {
-	gx3dSphere sphere;
-	gx3dVector pos;
-	gx3dLight light;
-	gx3dParticleSystem psys;
-	int heal_amt;
-	bool ps_enable = false;		// is the particle system activated on the pad?
-	bool draw = false;			// is it currently drawn in the world?
-};
-
-// Structure for a laser projectile
-struct Laser {
-	gx3dSphere sphere;								// bounding sphere
-	gx3dVector pos;									// position
-	gx3dVector distance = { 0,0,0 };				// distance that the projectile have traveled so far in each axes
-	gx3dTrajectory trajectory;						// direction and speed of the projectile
-	bool hit = false;								// will the laser hit its target?
-	int hit_index = -1;								// used by the character which saves the index of the enemy that is going to be hit first
-	float world_shift = 0.0;						// total amount of world transformation applied since the projectile was fired
-	bool destroyed = false;							// used on enemies when the character has the blade active on the moment of impact
-	bool draw = false;								// should it be drawn?
-	float hit_timer = -1;							// timer that starts when the laser had just hit an object, enemies, or the character
+// Structure for the HUD: the values it shows and what was built from them
+struct HUD {
+	unsigned dirty;					// HUD_DIRTY_* parts to rebuild
+	int hp, gun_lv, blade_lv;		// values shown
+	int score;
+	gx3dMatrix hp_texture;			// green or red half of the HP background
+	GlyphBatch glyphs;				// all the digits
 };
 
-// Structure for the Hoshu
-struct Hoshu {
-	gx3dSphere sphere;								// bounding sphere
-	gx3dVector pos;									// position
-	gx3dVector view;								// Hoshu's normal view vector
-	int lv;											// level
-	int hp;											// health
-	int score_amt;									// amount of score given when defeated
-	int exp_amt;									// amount of experience points given when defeated
-	int gun_damage;									// gun damage
-	unsigned gun_delay;								// delay for shooting a laser
-	unsigned gun_timer;								// timer for shooting delay
-	Laser laser[HOSHU_MAX_LASER_COUNT];				// Hoshu's ammunition
-	float fire_rate;								// how fast the Hoshu can shoot a projectile with respect to the delay
-	int laser_index;								// index of the next shootable laser
-	bool onScreen = false;							// is it on the screen?
-	bool draw = false;								// should it be drawn? (spawned?)
-	float explosion_timer = -1;						// timer that starts for when the Hoshu was just destroyed (-1 disables the timer)
-	int explosion_type = -1;						// type of explosion initialized (used for updating explosion effects) (-1 disables the explosion from being generated)
-	bool explode_snd_initialized = false;			// indicates if the explosion sound had been initialized
-	bool blade_mark_1 = false;						// marker for when the Hoshu has already taken damage from blade swing 1
-	bool blade_mark_2 = false;						// marker for when the Hoshu has already taken damage from blade swing 2
-};
-
-// Structure for enemies
-struct Enemy {
-	Hoshu hoshu[MAX_ENEMY_COUNT];
-	int hoshu_index;
-};
-
-// Structure for Raiu
-struct Raiu {
-	gx3dSphere sphere;					// bounding sphere
-	gx3dVector pos;						// position
-	gx3dVector view;					// Raiu's normal view vector
-	gx3dLight light;					// character's light
-	int hp;								// health
-	int blade_lv;						// blade level
-	int blade_damage;					// blade damage
-	float blade_delay;					// delay for using the blade
-	float blade_timer;					// timer for using the blade
-	int gun_lv;							// gun level
-	int gun_damage;						// gun damage
-	unsigned gun_delay;					// delay for shooting the ray gun
-	unsigned gun_timer;					// timer for shooting delay
-	int exp;							// experience points
-	Laser laser[RAIU_MAX_LASER_COUNT];	// Raiu's ammunition
-	int laser_index;					// index of the next shootable laser
+// Bounding spheres of the draws being culled (structure of arrays)
+struct Cull_Bounds {
+	int count;
+	float x[MAX_CULL_BOUNDS];
+	float y[MAX_CULL_BOUNDS];
+	float z[MAX_CULL_BOUNDS];
+	float radius[MAX_CULL_BOUNDS];
+	int index[MAX_CULL_BOUNDS];					// what each sphere bounds (a slot or an index)
+	unsigned visible[CULL_MASK_WORDS(MAX_CULL_BOUNDS)];
 };
 
 //========== Sounds ==========//
@@ -337,24 +320,43 @@ Sound s_game_over_bgm;
 //========== Objects & Textures ==========//
 // Loading Screen
 gx3dObject *obj_loading;
+gx3dObjectLayer *layer_loading_text;
 gx3dTexture tex_loading_text;
 
 // Title Screen
 gx3dObject *obj_billboards, *obj_quit_button;
+gx3dObjectLayer *layer_menu_button, *layer_quit_button, *layer_title_screen_l, *layer_title_screen_r, *layer_help_screen;
 gx3dTexture tex_title_screen_l, tex_title_screen_r, tex_button_start_game, tex_button_quit_game, tex_help_screen;
 
 // Game Screen
-gx3dObject *obj_hud, *obj_hp_fonts[MAX_HP_FONTS*2], *obj_score_fonts[MAX_SCORE_FONTS], *obj_weapon_lv_fonts[MAX_LV_FONTS*2], *obj_raiu, *obj_hoshu;
+gx3dObject *obj_hud, *obj_fonts, *obj_raiu, *obj_hoshu;
 gx3dObject *obj_skydome, *obj_ground, *obj_structures, *obj_laser, *obj_fence;
+gx3dObjectLayer *layer_hp, *layer_hp_bar, *layer_weapons_lv, *layer_score_bar, *layer_fx, *layer_full_screen_l, *layer_full_screen_r;
+gx3dObjectLayer *layer_fonts;
+gx3dVector hp_font_slot[MAX_HP_FONTS*2], score_font_slot[MAX_SCORE_FONTS], weapon_lv_font_slot[MAX_LV_FONTS*2]; // digit positions
+HUD hud;
+gx3dObjectLayer *layer_skydome, *layer_earth, *layer_ground, *layer_ground_inner, *layer_ground_under, *layer_structure[MAX_LOD_LEVELS][4], *layer_hoshu[MAX_LOD_LEVELS][2];
 gx3dTexture tex_hp, tex_hp_bar, tex_score_bar, tex_fonts, tex_weapons_lv, tex_raiu, tex_hoshu, tex_blue_laser, tex_red_laser;
 gx3dTexture tex_skydome, tex_earth, tex_ground, tex_ground_inner, tex_ground_under, tex_structures;
 gx3dTexture fx_run_charge, fx_fence, fx_explosion_1, fx_explosion_2, fx_explosion_3, fx_laser_blue, fx_laser_red, fx_level_up;
 gx3dTexture fx_destruct_shock, fx_destruct_charge, fx_destruct_charge_loop, fx_destruct_flash;
-Raiu raiu;
-Enemy enemies;
+
+// Detail levels of the Hoshus and structures (level 0 is obj_hoshu and obj_structures)
+gx3dObject *obj_hoshu_lod[MAX_LOD_LEVELS], *obj_structures_lod[MAX_LOD_LEVELS];
+gx3dTexture tex_hoshu_impostor, tex_structure_impostor[4];
+Lod_Set lod_hoshu, lod_structures;
+static int hoshu_lod[MAX_ENEMY_COUNT];			// level each Hoshu slot was drawn at
+static unsigned hoshu_lod_id[MAX_ENEMY_COUNT];	// id of the Hoshu that level belongs to
+static int structure_lod[MAX_STRUCTURE_COUNT];
+static unsigned lod_drawn[MAX_LOD_LEVELS + 1];	// instances drawn at each level (then impostors) since the last report
+
+// Culling of the world objects
+static Cull_Frustum frustum;				// view frustum of the frame, cut at the fog end
+static Cull_Bounds cull_bounds;
+static unsigned cull_frames, cull_tested, cull_culled; // since the last report
 
 // Game Over Screen
-gx3dObject *obj_hr_fonts[MAX_TIME_FONTS], *obj_min_fonts[MAX_TIME_FONTS], *obj_sec_fonts[MAX_TIME_FONTS], *obj_defeated_fonts[MAX_DEFEATED_FONTS];
+gx3dVector hr_font_slot[MAX_TIME_FONTS], min_font_slot[MAX_TIME_FONTS], sec_font_slot[MAX_TIME_FONTS], defeated_font_slot[MAX_DEFEATED_FONTS]; // digit positions
 gx3dTexture tex_game_over_l, tex_game_over_r;
 gx3dTexture fx_fade_white;
 
@@ -366,10 +368,104 @@ gx3dBlendNode *bnode_entrance, *bnode_trip, *bnode_self_destruct, *bnode_run, *b
 gx3dBlendNode *bnode_aim_ud, *bnode_aim_lr, *bnode_aim_udlr, *bnode_adder_run_aim;
 gx3dBlendTree *btree_entrance, *btree_movement, *btree_trip, *btree_self_destruct;
 
+//========== Prefetch Lists ==========//
+// Game screen assets, loaded while the title screen is up (keep in step with Init_GameScreen: an asset
+// missing here is just loaded when the game screen starts)
+static const Prefetch_Asset game_screen_assets[] = {
+	{ PREFETCH_OBJECT, "Objects\\billboards.lwo", 0, gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES },
+	{ PREFETCH_OBJECT, "Objects\\raiu.lwo", 0, gx3d_VERTEXFORMAT_TEXCOORDS | gx3d_VERTEXFORMAT_WEIGHTS, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_DONT_LOAD_TEXTURES },
+	{ PREFETCH_OBJECT, "Objects\\hoshu.lwo", 0, gx3d_VERTEXFORMAT_TEXCOORDS | gx3d_VERTEXFORMAT_WEIGHTS, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_DONT_LOAD_TEXTURES },
+	{ PREFETCH_OBJECT, "Objects\\space_skydome.lwo", 0, gx3d_VERTEXFORMAT_DEFAULT, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_SMOOTH_DISCONTINUOUS_VERTICES | gx3d_DONT_LOAD_TEXTURES },
+	{ PREFETCH_OBJECT, "Objects\\spacecraft_ground.lwo", 0, gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES },
+	{ PREFETCH_OBJECT, "Objects\\spacecraft_structures.lwo", 0, gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES },
+	{ PREFETCH_OBJECT, "Objects\\electric_fence.lwo", 0, gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES },
+	{ PREFETCH_OBJECT, "Objects\\projectile_laser.lwo", 0, gx3d_VERTEXFORMAT_DEFAULT, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_DONT_LOAD_TEXTURES },
+	{ PREFETCH_OBJECT, "Objects\\hoshu_lod1.lwo", 0, gx3d_VERTEXFORMAT_TEXCOORDS | gx3d_VERTEXFORMAT_WEIGHTS, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_DONT_LOAD_TEXTURES },
+	{ PREFETCH_OBJECT, "Objects\\hoshu_lod2.lwo", 0, gx3d_VERTEXFORMAT_TEXCOORDS | gx3d_VERTEXFORMAT_WEIGHTS, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_DONT_LOAD_TEXTURES },
+	{ PREFETCH_OBJECT, "Objects\\spacecraft_structures_lod1.lwo", 0, gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES },
+	{ PREFETCH_OBJECT, "Objects\\spacecraft_structures_lod2.lwo", 0, gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\hp.bmp", "Objects\\Images\\hp_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\hp_bar.bmp", 0, 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\score_bar.bmp", "Objects\\Images\\score_bar_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\score_fonts.bmp", "Objects\\Images\\score_fonts_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\weapons_lv.bmp", "Objects\\Images\\weapons_lv_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\raiu_texture.bmp", "Objects\\Images\\raiu_texture_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\hoshu_texture.bmp", "Objects\\Images\\hoshu_texture_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\space_texture.bmp", 0, 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\earth.bmp", "Objects\\Images\\earth_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\spacecraft_ground_texture.bmp", 0, 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\spacecraft_inner_texture.bmp", 0, 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\spacecraft_underground_texture.bmp", 0, 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\spacecraft_structure_texture.bmp", 0, 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\blue_laser.bmp", "Objects\\Images\\laser_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\red_laser.bmp", "Objects\\Images\\laser_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\hoshu_impostor.bmp", "Objects\\Images\\hoshu_impostor_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\structure_1_impostor.bmp", "Objects\\Images\\structure_1_impostor_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\structure_2_impostor.bmp", "Objects\\Images\\structure_2_impostor_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\structure_3_impostor.bmp", "Objects\\Images\\structure_3_impostor_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\structure_4_impostor.bmp", "Objects\\Images\\structure_4_impostor_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\FX\\electricity_1.bmp", "Objects\\FX\\electricity_1_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\FX\\electricity_3.bmp", "Objects\\FX\\electricity_3_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\FX\\explosion_1.bmp", "Objects\\FX\\explosion_1_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\FX\\explosion_2.bmp", "Objects\\FX\\explosion_2_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\FX\\explosion_3.bmp", "Objects\\FX\\explosion_3_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\FX\\laser_hit_blue.bmp", "Objects\\FX\\laser_hit_blue_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\FX\\laser_hit_red.bmp", "Objects\\FX\\laser_hit_red_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\FX\\level_up.bmp", "Objects\\FX\\level_up_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\FX\\electricity_2.bmp", "Objects\\FX\\electricity_2_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\FX\\self_destruct_charge.bmp", "Objects\\FX\\self_destruct_charge_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\FX\\self_destruct_charge_loop.bmp", "Objects\\FX\\self_destruct_charge_loop_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\FX\\self_destruct_flash.bmp", "Objects\\FX\\self_destruct_flash_fa.bmp", 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\FX\\fade_white.bmp", "Objects\\FX\\fade_white_fa.bmp", 0, 0 },
+	{ PREFETCH_FILE, "wav\\cool_adventure_bgm.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\raiu_game_start.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\raiu_self_destruct.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\level_up.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\enemy_alarm.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\electric_fence.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\blade_slash1.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\blade_slash2.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\laser_beam1.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\laser_beam2.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\footstep_metal.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\raiu_electric_nice.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\raiu_grunt1.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\raiu_hurt1.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\raiu_hurt2.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\explosion1.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\explosion2.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\explosion3.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "electric_current.gxps", 0, 0, 0 },
+	{ PREFETCH_FILE, "ani\\raiu_run.gx3dskel", 0, 0, 0 },
+	{ PREFETCH_FILE, "ani\\raiu_neutral.gx3dani", 0, 0, 0 },
+	{ PREFETCH_FILE, "ani\\raiu_run.gx3dani", 0, 0, 0 },
+	{ PREFETCH_FILE, "ani\\raiu_swing_blade_1.gx3dani", 0, 0, 0 },
+	{ PREFETCH_FILE, "ani\\raiu_swing_blade_2.gx3dani", 0, 0, 0 },
+	{ PREFETCH_FILE, "ani\\raiu_game_start.gx3dani", 0, 0, 0 },
+	{ PREFETCH_FILE, "ani\\raiu_aim_up.gx3dani", 0, 0, 0 },
+	{ PREFETCH_FILE, "ani\\raiu_aim_down.gx3dani", 0, 0, 0 },
+	{ PREFETCH_FILE, "ani\\raiu_aim_left.gx3dani", 0, 0, 0 },
+	{ PREFETCH_FILE, "ani\\raiu_aim_right.gx3dani", 0, 0, 0 },
+	{ PREFETCH_FILE, "ani\\raiu_fall.gx3dani", 0, 0, 0 },
+	{ PREFETCH_FILE, "ani\\raiu_self_destruct.gx3dani", 0, 0, 0 },
+};
+
+// Game over screen assets, read during the game (both endings, since the score decides which one is used)
+static const Prefetch_Asset game_over_assets[] = {
+	{ PREFETCH_TEXTURE, "Objects\\Images\\omega_thunder_game_over_win_1.bmp", 0, 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\omega_thunder_game_over_win_2.bmp", 0, 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\omega_thunder_game_over_lose_1.bmp", 0, 0, 0 },
+	{ PREFETCH_TEXTURE, "Objects\\Images\\omega_thunder_game_over_lose_2.bmp", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\game_over_win.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\game_over_lose.wav", 0, 0, 0 },
+	{ PREFETCH_FILE, "wav\\menu_select.wav", 0, 0, 0 }
+};
+
 //========== Other Variables ==========//
 evEvent event;
 gxRelation relation;
 gx3dObjectLayer *layer;
+static unsigned layer_lookups; // layers looked up by name (only while loading)
 gx3dVector position, heading;
 int move_x, move_y;
 static int first_run = TRUE;
@@ -380,12 +476,8 @@ bool isLoading = false, loaded = false;
 float sfx_volume = 85;
 float bgm_volume = 90;
 float world_shift_amt; // variable representing the amount of translation to be performed on the world
-World_Structures structure[MAX_STRUCTURE_COUNT];
 Structure_Lights structure_light[MAX_STRUCTURE_LIGHTS]; // maximum of 8 lights can be initialized at a time (2 already used: dir_light and character light)
-Health_Pad heal_pad;
-int score;
-unsigned game_timer;
-int enemies_defeated, hoshus_defeated;
+gx3dParticleSystem heal_pad_psys;
 
 /*____________________________________________________________________
 |
@@ -481,6 +573,7 @@ bool Render_Game_Loop(int *state)
 		break;
 	case STATE_STARTING:
 		quit = Render_GameScreen(*&state);
+		Sim_Thread_Stop();
 		break;
 	case STATE_GAME_OVER:
 		quit = Render_GameOverScreen(*&state);
@@ -504,7 +597,7 @@ static void Init_LoadingScreen() {
 	|___________________________________________________________________*/
 
 	// Set projection matrix
-	gx3d_SetProjectionMatrix(FULL_SCREEN_FOV, FULL_SCREEN_NEAR_PLANE, FULL_SCREEN_FAR_PLANE);
+	Render_State_Projection(FULL_SCREEN_FOV, FULL_SCREEN_NEAR_PLANE, FULL_SCREEN_FAR_PLANE);
 	gx3d_SetFillMode(gx3d_FILL_MODE_GOURAUD_SHADED);
 
 	// Sets the 3D viewport clear color to black
@@ -518,10 +611,11 @@ static void Init_LoadingScreen() {
 	| Load loading screen objects
 	|___________________________________________________________________*/
 	// Load models
-	gx3d_ReadLWO2File("Objects\\billboards.lwo", &obj_loading, gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
+	obj_loading = Asset_Object("Objects\\billboards.lwo", gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES, 0);
+	layer_loading_text = Find_Layer(obj_loading, "loading_text");
 
 	// Load textures
-	tex_loading_text = gx3d_InitTexture_File("Objects\\Images\\omega_thunder_loading.bmp", "Objects\\Images\\omega_thunder_loading_fa.bmp", 0);
+	tex_loading_text = Asset_Texture("Objects\\Images\\omega_thunder_loading.bmp", "Objects\\Images\\omega_thunder_loading_fa.bmp", 0);
 }
 
 /*____________________________________________________________________
@@ -543,8 +637,11 @@ static void Display_LoadingScreen() {
 	gx3d_ClearViewport(gx3d_CLEAR_SURFACE | gx3d_CLEAR_ZBUFFER, color, gx3d_MAX_ZBUFFER_VALUE, 0);
 	// Start rendering in 3D
 	if (gx3d_BeginRender()) {
+		// Count the render state calls and transform updates of this frame
+		Render_State_Begin_Frame();
+		Transform_Begin_Frame();
 		// Set the default light
-		gx3d_SetAmbientLight(color3d_white);
+		Render_State_Ambient_Light(color3d_white);
 		// Set the default material
 		gx3d_SetMaterial(&material_default);
 
@@ -563,25 +660,25 @@ static void Display_LoadingScreen() {
 		gx3d_CameraSetViewMatrix();
 
 		// Do necessary transformations to fit the title screen objects on screen
-		layer = gx3d_GetObjectLayer(obj_loading, "loading_text");
+		layer = layer_loading_text;
 		gx3d_GetScaleMatrix(&m1, loading_scale, loading_scale, loading_scale);
 		gx3d_GetTranslateMatrix(&m2, loading_x, loading_y, 0);
 		gx3d_MultiplyMatrix(&m1, &m2, &m1);
-		gx3d_SetObjectLayerMatrix(obj_loading, layer, &m1);
+		Transform_Set(obj_loading, layer, &m1);
 
 		// Update transforms
-		gx3d_Object_UpdateTransforms(obj_loading);
+		Transform_Update(obj_loading);
 
 		// Draw the appropriate objects on screen
-		gx3d_DisableZBuffer();
-		gx3d_EnableAlphaBlending();
+		Render_State_Z_Buffer(false);
+		Render_State_Alpha_Blending(true);
 
-		layer = gx3d_GetObjectLayer(obj_loading, "loading_text");
+		layer = layer_loading_text;
 		gx3d_SetTexture(0, tex_loading_text);
 		gx3d_DrawObjectLayer(layer, 0);
 
-		gx3d_DisableAlphaBlending();
-		gx3d_EnableZBuffer();
+		Render_State_Alpha_Blending(false);
+		Render_State_Z_Buffer(true);
 
 		// Restore view matrix
 		gx3d_SetViewMatrix(&view_save);
@@ -610,7 +707,7 @@ static void Init_TitleScreen() {
 	|___________________________________________________________________*/
 
 	// Set projection matrix
-	gx3d_SetProjectionMatrix(FULL_SCREEN_FOV, FULL_SCREEN_NEAR_PLANE, FULL_SCREEN_FAR_PLANE);
+	Render_State_Projection(FULL_SCREEN_FOV, FULL_SCREEN_NEAR_PLANE, FULL_SCREEN_FAR_PLANE);
 	gx3d_SetFillMode(gx3d_FILL_MODE_GOURAUD_SHADED);
 
 	// Sets the 3D viewport clear color to black
@@ -635,15 +732,20 @@ static void Init_TitleScreen() {
 	|___________________________________________________________________*/
 
 	// Load models
-	gx3d_ReadLWO2File("Objects\\billboards.lwo", &obj_billboards, gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
-	gx3d_ReadLWO2File("Objects\\billboards.lwo", &obj_quit_button, gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
+	obj_billboards = Asset_Object("Objects\\billboards.lwo", gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES, 0);
+	obj_quit_button = Asset_Object("Objects\\billboards.lwo", gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES, 1);
+	layer_menu_button = Find_Layer(obj_billboards, "menu_button");
+	layer_quit_button = Find_Layer(obj_quit_button, "menu_button");
+	layer_title_screen_l = Find_Layer(obj_billboards, "full_screen_l");
+	layer_title_screen_r = Find_Layer(obj_billboards, "full_screen_r");
+	layer_help_screen = Find_Layer(obj_billboards, "help_screen");
 
 	// Load textures
-	tex_title_screen_l = gx3d_InitTexture_File("Objects\\Images\\omega_thunder_title_screen_1.bmp", 0, 0);
-	tex_title_screen_r = gx3d_InitTexture_File("Objects\\Images\\omega_thunder_title_screen_2.bmp", 0, 0);
-	tex_button_start_game = gx3d_InitTexture_File("Objects\\Images\\start_game_button.bmp", "Objects\\Images\\button_fa.bmp", 0);
-	tex_button_quit_game = gx3d_InitTexture_File("Objects\\Images\\quit_game_button.bmp", "Objects\\Images\\button_fa.bmp", 0);
-	tex_help_screen = gx3d_InitTexture_File("Objects\\Images\\help_screen.bmp", "Objects\\Images\\help_screen_fa.bmp", 0);
+	tex_title_screen_l = Asset_Texture("Objects\\Images\\omega_thunder_title_screen_1.bmp", 0, 0);
+	tex_title_screen_r = Asset_Texture("Objects\\Images\\omega_thunder_title_screen_2.bmp", 0, 0);
+	tex_button_start_game = Asset_Texture("Objects\\Images\\start_game_button.bmp", "Objects\\Images\\button_fa.bmp", 0);
+	tex_button_quit_game = Asset_Texture("Objects\\Images\\quit_game_button.bmp", "Objects\\Images\\button_fa.bmp", 0);
+	tex_help_screen = Asset_Texture("Objects\\Images\\help_screen.bmp", "Objects\\Images\\help_screen_fa.bmp", 0);
 }
 
 /*____________________________________________________________________
@@ -663,7 +765,7 @@ void Init_GameScreen()
 	|___________________________________________________________________*/
 
 	// Set projection matrix
-	gx3d_SetProjectionMatrix(GAME_FOV, GAME_NEAR_PLANE, GAME_FAR_PLANE);
+	Render_State_Projection(GAME_FOV, GAME_NEAR_PLANE, GAME_FAR_PLANE);
 	gx3d_SetFillMode(gx3d_FILL_MODE_GOURAUD_SHADED);
 
 	// Sets the 3D viewport clear color to black
@@ -708,60 +810,102 @@ void Init_GameScreen()
 	|___________________________________________________________________*/
 
 	// Load particle system for health pad (electric fence)
-	heal_pad.psys = Script_ParticleSystem_Create("electric_current.gxps");
+	heal_pad_psys = Script_ParticleSystem_Create("electric_current.gxps");
 
 	// Load models
-	gx3d_ReadLWO2File("Objects\\billboards.lwo", &obj_hud, gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
-	for (int i = 0; i < MAX_HP_FONTS * 2; i++) {
-		gx3d_ReadLWO2File("Objects\\billboards.lwo", &obj_hp_fonts[i], gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
-	}
-	for (int i = 0; i < MAX_LV_FONTS * 2; i++) {
-		gx3d_ReadLWO2File("Objects\\billboards.lwo", &obj_weapon_lv_fonts[i], gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
+	obj_hud = Asset_Object("Objects\\billboards.lwo", gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES, 0);
+	obj_fonts = Asset_Object("Objects\\billboards.lwo", gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES, 0); // all the digits of the HUD and game over screen
+	obj_raiu = Asset_Object("Objects\\raiu.lwo", gx3d_VERTEXFORMAT_TEXCOORDS | gx3d_VERTEXFORMAT_WEIGHTS, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_DONT_LOAD_TEXTURES, 0);
+	raiu_skeleton = gx3d_MotionSkeleton_Read_GX3DSKEL_File("ani\\raiu_run.gx3dskel"); // read in the skeleton from a gx3dskel file (faster than reading from an LWS file)
+	if (Asset_Object_First_Use(obj_raiu)) // the asset cache can hand back the object it was attached to last game
+		gx3d_Skeleton_Attach(obj_raiu);
+	obj_hoshu = Asset_Object("Objects\\hoshu.lwo", gx3d_VERTEXFORMAT_TEXCOORDS | gx3d_VERTEXFORMAT_WEIGHTS, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_DONT_LOAD_TEXTURES, 0);
+	obj_skydome = Asset_Object("Objects\\space_skydome.lwo", gx3d_VERTEXFORMAT_DEFAULT, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_SMOOTH_DISCONTINUOUS_VERTICES | gx3d_DONT_LOAD_TEXTURES, 0);
+	obj_ground = Asset_Object("Objects\\spacecraft_ground.lwo", gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES, 0);
+	obj_structures = Asset_Object("Objects\\spacecraft_structures.lwo", gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES, 0);
+	obj_fence = Asset_Object("Objects\\electric_fence.lwo", gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES, 0);
+	obj_laser = Asset_Object("Objects\\projectile_laser.lwo", gx3d_VERTEXFORMAT_DEFAULT, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_DONT_LOAD_TEXTURES, 0);
+
+	// Coarser meshes of the Hoshus and structures (hoshu_lod1.lwo, ...) when they are there
+	obj_hoshu_lod[0] = obj_hoshu;
+	obj_structures_lod[0] = obj_structures;
+	int num_hoshu_meshes = Load_Lods("Objects\\hoshu_lod%d.lwo", obj_hoshu_lod, gx3d_VERTEXFORMAT_TEXCOORDS | gx3d_VERTEXFORMAT_WEIGHTS, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_DONT_LOAD_TEXTURES);
+	int num_structure_meshes = Load_Lods("Objects\\spacecraft_structures_lod%d.lwo", obj_structures_lod, gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
+
+	//========== Find object layers ==========//
+	layer_hp = Find_Layer(obj_hud, "hp");
+	layer_hp_bar = Find_Layer(obj_hud, "hp_bar");
+	layer_weapons_lv = Find_Layer(obj_hud, "weapons_lv");
+	layer_score_bar = Find_Layer(obj_hud, "score_bar");
+	layer_fx = Find_Layer(obj_hud, "fx");
+	layer_full_screen_l = Find_Layer(obj_hud, "full_screen_l");
+	layer_full_screen_r = Find_Layer(obj_hud, "full_screen_r");
+	layer_fonts = Find_Layer(obj_fonts, "score_fonts");
+	layer_skydome = Find_Layer(obj_skydome, "skydome");
+	layer_earth = Find_Layer(obj_skydome, "earth");
+	layer_ground = Find_Layer(obj_ground, "ground");
+	layer_ground_inner = Find_Layer(obj_ground, "inner");
+	layer_ground_under = Find_Layer(obj_ground, "underground");
+	for (int level = 0; level < num_structure_meshes; level++) {
+		layer_structure[level][0] = Find_Layer(obj_structures_lod[level], "structure_1");
+		layer_structure[level][1] = Find_Layer(obj_structures_lod[level], "structure_2");
+		layer_structure[level][2] = Find_Layer(obj_structures_lod[level], "structure_3");
+		layer_structure[level][3] = Find_Layer(obj_structures_lod[level], "structure_4");
 	}
-	for (int i = 0; i < MAX_SCORE_FONTS; i++) {
-		gx3d_ReadLWO2File("Objects\\billboards.lwo", &obj_score_fonts[i], gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
+	for (int level = 0; level < num_hoshu_meshes; level++) {
+		layer_hoshu[level][0] = Find_Layer(obj_hoshu_lod[level], "bottom");
+		layer_hoshu[level][1] = Find_Layer(obj_hoshu_lod[level], "top");
 	}
-	gx3d_ReadLWO2File("Objects\\raiu.lwo", &obj_raiu, gx3d_VERTEXFORMAT_TEXCOORDS | gx3d_VERTEXFORMAT_WEIGHTS, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_DONT_LOAD_TEXTURES);
-	raiu_skeleton = gx3d_MotionSkeleton_Read_GX3DSKEL_File("ani\\raiu_run.gx3dskel"); // read in the skeleton from a gx3dskel file (faster than reading from an LWS file)
-	gx3d_Skeleton_Attach(obj_raiu);
-	gx3d_ReadLWO2File("Objects\\hoshu.lwo", &obj_hoshu, gx3d_VERTEXFORMAT_TEXCOORDS | gx3d_VERTEXFORMAT_WEIGHTS, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_DONT_LOAD_TEXTURES);
-	gx3d_ReadLWO2File("Objects\\space_skydome.lwo", &obj_skydome, gx3d_VERTEXFORMAT_DEFAULT, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_SMOOTH_DISCONTINUOUS_VERTICES | gx3d_DONT_LOAD_TEXTURES);
-	gx3d_ReadLWO2File("Objects\\spacecraft_ground.lwo", &obj_ground, gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
-	gx3d_ReadLWO2File("Objects\\spacecraft_structures.lwo", &obj_structures, gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
-	gx3d_ReadLWO2File("Objects\\electric_fence.lwo", &obj_fence, gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
-	gx3d_ReadLWO2File("Objects\\projectile_laser.lwo", &obj_laser, gx3d_VERTEXFORMAT_DEFAULT, gx3d_MERGE_DUPLICATE_VERTICES | gx3d_DONT_LOAD_TEXTURES);
 
 	//========== Load textures ==========//
-	tex_hp = gx3d_InitTexture_File("Objects\\Images\\hp.bmp", "Objects\\Images\\hp_fa.bmp", 0);
-	tex_hp_bar = gx3d_InitTexture_File("Objects\\Images\\hp_bar.bmp", 0, 0);
-	tex_score_bar = gx3d_InitTexture_File("Objects\\Images\\score_bar.bmp", "Objects\\Images\\score_bar_fa.bmp", 0);
-	tex_fonts = gx3d_InitTexture_File("Objects\\Images\\score_fonts.bmp", "Objects\\Images\\score_fonts_fa.bmp", 0);
-	tex_weapons_lv = gx3d_InitTexture_File("Objects\\Images\\weapons_lv.bmp", "Objects\\Images\\weapons_lv_fa.bmp", 0);
-	tex_raiu = gx3d_InitTexture_File("Objects\\Images\\raiu_texture.bmp", "Objects\\Images\\raiu_texture_fa.bmp", 0);
-	tex_hoshu = gx3d_InitTexture_File("Objects\\Images\\hoshu_texture.bmp", "Objects\\Images\\hoshu_texture_fa.bmp", 0);
-	tex_skydome = gx3d_InitTexture_File("Objects\\Images\\space_texture.bmp", 0, 0);
-	tex_earth = gx3d_InitTexture_File("Objects\\Images\\earth.bmp", "Objects\\Images\\earth_fa.bmp", 0);
-	tex_ground = gx3d_InitTexture_File("Objects\\Images\\spacecraft_ground_texture.bmp", 0, 0);
-	tex_ground_inner = gx3d_InitTexture_File("Objects\\Images\\spacecraft_inner_texture.bmp", 0, 0);
-	tex_ground_under = gx3d_InitTexture_File("Objects\\Images\\spacecraft_underground_texture.bmp", 0, 0);
-	tex_structures = gx3d_InitTexture_File("Objects\\Images\\spacecraft_structure_texture.bmp", 0, 0);
-	tex_blue_laser = gx3d_InitTexture_File("Objects\\Images\\blue_laser.bmp", "Objects\\Images\\laser_fa.bmp", 0);
-	tex_red_laser = gx3d_InitTexture_File("Objects\\Images\\red_laser.bmp", "Objects\\Images\\laser_fa.bmp", 0);
+	tex_hp = Asset_Texture("Objects\\Images\\hp.bmp", "Objects\\Images\\hp_fa.bmp", 0);
+	tex_hp_bar = Asset_Texture("Objects\\Images\\hp_bar.bmp", 0, 0);
+	tex_score_bar = Asset_Texture("Objects\\Images\\score_bar.bmp", "Objects\\Images\\score_bar_fa.bmp", 0);
+	tex_fonts = Asset_Texture("Objects\\Images\\score_fonts.bmp", "Objects\\Images\\score_fonts_fa.bmp", 0);
+	tex_weapons_lv = Asset_Texture("Objects\\Images\\weapons_lv.bmp", "Objects\\Images\\weapons_lv_fa.bmp", 0);
+	tex_raiu = Asset_Texture("Objects\\Images\\raiu_texture.bmp", "Objects\\Images\\raiu_texture_fa.bmp", 0);
+	tex_hoshu = Asset_Texture("Objects\\Images\\hoshu_texture.bmp", "Objects\\Images\\hoshu_texture_fa.bmp", 0);
+	tex_skydome = Asset_Texture("Objects\\Images\\space_texture.bmp", 0, 0);
+	tex_earth = Asset_Texture("Objects\\Images\\earth.bmp", "Objects\\Images\\earth_fa.bmp", 0);
+	tex_ground = Asset_Texture("Objects\\Images\\spacecraft_ground_texture.bmp", 0, 0);
+	tex_ground_inner = Asset_Texture("Objects\\Images\\spacecraft_inner_texture.bmp", 0, 0);
+	tex_ground_under = Asset_Texture("Objects\\Images\\spacecraft_underground_texture.bmp", 0, 0);
+	tex_structures = Asset_Texture("Objects\\Images\\spacecraft_structure_texture.bmp", 0, 0);
+	tex_blue_laser = Asset_Texture("Objects\\Images\\blue_laser.bmp", "Objects\\Images\\laser_fa.bmp", 0);
+	tex_red_laser = Asset_Texture("Objects\\Images\\red_laser.bmp", "Objects\\Images\\laser_fa.bmp", 0);
+
+	// Impostors of far away Hoshus and structures, when they are there
+	tex_hoshu_impostor = Load_Impostor("Objects\\Images\\hoshu_impostor.bmp", "Objects\\Images\\hoshu_impostor_fa.bmp");
+	tex_structure_impostor[0] = Load_Impostor("Objects\\Images\\structure_1_impostor.bmp", "Objects\\Images\\structure_1_impostor_fa.bmp");
+	tex_structure_impostor[1] = Load_Impostor("Objects\\Images\\structure_2_impostor.bmp", "Objects\\Images\\structure_2_impostor_fa.bmp");
+	tex_structure_impostor[2] = Load_Impostor("Objects\\Images\\structure_3_impostor.bmp", "Objects\\Images\\structure_3_impostor_fa.bmp");
+	tex_structure_impostor[3] = Load_Impostor("Objects\\Images\\structure_4_impostor.bmp", "Objects\\Images\\structure_4_impostor_fa.bmp");
+
+	// Projected sizes each mesh level is drawn down to
+	const float hoshu_mesh_size[] = { 0.10f, 0.04f };
+	const float structure_mesh_size[] = { 0.30f, 0.12f };
+	Lod_Init(&lod_hoshu, num_hoshu_meshes, hoshu_mesh_size, tex_hoshu_impostor != 0, HOSHU_IMPOSTOR_SIZE);
+	Lod_Init(&lod_structures, num_structure_meshes, structure_mesh_size,
+		tex_structure_impostor[0] && tex_structure_impostor[1] && tex_structure_impostor[2] && tex_structure_impostor[3], STRUCTURE_IMPOSTOR_SIZE);
+	for (int i = 0; i < MAX_ENEMY_COUNT; i++)
+		hoshu_lod_id[i] = 0;
+	for (int i = 0; i < MAX_STRUCTURE_COUNT; i++)
+		structure_lod[i] = 0;
 
 	//========== Load effects textures ==========//
-	fx_run_charge = gx3d_InitTexture_File("Objects\\FX\\electricity_1.bmp", "Objects\\FX\\electricity_1_fa.bmp", 0);
-	fx_fence = gx3d_InitTexture_File("Objects\\FX\\electricity_3.bmp", "Objects\\FX\\electricity_3_fa.bmp", 0);
-	fx_explosion_1 = gx3d_InitTexture_File("Objects\\FX\\explosion_1.bmp", "Objects\\FX\\explosion_1_fa.bmp", 0);
-	fx_explosion_2 = gx3d_InitTexture_File("Objects\\FX\\explosion_2.bmp", "Objects\\FX\\explosion_2_fa.bmp", 0);
-	fx_explosion_3 = gx3d_InitTexture_File("Objects\\FX\\explosion_3.bmp", "Objects\\FX\\explosion_3_fa.bmp", 0);
-	fx_laser_blue = gx3d_InitTexture_File("Objects\\FX\\laser_hit_blue.bmp", "Objects\\FX\\laser_hit_blue_fa.bmp", 0);
-	fx_laser_red = gx3d_InitTexture_File("Objects\\FX\\laser_hit_red.bmp", "Objects\\FX\\laser_hit_red_fa.bmp", 0);
-	fx_level_up = gx3d_InitTexture_File("Objects\\FX\\level_up.bmp", "Objects\\FX\\level_up_fa.bmp", 0);
-	fx_destruct_shock = gx3d_InitTexture_File("Objects\\FX\\electricity_2.bmp", "Objects\\FX\\electricity_2_fa.bmp", 0);
-	fx_destruct_charge = gx3d_InitTexture_File("Objects\\FX\\self_destruct_charge.bmp", "Objects\\FX\\self_destruct_charge_fa.bmp", 0);
-	fx_destruct_charge_loop = gx3d_InitTexture_File("Objects\\FX\\self_destruct_charge_loop.bmp", "Objects\\FX\\self_destruct_charge_loop_fa.bmp", 0);
-	fx_destruct_flash = gx3d_InitTexture_File("Objects\\FX\\self_destruct_flash.bmp", "Objects\\FX\\self_destruct_flash_fa.bmp", 0);
-	fx_fade_white = gx3d_InitTexture_File("Objects\\FX\\fade_white.bmp", "Objects\\FX\\fade_white_fa.bmp", 0);
+	fx_run_charge = Asset_Texture("Objects\\FX\\electricity_1.bmp", "Objects\\FX\\electricity_1_fa.bmp", 0);
+	fx_fence = Asset_Texture("Objects\\FX\\electricity_3.bmp", "Objects\\FX\\electricity_3_fa.bmp", 0);
+	fx_explosion_1 = Asset_Texture("Objects\\FX\\explosion_1.bmp", "Objects\\FX\\explosion_1_fa.bmp", 0);
+	fx_explosion_2 = Asset_Texture("Objects\\FX\\explosion_2.bmp", "Objects\\FX\\explosion_2_fa.bmp", 0);
+	fx_explosion_3 = Asset_Texture("Objects\\FX\\explosion_3.bmp", "Objects\\FX\\explosion_3_fa.bmp", 0);
+	fx_laser_blue = Asset_Texture("Objects\\FX\\laser_hit_blue.bmp", "Objects\\FX\\laser_hit_blue_fa.bmp", 0);
+	fx_laser_red = Asset_Texture("Objects\\FX\\laser_hit_red.bmp", "Objects\\FX\\laser_hit_red_fa.bmp", 0);
+	fx_level_up = Asset_Texture("Objects\\FX\\level_up.bmp", "Objects\\FX\\level_up_fa.bmp", 0);
+	fx_destruct_shock = Asset_Texture("Objects\\FX\\electricity_2.bmp", "Objects\\FX\\electricity_2_fa.bmp", 0);
+	fx_destruct_charge = Asset_Texture("Objects\\FX\\self_destruct_charge.bmp", "Objects\\FX\\self_destruct_charge_fa.bmp", 0);
+	fx_destruct_charge_loop = Asset_Texture("Objects\\FX\\self_destruct_charge_loop.bmp", "Objects\\FX\\self_destruct_charge_loop_fa.bmp", 0);
+	fx_destruct_flash = Asset_Texture("Objects\\FX\\self_destruct_flash.bmp", "Objects\\FX\\self_destruct_flash_fa.bmp", 0);
+	fx_fade_white = Asset_Texture("Objects\\FX\\fade_white.bmp", "Objects\\FX\\fade_white_fa.bmp", 0);
 
 	//========== Load animations ==========//
 	// read in the motion from a gx3dani file(faster than reading from an LWS file)
@@ -926,6 +1070,30 @@ void Init_GameScreen()
 	light_data.point.quadratic_attenuation = 0.0;
 
 	explosion_light = gx3d_InitLight(&light_data);
+
+	// Draw list passes: the skydome is drawn without fog up to the game far plane, everything inside it with fog
+	Draw_List_Set_Pass(DRAW_PASS_SKY, GAME_FOV, GAME_NEAR_PLANE, GAME_FAR_PLANE, false);
+	Draw_List_Set_Pass(DRAW_PASS_OPAQUE, GAME_FOV, GAME_NEAR_PLANE, GAME_DOME_FAR_PLANE, true);
+	Draw_List_Set_Pass(DRAW_PASS_ALPHA, GAME_FOV, GAME_NEAR_PLANE, GAME_DOME_FAR_PLANE, true);
+
+	// Draw list materials
+	Draw_List_Set_Material(DRAW_MATERIAL_SKY, &material_structures, color3d_white, true);
+	Draw_List_Set_Material(DRAW_MATERIAL_GROUND, &material_default, color3d_darkgray, true);
+	Draw_List_Set_Material(DRAW_MATERIAL_STRUCTURES, &material_structures, color3d_gray, false);
+	Draw_List_Set_Material(DRAW_MATERIAL_FENCE, &material_structures, color3d_dim, false);
+	Draw_List_Set_Material(DRAW_MATERIAL_RAIU, &material_raiu, color3d_dim, true);
+	Draw_List_Set_Material(DRAW_MATERIAL_HOSHU, &material_hoshu, color3d_dim, true);
+	Draw_List_Set_Material(DRAW_MATERIAL_RED_LASER, &material_red_laser, color3d_white, false);
+	Draw_List_Set_Material(DRAW_MATERIAL_BLUE_LASER, &material_blue_laser, color3d_white, false);
+	Draw_List_Set_Material(DRAW_MATERIAL_FX, &material_default, color3d_white, false);
+	Draw_List_Set_Material(DRAW_MATERIAL_PARTICLES, &material_structures, color3d_white, false);
+
+	// HUD layout (the values are filled in by the first frame)
+	Init_HUD();
+
+	// Read both game over screens during the game (created when the game over screen starts)
+	Prefetch_Report("Game screen");
+	Prefetch_Start(game_over_assets, sizeof(game_over_assets) / sizeof(game_over_assets[0]));
 }
 
 /*____________________________________________________________________
@@ -944,7 +1112,7 @@ static void Init_GameOverScreen() {
 	|___________________________________________________________________*/
 
 	// Set projection matrix
-	gx3d_SetProjectionMatrix(FULL_SCREEN_FOV, FULL_SCREEN_NEAR_PLANE, FULL_SCREEN_FAR_PLANE);
+	Render_State_Projection(FULL_SCREEN_FOV, FULL_SCREEN_NEAR_PLANE, FULL_SCREEN_FAR_PLANE);
 	gx3d_SetFillMode(gx3d_FILL_MODE_GOURAUD_SHADED);
 
 	// Sets the 3D viewport clear color to white
@@ -962,28 +1130,21 @@ static void Init_GameOverScreen() {
 
 	s_select = snd_LoadSound("wav\\menu_select.wav", snd_CONTROL_VOLUME, 0);
 
-	if (score >= WINNING_SCORE) {
+	if (Sim_Get_Frame()->score >= WINNING_SCORE) {
 		s_game_over_bgm = snd_LoadSound("wav\\game_over_win.wav", snd_CONTROL_VOLUME, 0);
-		tex_game_over_l = gx3d_InitTexture_File("Objects\\Images\\omega_thunder_game_over_win_1.bmp", 0, 0);
-		tex_game_over_r = gx3d_InitTexture_File("Objects\\Images\\omega_thunder_game_over_win_2.bmp", 0, 0);
+		tex_game_over_l = Asset_Texture("Objects\\Images\\omega_thunder_game_over_win_1.bmp", 0, 0);
+		tex_game_over_r = Asset_Texture("Objects\\Images\\omega_thunder_game_over_win_2.bmp", 0, 0);
 	}
 	else {
 		s_game_over_bgm = snd_LoadSound("wav\\game_over_lose.wav", snd_CONTROL_VOLUME, 0);
-		tex_game_over_l = gx3d_InitTexture_File("Objects\\Images\\omega_thunder_game_over_lose_1.bmp", 0, 0);
-		tex_game_over_r = gx3d_InitTexture_File("Objects\\Images\\omega_thunder_game_over_lose_2.bmp", 0, 0);
-	}
-
-	for (int i = 0; i < MAX_TIME_FONTS; i++) {
-		gx3d_ReadLWO2File("Objects\\billboards.lwo", &obj_hr_fonts[i], gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
-		gx3d_ReadLWO2File("Objects\\billboards.lwo", &obj_min_fonts[i], gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
-		gx3d_ReadLWO2File("Objects\\billboards.lwo", &obj_sec_fonts[i], gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
+		tex_game_over_l = Asset_Texture("Objects\\Images\\omega_thunder_game_over_lose_1.bmp", 0, 0);
+		tex_game_over_r = Asset_Texture("Objects\\Images\\omega_thunder_game_over_lose_2.bmp", 0, 0);
 	}
 
-	for (int i = 0; i < MAX_DEFEATED_FONTS; i++)
-		gx3d_ReadLWO2File("Objects\\billboards.lwo", &obj_defeated_fonts[i], gx3d_VERTEXFORMAT_DEFAULT, gx3d_DONT_LOAD_TEXTURES);
+	fx_fade_white = Asset_Texture("Objects\\FX\\fade_white.bmp", "Objects\\FX\\fade_white_fa.bmp", 0);
 
-	fx_fade_white = gx3d_InitTexture_File("Objects\\FX\\fade_white.bmp", "Objects\\FX\\fade_white_fa.bmp", 0);
-	
+	Prefetch_Report("Game over screen");
+	Prefetch_Stop();
 }
 
 /*____________________________________________________________________
@@ -1005,6 +1166,7 @@ bool Render_TitleScreen(int *state) {
 	int selection;
 	bool selected, help_screen_enter_pressed;
 	unsigned elapsed_time, last_time, new_time;
+	unsigned lookups = layer_lookups;
 
 	// Init loop variables
 	const int selection_count = 2; // change when adding more selections to title screen
@@ -1019,6 +1181,9 @@ bool Render_TitleScreen(int *state) {
 	// Plays the background music repeatedly
 	snd_PlaySound(s_title_screen_bgm, 1);
 
+	// Load the game screen while the player reads the title and help screens
+	Prefetch_Start(game_screen_assets, sizeof(game_screen_assets) / sizeof(game_screen_assets[0]));
+
 	// Game loop
 	for (next_screen = FALSE; NOT next_screen || snd_IsPlaying(s_select); ) {
 
@@ -1081,6 +1246,10 @@ bool Render_TitleScreen(int *state) {
 		| Draw graphics
 		|___________________________________________________________________*/
 
+		// Create the game screen assets read so far, in part of the frame
+		if (NOT next_screen)
+			Prefetch_Step(PREFETCH_FRAME_BUDGET);
+
 		// Displays loading screen when getting ready to switch screens
 		if (next_screen)
 			Display_LoadingScreen();
@@ -1090,8 +1259,11 @@ bool Render_TitleScreen(int *state) {
 			gx3d_ClearViewport(gx3d_CLEAR_SURFACE | gx3d_CLEAR_ZBUFFER, color, gx3d_MAX_ZBUFFER_VALUE, 0);
 			// Start rendering in 3D
 			if (gx3d_BeginRender()) {
+				// Count the render state calls and transform updates of this frame
+				Render_State_Begin_Frame();
+				Transform_Begin_Frame();
 				// Set the default light
-				gx3d_SetAmbientLight(color3d_white);
+				Render_State_Ambient_Light(color3d_white);
 				// Set the default material
 				gx3d_SetMaterial(&material_default);
 				/*____________________________________________________________________
@@ -1112,42 +1284,42 @@ bool Render_TitleScreen(int *state) {
 				if (*state == STATE_TITLE_SCREEN) {
 					const float button_scale = 0.17;
 
-					layer = gx3d_GetObjectLayer(obj_billboards, "menu_button");
+					layer = layer_menu_button;
 					gx3d_GetScaleMatrix(&m1, button_scale, button_scale, button_scale);
 					gx3d_GetTranslateMatrix(&m2, -0.705, -0.078, 0);
 					gx3d_MultiplyMatrix(&m1, &m2, &m1);
-					gx3d_SetObjectLayerMatrix(obj_billboards, layer, &m1);
+					Transform_Set(obj_billboards, layer, &m1);
 
-					layer = gx3d_GetObjectLayer(obj_quit_button, "menu_button");
+					layer = layer_quit_button;
 					gx3d_GetScaleMatrix(&m1, button_scale, button_scale, button_scale);
 					gx3d_GetTranslateMatrix(&m2, -0.705, -0.23, 0);
 					gx3d_MultiplyMatrix(&m1, &m2, &m1);
-					gx3d_SetObjectLayerMatrix(obj_quit_button, layer, &m1);
+					Transform_Set(obj_quit_button, layer, &m1);
 
 					// Update transforms
-					gx3d_Object_UpdateTransforms(obj_billboards);
-					gx3d_Object_UpdateTransforms(obj_quit_button);
+					Transform_Update(obj_billboards);
+					Transform_Update(obj_quit_button);
 				}
 
 				// Draw the appropriate objects on screen
-				gx3d_DisableZBuffer();
-				gx3d_EnableAlphaBlending();
+				Render_State_Z_Buffer(false);
+				Render_State_Alpha_Blending(true);
 
 				// Title Screen Objects
 				if (*state == STATE_TITLE_SCREEN) {
-					layer = gx3d_GetObjectLayer(obj_billboards, "full_screen_l");
+					layer = layer_title_screen_l;
 					gx3d_SetTexture(0, tex_title_screen_l);
 					gx3d_DrawObjectLayer(layer, 0);
 
-					layer = gx3d_GetObjectLayer(obj_billboards, "full_screen_r");
+					layer = layer_title_screen_r;
 					gx3d_SetTexture(0, tex_title_screen_r);
 					gx3d_DrawObjectLayer(layer, 0);
 
 					// Draw elements that requires the use of texture matrix (changing of UV texture coords)
-					gx3d_EnableTextureMatrix(0);
+					Render_State_Texture_Matrix(true);
 
 					//=============== Start Game Button ===============//
-					layer = gx3d_GetObjectLayer(obj_billboards, "menu_button");
+					layer = layer_menu_button;
 					if (selection == 0) {
 						if (selected) {
 							gx3d_GetTranslateTextureMatrix(&m, 0, 1); // upper half of texture coords
@@ -1165,7 +1337,7 @@ bool Render_TitleScreen(int *state) {
 					gx3d_DrawObjectLayer(layer, 0);
 
 					//=============== Quit Game Button ===============//
-					layer = gx3d_GetObjectLayer(obj_quit_button, "menu_button");
+					layer = layer_quit_button;
 					if (selection == 1) {
 						if (selected) {
 							gx3d_GetTranslateTextureMatrix(&m, 0, 1); // upper half of texture coords
@@ -1182,17 +1354,17 @@ bool Render_TitleScreen(int *state) {
 					gx3d_SetTexture(0, tex_button_quit_game);
 					gx3d_DrawObjectLayer(layer, 0);
 
-					gx3d_DisableTextureMatrix(0);
+					Render_State_Texture_Matrix(false);
 				}
 
 				// Help Screen Objects
 				else {
-					layer = gx3d_GetObjectLayer(obj_billboards, "help_screen");
+					layer = layer_help_screen;
 					gx3d_SetTexture(0, tex_help_screen);
 					gx3d_DrawObjectLayer(layer, 0);
 				}
-				gx3d_DisableAlphaBlending();
-				gx3d_EnableZBuffer();
+				Render_State_Alpha_Blending(false);
+				Render_State_Z_Buffer(true);
 
 				// Restore view matrix
 				gx3d_SetViewMatrix(&view_save);
@@ -1205,6 +1377,10 @@ bool Render_TitleScreen(int *state) {
 			}
 		}
 	}
+	Report_Layer_Lookups("Title screen", lookups);
+	Render_State_Report("Title screen");
+	Transform_Report("Title screen");
+	Asset_Report("Title screen");
 	Free_TitleScreen();
 
 	return false; // continue to next screen
@@ -1228,99 +1404,50 @@ bool Render_GameScreen(int *state) {
 	// Variables
 	unsigned elapsed_time, last_time, new_time;
 	bool force_update, key_changed;
-	unsigned cmd_move;
-	float hp_bar_x_factor;
-	float ani_raiu_run_time, ani_raiu_entrance_time, ani_raiu_ending_time, entrance_delay_timer, entrance_delay_limit;
-	unsigned raiu_laser_delay_timer, raiu_laser_delay_limit, hoshu_laser_delay_timer, hoshu_laser_delay_limit;
-	unsigned game_ending_speed_timer, enemy_spawn_timer, spawn_timer_limit, heal_spawn_timer, heal_spawn_timer_limit;
-	bool speed_initialized, sfx_initialized, structure_created;
-	int hoshu_lv, current_max_enemy_count, enemy_count;
-	float speed, spd_multiplier, distance, ground_init_z, ground_1_z, ground_2_z;
-	float structure_interval, spawn_structure_distance, structure_spawn_chance, floor_light_distance, floor_light_interval;
-	int structure_index;
+	unsigned cmd_move, buttons;
 	int current_aim_x, current_aim_y;
 	float aim_x, aim_y;
 	float current_bgm_volume;
 	float explode_snd_min_distance, explode_snd_max_distance, laser_snd_min_distance, laser_snd_max_distance, fence_snd_min_distance, fence_snd_max_distance;
-	float raiu_laser_speed, hoshu_laser_speed, hoshu_laser_scale;
-	float enemy_spawn_chance, heal_spawn_chance;
-	int raiu_levels[MAX_LV], hoshu_levels[MAX_LV];
-	bool play_swing_1, play_swing_2, blade_active;
-	float swing_type, swing_active, level_up_fx_timer, heal_fx_timer;
-	float lerp_speed_duration, camera_lerp_duration;
-	gx3dVector billboard_normal, hoshu_normal, hoshu_view;
-	bool pause, snd_paused, restored, update_once;
-
-	// USED FOR DEBUGGING
-	bool stop = false; 
-
+	float swing_type, swing_active;
+	float camera_lerp_duration;
+	gx3dVector billboard_normal, center;
+	int transform;
+	bool pause, snd_paused, restored, update_once, intro_started, outro_started;
+	SimConfig sim_config;
+	SimInput sim_input;
+	const SimFrame *sim;
+	SimDraw sim_draw;
+	unsigned lookups = layer_lookups;
 
 	//========== Initial loop parameters ==========//
 	// Game variables
 	cmd_move =					0;
+	buttons =					0; // SIM_INPUT_* buttons currently pressed
 	last_time =					0;
 	force_update =				false;
 	sfx_volume =				90.0f;
 	current_bgm_volume =		60.0f;
-	distance =					0; // the amount of distance traveled based on the elapsed time (amount of shift performed in the world)
-	speed =						NORMAL_SPEED;
-	spd_multiplier =			1;
 	swing_type =				0.0;
-	score =						0;
 	current_aim_x =				0;
 	current_aim_y =				0;
-	enemies_defeated =			0; // number of enemies defeated so far
-	hoshus_defeated =			0; // number of Hoshus defeated so far
-	current_max_enemy_count =	MAX_ENEMY_COUNT / MAX_LV; // Increases depending on the max number of levels
-	enemy_count =				0; // number of enemies currently spawned
-	enemy_spawn_chance =		0.05f; // 5% chance of spawning an enemy for every loop after the spawn cooldown timer expires
-	heal_spawn_chance =			0.0001f; // hp > 75%: 0.01% chance of spawning for every loop || hp < 75%: 1% chance of spawning an electric fence for every loop				
 
 	// Vectors
 	billboard_normal =			{ 0,0,-1 };
-	hoshu_normal =				{ 0,0,-1 }; // normal view vector of the Hoshu model
 
 	// Timers
-	game_timer =				0.0f; // amount of time since the game has started
-	ani_raiu_run_time =			-1;
-	ani_raiu_entrance_time =	-1;
-	ani_raiu_ending_time =		-1;
-	game_ending_speed_timer =	0; // timer for the game ending state (used for "lerp-ing" the speed at the beginning of the state)
-	lerp_speed_duration =		2000; // duration of the game_ending_speed_timer
 	camera_lerp_duration =		500; // 0.5 seconds
-	entrance_delay_limit =		1000.0f; // 1 second entrance animation delay
-	entrance_delay_timer =		0;
-	raiu_laser_delay_limit =	250.0f; // 0.25 seconds
-	hoshu_laser_delay_limit =	1000.0f; // 1 second enemy laser delay	
-	spawn_timer_limit =			1000.0; // 1 second until able to spawn an object
-	enemy_spawn_timer =			spawn_timer_limit; // able to spawn an enemy after the game starts
-	heal_spawn_timer_limit =	60000; // 1 minute cooldown timer for an electric fence to spawn
-	heal_spawn_timer =			0;
-	level_up_fx_timer =			-1; // timer for the level up effect when the character levels up
-	heal_fx_timer = 			-1; // tiemr for the heal effect when the character regains health
 
 	// Booleans
-	sfx_initialized =			false;
-	play_swing_1 =				false;
-	play_swing_2 =				false;
-	blade_active =				false; // is the character swinging his blade?
-	speed_initialized =			false;
 	pause =						false; // is the game paused?
 	key_changed =				false; // is a key pressed while paused?
 	snd_paused =				false; // was a sound paused?
 	restored =					false; // was the game restored after context switching?
 	update_once =				false; // helper variable when restoring after context switching that ensures that the world updates once then pausing
-	
-	// World Parameters
-	ground_init_z =				-200;
-	ground_1_z =				ground_init_z;
-	ground_2_z =				ground_1_z + MAX_GROUND_LENGTH;
-	spawn_structure_distance =	0; // total distance traveled since the last spawned structure
-	structure_interval =		1000; // distance in feet that needs to be traveled before spawning a new structure
-	structure_spawn_chance =	0.10; // 10% spawn chance for a structure to spawn on every loop where spawn structure distance >= structure interval
-	structure_index =			0; // current index of the next structure element in the world structure array
-	//floor_light_distance =		0;
-	//floor_light_interval =		200;
+	intro_started =				false; // has the starting sound effect been played?
+	outro_started =				false; // has the self destruct sound effect been played?
+
+	// Sound Parameters
 	explode_snd_min_distance =	1000;
 	explode_snd_max_distance =	3000;
 	laser_snd_min_distance =	1500;
@@ -1328,75 +1455,36 @@ bool Render_GameScreen(int *state) {
 	fence_snd_min_distance =	500;
 	fence_snd_max_distance =	2000;
 
-	for (int i = 0; i < MAX_STRUCTURE_COUNT; i++)
-		structure[i].spawned = false; // world structures are updated and set to default values when being spawned dynamically
-
-	// Character Parameters
-	raiu.sphere =				obj_raiu->bound_sphere;
-	raiu.hp =					RAIU_MAX_HP;
-	raiu.blade_lv =				1;
-	raiu.blade_damage =			40 * raiu.blade_lv; // 10 blade levels : {40, 80, 120, 160, 200, 240, 280, 320, 360, 400}
-	raiu.blade_delay =			750; // each swings last for 0.75 second
-	raiu.blade_timer =			-1; // timer for blade swing (deactivated when value is at -1)
-	raiu.gun_lv =				1;
-	raiu.gun_damage =			25 * raiu.gun_lv; // 10 gun levels : {25, 50, 75, 100, 125, 150, 175, 200, 225, 250}
-	raiu.gun_delay =			raiu_laser_delay_limit; // 0.5 sec shooting delay
-	raiu.gun_timer =			raiu.gun_delay; // start off being able to shoot
-	raiu.exp =					0;
-	raiu.laser_index =			0;
-	raiu.light =				gx3d_InitLight(&light_data);
-	for (int i = 0; i < RAIU_MAX_LASER_COUNT; i++)
-		raiu.laser[i].draw =	false;
-	raiu_laser_speed =			1000.0; // 1000 ft per second
-	
-	// Enemy Parameters
-	hoshu_lv =					1;
-	for (int i = 0; i < MAX_ENEMY_COUNT; i++) {
-		enemies.hoshu[i].sphere =						obj_hoshu->bound_sphere;
-		enemies.hoshu[i].lv =							hoshu_lv;
-		enemies.hoshu[i].hp =							100 * enemies.hoshu[i].lv; // 10 hp levels : {100, 200, 300, 400, 500, 600, 700, 800, 900, 1000}
-		enemies.hoshu[i].score_amt =					200 * enemies.hoshu[i].lv; // 10 score levels : {200, 400, 600, 800, 1000, 1200, 1400, 1600, 1800, 2000}
-		enemies.hoshu[i].exp_amt =						100 * enemies.hoshu[i].lv; // 10 exp levels : {100, 200, 300, 400, 500, 600, 700, 800, 900, 1000}
-		enemies.hoshu[i].gun_delay =					hoshu_laser_delay_limit; // 1 sec shooting delay
-		enemies.hoshu[i].gun_timer =					enemies.hoshu[i].gun_delay; // Hoshu starts off being able to shoot
-		enemies.hoshu[i].gun_damage =					10 * enemies.hoshu[i].lv; // 10 gun levels : {10, 20, 30, 40, 50, 60, 70, 80, 90, 100}
-		enemies.hoshu[i].laser_index =					0;
-		enemies.hoshu[i].explosion_timer =				-1; // timer is off when set to -1
-		enemies.hoshu[i].blade_mark_1 =					false;
-		enemies.hoshu[i].blade_mark_2 =					false;
-		enemies.hoshu[i].explode_snd_initialized =		false;
-		enemies.hoshu[i].draw =							false; // Hoshu positions are updated and set to default values dynamically 
-		for (int j = 0; j < HOSHU_MAX_LASER_COUNT; j++)
-			enemies.hoshu[i].laser[j].draw =			false; // Hoshu lasers are updated and set to default values dynamically
-	}
-	enemies.hoshu_index =		0;
-	hoshu_laser_speed =			750.0; // 750 ft per second (slower than the character's laser speed to give the players time to react)
-	hoshu_laser_scale =			3;
-
-	// Level Up Parameters
-	for (int i = 0; i < MAX_LV; i++) {
-		if (i == 0) {
-			raiu_levels[i] =	1000; // Raiu first levels up after gaining 1000 exp
-			hoshu_levels[i] =	20; // Hoshus first levels up after defeating 20 of them
-		}
-		else {
-			raiu_levels[i] =	raiu_levels[i - 1] * 2; // 2x exponential increase in experience points required : {1000, 2000, 4000, 8000, 16000, 32000, 64000, 128000, 256000, 512000}
-			hoshu_levels[i] =	hoshu_levels[i - 1] * 2; // 4x exponential increase in number of Hoshus defeted until Hoshus level : {25, 50, 100, 200, 400, 800, 1600, 3200, 6400, 12800}
-		}
-	}
-
-	// Health Pad (Electric Fence) Parameters
-	heal_pad.pos =				{ 0, 0, 4000 }; // position of the electric fence in the world (changes dynamically)
-	heal_pad.heal_amt =			RAIU_MAX_HP * 0.25; // electric fence heal 25% of max health
-	heal_pad.ps_enable =		heal_pad.draw; // only enable the particle system when the health pad is drawn
-	heal_pad.light =			gx3d_InitLight(&light_data);
+	// Simulation Parameters
+	sim_config.raiu_sphere =	To_Sim_Sphere(&obj_raiu->bound_sphere);
+	sim_config.hoshu_sphere =	To_Sim_Sphere(&obj_hoshu->bound_sphere);
+	sim_config.laser_sphere =	To_Sim_Sphere(&obj_laser->bound_sphere);
+	sim_config.fence_sphere =	To_Sim_Sphere(&obj_fence->bound_sphere);
+	sim_config.boundary_x =		BOUNDARY_X;
+	sim_config.seed =			timeGetTime();
+	Sim_Init(&sim_config);
+
+	// The game is stepped on the simulation thread from here on
+	sim_input.buttons = 0;
+	sim_input.pos = { position.x, position.y, position.z };
+	sim_input.view = { heading.x, heading.y, heading.z };
+	sim_input.paused = false;
+	sim_input.intro_done = false;
+	sim_input.outro_done = false;
+	Sim_Thread_Start(&sim_input);
+	sim = Sim_Thread_Get_Frame(&sim_draw);
+	*state = sim->state;
+
+	// Lights
+	raiu_light =				gx3d_InitLight(&light_data);
+	heal_pad_light =			gx3d_InitLight(&light_data);
 
 	// Setup all sound effects
 	snd_SetSoundMode(s_explosion_1, snd_3D_MODE_ORIGIN_RELATIVE, snd_3D_APPLY_NOW);
 	snd_SetSoundMode(s_explosion_2, snd_3D_MODE_ORIGIN_RELATIVE, snd_3D_APPLY_NOW);
 	snd_SetSoundMode(s_explosion_3, snd_3D_MODE_ORIGIN_RELATIVE, snd_3D_APPLY_NOW);
 	snd_SetSoundMode(s_laser_2, snd_3D_MODE_ORIGIN_RELATIVE, snd_3D_APPLY_NOW);
-	snd_SetSoundMode(s_electric_fence, snd_3D_MODE_ORIGIN_RELATIVE, snd_3D_APPLY_NOW); 
+	snd_SetSoundMode(s_electric_fence, snd_3D_MODE_ORIGIN_RELATIVE, snd_3D_APPLY_NOW);
 	snd_SetSoundMinDistance(s_explosion_1, explode_snd_min_distance, snd_3D_APPLY_NOW);
 	snd_SetSoundMinDistance(s_explosion_2, explode_snd_min_distance, snd_3D_APPLY_NOW);
 	snd_SetSoundMinDistance(s_explosion_3, explode_snd_min_distance, snd_3D_APPLY_NOW);
@@ -1434,7 +1522,7 @@ bool Render_GameScreen(int *state) {
 
 		/*____________________________________________________________________
 		|
-		| Update clock and timers
+		| Update clock
 		|___________________________________________________________________*/
 
 		// Get the current time (# milliseconds since the game started)
@@ -1463,33 +1551,6 @@ bool Render_GameScreen(int *state) {
 			elapsed_time = new_time - last_time;
 		last_time = new_time;
 
-		// Update gameplay timer
-		if (*state == STATE_RUNNING) {
-			game_timer += elapsed_time;
-			// makes sure that the gameplay timer does not exceed 99 hours 59 minutes 59 seconds
-			if (game_timer > MAX_GAME_TIME)
-				game_timer = MAX_GAME_TIME;
-		}
-		else if (*state == STATE_GAME_ENDING)
-			game_ending_speed_timer += elapsed_time;
-
-		// Update spawn timers
-		if (enemy_spawn_timer < spawn_timer_limit)
-			enemy_spawn_timer += elapsed_time;
-
-		// Update cooldown timers
-		if (raiu.gun_timer < raiu.gun_delay)
-			raiu.gun_timer += elapsed_time;
-		for (int i = 0; i < MAX_ENEMY_COUNT; i++)
-			if (enemies.hoshu[i].draw)
-				if (enemies.hoshu[i].gun_timer < enemies.hoshu[i].gun_delay)
-					enemies.hoshu[i].gun_timer += elapsed_time;
-
-		// Update health pad spawn timer when timer is < its limit
-		if (heal_spawn_timer < heal_spawn_timer_limit) {
-			heal_spawn_timer += elapsed_time;
-		}
-
 		/*____________________________________________________________________
 		|
 		| Update camera view
@@ -1505,8 +1566,8 @@ bool Render_GameScreen(int *state) {
 			else if (*state == STATE_GAME_ENDING) {
 
 				// Ensures that the lerp stops after the timer had reached the duration limit
-				if ((camera_lerp_duration - game_ending_speed_timer) > 0)
-					Position_Lerp_Camera_Start(game_ending_speed_timer, camera_lerp_duration, &heading);
+				if ((camera_lerp_duration - sim->game_ending_speed_timer) > 0)
+					Position_Lerp_Camera_Start(sim->game_ending_speed_timer, camera_lerp_duration, &heading);
 				else
 					Position_Lerp_Camera_Start(camera_lerp_duration, camera_lerp_duration, &heading);
 
@@ -1523,79 +1584,11 @@ bool Render_GameScreen(int *state) {
 			snd_SetListenerOrientation(heading.x, heading.y, heading.z, 0, 1, 0, snd_3D_APPLY_NOW);
 		}
 
-		/*____________________________________________________________________
-		|
-		| Update world variables
-		|___________________________________________________________________*/
-
-		// update speed
-		if (*state == STATE_STARTING && !speed_initialized) {
-			speed = 0;
-			speed_initialized = true;
-		}
-		else if (*state == STATE_RUNNING)
-			speed = NORMAL_SPEED * spd_multiplier;
-		else if (*state == STATE_GAME_ENDING) {
-
-			// Speed gradually slows down at the beginning of game state game ending
-			if (spd_multiplier != 1) {
-				spd_multiplier = 1;
-				speed = NORMAL_SPEED;
-			}
-
-			if (lerp_speed_duration >= game_ending_speed_timer)
-				speed = Inverse_Lerp(NORMAL_SPEED, 0, (lerp_speed_duration - game_ending_speed_timer) / lerp_speed_duration);
-			else
-				speed = 0;
-		}
-
-		// distance travelled = ([speed -> (distance in feet / time in seconds)] * speed multiplier) * (elapsed time in milliseconds to seconds)
-		distance = (speed * spd_multiplier) * (elapsed_time / 1000.0f);
-
-		// update the character's position and heading
-		raiu.pos = position;
-		raiu.view = heading;
-
-		// update structures spawn distance
-		spawn_structure_distance += distance;
-
-		// update levels
-		if (raiu.exp >= raiu_levels[raiu.blade_lv] || raiu.exp >= raiu_levels[raiu.gun_lv]) {
-			// Update character parameters
-			raiu.blade_lv++;
-			raiu.blade_damage = 50 * raiu.blade_lv;
-			raiu.gun_lv++;
-			raiu.gun_damage = 25 * raiu.gun_lv;
-			raiu.gun_delay = raiu_laser_delay_limit; // 0.5 sec shooting delay
-			raiu.gun_timer = raiu.gun_delay; // start off being able to shoot
-			raiu.exp = 0;
-
-			// Activate the level up effects timer
-			level_up_fx_timer = 0;
-
-			// Increase max number of enemies that can appear on the screen
-			current_max_enemy_count += MAX_ENEMY_COUNT / MAX_LV;
-		}
-		if (hoshus_defeated >= hoshu_levels[hoshu_lv]) {
-			hoshu_lv++;
-			hoshus_defeated = 0;
-
-			// Play enemy level up sound effect
-			snd_PlaySound(s_enemy_lv_up, 0);
-		}
-
-		// update health pad spawn chance depending on the character's health
-		if (raiu.hp > RAIU_MAX_HP * 0.75) // 0.01% chance spawn rate for every loop after the cooldown timer expires
-			heal_spawn_chance = 0.0001;
-		else // 1% chance spawn rate for every loop after the cooldown timer expires
-			heal_spawn_chance = 0.01;
-
 		// set movement and the speed multiplier to default if key press changes are made after pausing
 		if (!pause && key_changed) {
 			cmd_move = 0;
-			spd_multiplier = 1;
+			buttons &= ~(SIM_INPUT_FAST | SIM_INPUT_SLOW);
 			snd_ResetSoundFrequency(s_footstep);
-			spawn_timer_limit = 1000;
 			key_changed = false;
 		}
 
@@ -1608,6 +1601,9 @@ bool Render_GameScreen(int *state) {
 		if (evGetEvent(&event)) {
 
 			if (event.type == evTYPE_WINDOW_INACTIVE) {
+				// Hold the simulation while the window is inactive
+				sim_input.paused = true;
+				Sim_Thread_Set_Input(&sim_input);
 				RESTORE_PROGRAM
 				pause = false;
 				restored = true;
@@ -1634,22 +1630,17 @@ bool Render_GameScreen(int *state) {
 						else
 							pause = true;
 					}
-					/* DEBUGGING : t - key to set the stop variable to true*/
-					/*else if (event.keycode == 't')
-						stop = true;*/
 
 					// Only update movement inputs when unpaused
 					else if (!pause) {
 
 						if (event.keycode == 'w') {
-							spd_multiplier = 1.75;
+							buttons |= SIM_INPUT_FAST;
 							snd_SetSoundFrequency(s_footstep, (snd_GetSoundFrequency(s_footstep)) * 1.75);
-							spawn_timer_limit /= 2;
 						}
 						else if (event.keycode == 's') {
-							spd_multiplier = 0.75;
+							buttons |= SIM_INPUT_SLOW;
 							snd_SetSoundFrequency(s_footstep, (snd_GetSoundFrequency(s_footstep)) * 0.75);
-							spawn_timer_limit *= 2;
 						}
 
 						if (event.keycode == 'a')
@@ -1670,18 +1661,16 @@ bool Render_GameScreen(int *state) {
 			// key release?
 			else if (event.type == evTYPE_RAW_KEY_RELEASE) {
 				if (*state == STATE_RUNNING) {
-					
+
 					// Only update movement inputs when unpaused
 					if (!pause) {
 						if (event.keycode == 'w') {
-							spd_multiplier = 1;
+							buttons &= ~SIM_INPUT_FAST;
 							snd_ResetSoundFrequency(s_footstep);
-							spawn_timer_limit *= 2;
 						}
 						else if (event.keycode == 's') {
-							spd_multiplier = 1;
+							buttons &= ~SIM_INPUT_SLOW;
 							snd_ResetSoundFrequency(s_footstep);
-							spawn_timer_limit /= 2;
 						}
 						else if (event.keycode == 'a')
 							cmd_move &= ~(POSITION_MOVE_LEFT);
@@ -1699,82 +1688,119 @@ bool Render_GameScreen(int *state) {
 
 			// Mouse press?
 			else if (event.type == evTYPE_MOUSE_LEFT_PRESS) {
-				if (*state == STATE_RUNNING) {
-					// Only read mouse inputs when unpaused
-					if (!pause) {
-
-						// Initialize local variables
-						float angle;
-
-						// Shoot a laser beam when cooldown timer for shooting the ray gun has expired
-						if (raiu.gun_timer >= raiu.gun_delay) {
-							if (!(raiu.laser[raiu.laser_index].draw)) {
-								// Reset the cooldown timer
-								raiu.gun_timer = 0;
-
-								// Play laser beam sound effect
-								snd_PlaySound(s_laser_1, 0);
-
-								// Initialize bounding sphere
-								raiu.laser[raiu.laser_index].sphere = obj_laser->bound_sphere;
-
-								// Set laser position and trajectory
-								raiu.laser[raiu.laser_index].pos = raiu.sphere.center;
-								raiu.laser[raiu.laser_index].pos.x += 1.0; // shift 1.0 ft to the right since the gun is on the right side of the camera view (NOT ALWAYS THE CASE SUCH AS WHEN TURNING LEFT OR RIGHT!.. but close enough)
-								raiu.laser[raiu.laser_index].sphere.center = raiu.laser[raiu.laser_index].pos;
-								raiu.laser[raiu.laser_index].trajectory.direction = raiu.view;
-								raiu.laser[raiu.laser_index].trajectory.velocity = raiu_laser_speed;
-
-								// Indicate that the laser should be drawn in the world
-								raiu.laser[raiu.laser_index].draw = true;
-
-								// Update to the next shootable laser
-								raiu.laser_index = (raiu.laser_index + 1) % RAIU_MAX_LASER_COUNT;
-							}
-						}
-					}
-				}
+				// Shoot the ray gun (only read mouse inputs when unpaused)
+				if (*state == STATE_RUNNING && !pause)
+					buttons |= SIM_INPUT_FIRE;
 			}
 
 			else if (event.type == evTYPE_MOUSE_RIGHT_PRESS) {
-				if (*state == STATE_RUNNING) {
-					// Only read mouse inputs when unpaused
-					if (!pause) {
-
-						// Activate swing timer if not yet activated
-						if (raiu.blade_timer == -1) {
-							raiu.blade_timer = 0;
-							swing_type = 0.0;
-							snd_PlaySound(s_blade_1, 0);
-							play_swing_1 = true;
-						}
-						if (play_swing_1) {
-
-							// Activate blade swing 2 when the key is pressed again after a certain time window
-							if (raiu.blade_timer >= 150 && raiu.blade_timer <= 350) {
-								if (!play_swing_2) {
-									swing_type = 1.0;
-									snd_PlaySound(s_blade_2, 0);
-									snd_PlaySound(s_raiu_grunt_1, 0);
-									play_swing_2 = true;
-								}
-							}
-						}
-					}
-				}
+				// Swing the blade (only read mouse inputs when unpaused)
+				if (*state == STATE_RUNNING && !pause)
+					buttons |= SIM_INPUT_SWING;
 			}
 		}
 
 		// Check for camera movement (via mouse) - flushes when game state is not "Running"
 		msGetMouseMovement(&move_x, &move_y);
 
+		/*____________________________________________________________________
+		|
+		| Update the game
+		|___________________________________________________________________*/
+
+		sim_input.buttons = buttons;
+		sim_input.pos = { position.x, position.y, position.z };
+		sim_input.view = { heading.x, heading.y, heading.z };
+		sim_input.paused = pause;
+		sim_input.intro_done = intro_started && !snd_IsPlaying(s_starting);
+		sim_input.outro_done = outro_started && !snd_IsPlaying(s_ending);
+		Sim_Thread_Set_Input(&sim_input);
+		sim = Sim_Thread_Get_Frame(&sim_draw);
+		*state = sim->state;
+
+		// Firing and swinging are only applied on the step they are pressed (the simulation keeps them until its next step)
+		buttons &= ~(SIM_INPUT_FIRE | SIM_INPUT_SWING);
+
+		// Play sounds and update lights for anything that happened since the last frame
+		SimEvent sim_event;
+		while (Sim_Thread_Get_Event(&sim_event)) {
+			const SimEvent *e = &sim_event;
+			switch (e->type) {
+			case SIM_EVENT_INTRO_START:
+				snd_PlaySound(s_starting, 0);
+				intro_started = true;
+				break;
+			case SIM_EVENT_OUTRO_START:
+				snd_PlaySound(s_ending, 0);
+				outro_started = true;
+				break;
+			case SIM_EVENT_RAIU_FIRE:
+				snd_PlaySound(s_laser_1, 0);
+				break;
+			case SIM_EVENT_BLADE_SWING_1:
+				swing_type = 0.0;
+				snd_PlaySound(s_blade_1, 0);
+				break;
+			case SIM_EVENT_BLADE_SWING_2:
+				swing_type = 1.0;
+				snd_PlaySound(s_blade_2, 0);
+				snd_PlaySound(s_raiu_grunt_1, 0);
+				break;
+			case SIM_EVENT_RAIU_HURT:
+				// Play a random raiu_hurt sfx
+				if (random_GetInt(1, 2) == 1)
+					snd_PlaySound(s_raiu_hurt_1, 0);
+				else
+					snd_PlaySound(s_raiu_hurt_2, 0);
+				break;
+			case SIM_EVENT_RAIU_LEVEL_UP:
+				snd_PlaySound(s_lv_up, 0);
+				break;
+			case SIM_EVENT_HOSHU_LEVEL_UP:
+				snd_PlaySound(s_enemy_lv_up, 0);
+				break;
+			case SIM_EVENT_HOSHU_FIRE:
+				snd_SetSoundPosition(s_laser_2, e->pos.x, e->pos.y, e->pos.z, snd_3D_APPLY_NOW);
+				snd_PlaySound(s_laser_2, 0);
+				break;
+			case SIM_EVENT_HOSHU_EXPLODE:
+				snd_SetSoundPosition(s_explosion_1, e->pos.x, e->pos.y, e->pos.z, snd_3D_APPLY_NOW);
+				snd_SetSoundPosition(s_explosion_2, e->pos.x, e->pos.y, e->pos.z, snd_3D_APPLY_NOW);
+				snd_SetSoundPosition(s_explosion_3, e->pos.x, e->pos.y, e->pos.z, snd_3D_APPLY_NOW);
+				if (e->index == 1) // explosion type
+					snd_PlaySound(s_explosion_1, 0);
+				else if (e->index == 2)
+					snd_PlaySound(s_explosion_2, 0);
+				else
+					snd_PlaySound(s_explosion_3, 0);
+				break;
+			case SIM_EVENT_EXPLOSION_END:
+				gx3d_DisableLight(explosion_light);
+				break;
+			case SIM_EVENT_HEAL_PAD_SPAWN:
+				// Set sound position and play the looping sound effect
+				snd_SetSoundPosition(s_electric_fence, e->pos.x, e->pos.y, e->pos.z, snd_3D_APPLY_NOW);
+				snd_PlaySound(s_electric_fence, 1);
+				break;
+			case SIM_EVENT_HEAL_PAD_TOUCH:
+				// Play the "nice" sound effect, disable the light and stop the electric fence sound effect
+				snd_PlaySound(s_raiu_nice, 0);
+				gx3d_DisableLight(heal_pad_light);
+				snd_StopSound(s_electric_fence);
+				break;
+			case SIM_EVENT_HEAL_PAD_DESPAWN:
+				snd_StopSound(s_electric_fence);
+				break;
+			}
+		}
+
 		/*____________________________________________________________________
 		|
 		| Draw graphics
 		|___________________________________________________________________*/
 
 		gx3d_SetFogColor(50, 50, 100);
-		gx3d_SetLinearPixelFog(2000, 3000);
+		gx3d_SetLinearPixelFog(GAME_FOG_START, GAME_FOG_END);
 
 		// Clear viewport
 		gx3d_ClearViewport(gx3d_CLEAR_SURFACE | gx3d_CLEAR_ZBUFFER, color, gx3d_MAX_ZBUFFER_VALUE, 0);
@@ -1784,215 +1810,140 @@ bool Render_GameScreen(int *state) {
 
 		// Start rendering in 3D
 		if (gx3d_BeginRender()) {
+			// Count the render state calls and transform updates of this frame
+			Render_State_Begin_Frame();
+			Transform_Begin_Frame();
 
-			// Set the default light
-			gx3d_SetAmbientLight(color3d_white);
-			// Set the default material
-			gx3d_SetMaterial(&material_structures);
+			const Raiu *raiu = &sim->raiu;
 
-			// Enable specular lighting for all objects
-			gx3d_EnableSpecularLighting();
+			// Enable Z Buffer
+			Render_State_Z_Buffer(true);
 
-			// Enable Alpha blending
-			gx3d_EnableAlphaBlending();
+			// Record the 3D draws (the draw list sets the projection, fog, blending, material and ambient light for them)
+			Draw_List_Begin(&position, &heading);
 
-			// Enable Z Buffer
-			gx3d_EnableZBuffer();
-			gx3d_DisableFog();
+			// Frustum of the world objects, ending where the fog hides everything
+			gx3dMatrix view;
+			gx3d_GetViewMatrix(&view);
+			Cull_Init_Frustum(&frustum, &view, GAME_FOV, (float)gxGetScreenWidth() / (float)gxGetScreenHeight(), GAME_NEAR_PLANE, GAME_FOG_END < GAME_DOME_FAR_PLANE ? GAME_FOG_END : GAME_DOME_FAR_PLANE);
+			cull_frames++;
 
 			/*____________________________________________________________________
 			|
 			| Draw 3D environment
 			|___________________________________________________________________*/
 
-			// Set the far plane to the game far plane
-			gx3d_SetProjectionMatrix(GAME_FOV, GAME_NEAR_PLANE, GAME_FAR_PLANE);
-
 			// Skydome - space
-			layer = gx3d_GetObjectLayer(obj_skydome, "skydome");
-			gx3d_GetTranslateMatrix(&m, raiu.pos.x, raiu.pos.y, raiu.pos.z);
-			gx3d_SetObjectLayerMatrix(obj_skydome, layer, &m);
-			gx3d_Object_UpdateTransforms(obj_skydome);
-			gx3d_SetTexture(0, tex_skydome);
-			gx3d_DrawObjectLayer(layer, 0);
-
-			// Skydome - earth
-			layer = gx3d_GetObjectLayer(obj_skydome, "earth");
-			gx3d_SetTexture(0, tex_earth);
-			gx3d_DrawObjectLayer(layer, 0);
+			layer = layer_skydome;
+			gx3d_GetTranslateMatrix(&m, raiu->pos.x, raiu->pos.y, raiu->pos.z);
+			transform = Draw_List_Transform(obj_skydome, layer, &m);
+			center = { raiu->pos.x, raiu->pos.y, raiu->pos.z };
+			Draw_List_Object(DRAW_PASS_SKY, DRAW_BLEND_ALPHA, DRAW_MATERIAL_SKY, tex_skydome, transform, obj_skydome, layer, &center);
+
+			// Skydome - earth (recorded after space, so its texture sorts after it)
+			layer = layer_earth;
+			Draw_List_Object(DRAW_PASS_SKY, DRAW_BLEND_ALPHA, DRAW_MATERIAL_SKY, tex_earth, transform, obj_skydome, layer, &center);
 
 			// Set lighting for the ground plane and structures
-			gx3d_SetAmbientLight(color3d_darkgray);
 			gx3d_EnableLight(dir_light);
-			
-			// Set the far plane to a shorter distance than the game far plane to show the other objects inside the skydome
-			gx3d_SetProjectionMatrix(GAME_FOV, GAME_NEAR_PLANE, 3500);
-
-			// Enable fog for the objects inside the skydome
-			gx3d_EnableFog();
-
-			// Translates the ground depending on the speed
-			// If the end of a ground object reaches 100 ft back from the character, it moves back to the end of the other ground object
-			if (ground_1_z <= (ground_init_z - MAX_GROUND_LENGTH)) {
-				gx3d_GetTranslateMatrix(&m2, 0, 0, ground_2_z -= distance);
-				gx3d_GetTranslateMatrix(&m1, 0, 0, ground_1_z = ground_2_z + MAX_GROUND_LENGTH);
-			}
-			else if (ground_2_z <= (ground_init_z - MAX_GROUND_LENGTH)) {
-				gx3d_GetTranslateMatrix(&m1, 0, 0, ground_1_z -= distance);
-				gx3d_GetTranslateMatrix(&m2, 0, 0, ground_2_z = ground_1_z + MAX_GROUND_LENGTH);
-			}
-			else {
-				gx3d_GetTranslateMatrix(&m1, 0, 0, ground_1_z -= distance);
-				gx3d_GetTranslateMatrix(&m2, 0, 0, ground_2_z -= distance);
-			}
-
-			// Set material for the ground object
-			gx3d_SetMaterial(&material_default);
 
 			// Draw two ground objects: one that is close to the camera and the other is connected to the end of the first one
 			for (int i = 0; i < 2; i++) {
 
-				// Ground - ground plane
-				layer = gx3d_GetObjectLayer(obj_ground, "ground");
-				if (i == 0)
-					gx3d_SetObjectLayerMatrix(obj_ground, layer, &m1);
-				else
-					gx3d_SetObjectLayerMatrix(obj_ground, layer, &m2);
-
-				// Update all transforms performed on both ground object
-				gx3d_Object_UpdateTransforms(obj_ground);
+				// Ground objects are placed in the world frame by the simulation
+				float ground_z = SIM_DRAW_Z(&sim_draw, i == 0 ? sim->ground_1_z : sim->ground_2_z);
+				gx3d_GetTranslateMatrix(&m, 0, 0, ground_z);
+				center = { 0, 0, ground_z + MAX_GROUND_LENGTH / 2 };
 
-				// Draw the transformed ground object
-				gx3d_SetTexture(0, tex_ground);
-				gx3d_DrawObjectLayer(layer, 0);
+				// Ground - ground plane
+				layer = layer_ground;
+				transform = Draw_List_Transform(obj_ground, layer, &m);
+				Draw_List_Object(DRAW_PASS_OPAQUE, DRAW_BLEND_ALPHA, DRAW_MATERIAL_GROUND, tex_ground, transform, obj_ground, layer, &center);
 
 				// Ground - inner : already a child of ground plane so no transformation needed
-				gx3d_SetTexture(0, tex_ground_inner);
-				layer = gx3d_GetObjectLayer(obj_ground, "inner");
-				gx3d_DrawObjectLayer(layer, 0);
+				layer = layer_ground_inner;
+				Draw_List_Object(DRAW_PASS_OPAQUE, DRAW_BLEND_ALPHA, DRAW_MATERIAL_GROUND, tex_ground_inner, transform, obj_ground, layer, &center);
 
 				// Ground - underground : already a child of ground plane so no transformation needed
-				gx3d_SetTexture(0, tex_ground_under);
-				layer = gx3d_GetObjectLayer(obj_ground, "underground");
-				gx3d_DrawObjectLayer(layer, 0);
+				layer = layer_ground_under;
+				Draw_List_Object(DRAW_PASS_OPAQUE, DRAW_BLEND_ALPHA, DRAW_MATERIAL_GROUND, tex_ground_under, transform, obj_ground, layer, &center);
 			}
 
-			// Set material for structures and disable specular lighting
-			gx3d_SetMaterial(&material_structures);
-			gx3d_DisableSpecularLighting();
-
-			// Generate a randomized structure in the world after a certain distance is reached
-			gx3d_SetAmbientLight(color3d_gray);
-			if (spawn_structure_distance >= structure_interval && !pause) {
-
-				// Generate a structure based on the spawn chance
-				if (structure_spawn_chance >= random_GetFloat()) {
-
-					// Initialize local variables
-					int r = random_GetInt(1, 4);
-					float spawn_distance_z = 4000; // always spawn new structures 4000 ft away from the character
-
-					// Spawn a random world structure
-					structure[structure_index].type = r;
-
-					// Set structure position and side depending on the generated structure type
-					if (r == 2) {// structure 2 takes up both left and right sides
-						structure[structure_index].side = STRUCTURE_SIDE_BOTH; // (0) both left and right sides
-					}
-					else if (random_GetFloat() > 0.5f) {
-						structure[structure_index].side = STRUCTURE_SIDE_LEFT; // (1) rotate model 180 degrees to move object to the left side
-						structure[structure_index].rotated = false; // indicate that the structure needs to be rotated to be on the left side
-					}
-					else {
-						structure[structure_index].side = STRUCTURE_SIDE_RIGHT; // (-1) original model is on the right side so no rotation needed
+			// Draw all spawned structures, one instanced draw per structure type and detail level
+			for (int type = 1; type <= 4; type++) {
+
+				// Bound the layer around the structure's position (whichever way it is rotated)
+				layer = layer_structure[0][type - 1];
+				float radius = gx3d_VectorMagnitude(&layer->bound_sphere.center) + layer->bound_sphere.radius;
+				Begin_Cull();
+				for (int i = 0; i < MAX_STRUCTURE_COUNT; i++) {
+					const World_Structures *structure = &sim->structure[i];
+					if (structure->spawned && structure->type == type)
+						Add_Cull_Bound({ structure->pos.x, structure->pos.y, SIM_DRAW_Z(&sim_draw, structure->pos.z) }, radius, i);
+					else if (!structure->spawned)
+						structure_lod[i] = 0;
+				}
+				Cull();
+
+				// Pick the detail level of every structure in view
+				for (int k = 0; k < cull_bounds.count; k++) {
+					if (CULL_VISIBLE(cull_bounds.visible, k)) {
+						gx3dVector pos = { cull_bounds.x[k], cull_bounds.y[k], cull_bounds.z[k] };
+						float size = Lod_Projected_Size(radius, Eye_Distance(&pos), GAME_FOV);
+						structure_lod[cull_bounds.index[k]] = Lod_Select(&lod_structures, size, structure_lod[cull_bounds.index[k]]);
 					}
-
-					structure[structure_index].pos = { 0, 0, spawn_distance_z };
-
-					// Indicate that the structure is currently spawned
-					structure[structure_index].spawned = true;
-
-					// Increment structure index by 1
-					structure_index = (structure_index + 1) % MAX_STRUCTURE_COUNT;
-
-					// Reset spawn structure distance to 0
-					spawn_structure_distance = 0;
 				}
-			}
 
-			// Update and draw all spawned structures
-			for (int i = 0; i < MAX_STRUCTURE_COUNT; i++) {
-				if (structure[i].spawned) {
+				for (int level = 0; level <= lod_structures.num_meshes; level++) {
 
 					// Initialize local variables
-					char* structure_name;
-
-					switch (structure[i].type) {
-					case 1: structure_name = "structure_1"; break;
-					case 2: structure_name = "structure_2"; break;
-					case 3: structure_name = "structure_3"; break;
-					case 4: structure_name = "structure_4"; break;
-					}
+					int count = 0;
+
+					for (int k = 0; k < cull_bounds.count; k++) {
+						if (!CULL_VISIBLE(cull_bounds.visible, k) || structure_lod[cull_bounds.index[k]] != level)
+							continue;
+						const World_Structures *structure = &sim->structure[cull_bounds.index[k]];
+
+						// Far away structures are impostors
+						if (level == lod_structures.num_meshes) {
+							gx3dVector pos = { cull_bounds.x[k], cull_bounds.y[k] + layer_structure[0][type - 1]->bound_sphere.center.y, cull_bounds.z[k] };
+							Queue_Impostor(tex_structure_impostor[type - 1], DRAW_MATERIAL_STRUCTURES, billboard_normal, pos, 2 * radius);
+							count++;
+							continue;
+						}
 
-					// Set the layer to the desired layer in the object file based on its name
-					layer = gx3d_GetObjectLayer(obj_structures, structure_name);
+						// Set matrix m to the identity matrix
+						gx3d_GetIdentityMatrix(&m);
 
-					// Set matrix m to the identity matrix
-					gx3d_GetIdentityMatrix(&m);
+						// Translate the object depending on the side
+						if (structure->side == STRUCTURE_SIDE_LEFT) {
+							if (!structure->rotated) {
+								gx3d_GetRotateYMatrix(&m, 180);
+							}
+							gx3d_GetTranslateMatrix(&m1, structure->pos.x, structure->pos.y, SIM_DRAW_Z(&sim_draw, structure->pos.z));
+							gx3d_MultiplyMatrix(&m, &m1, &m);
 
-					// Translate the object depending on the side and the distance traveled
-					structure[i].pos.z -= distance;
-					if (structure[i].side == STRUCTURE_SIDE_LEFT) {						
-						if (!structure[i].rotated) {
-							gx3d_GetRotateYMatrix(&m, 180);
 						}
-						gx3d_GetTranslateMatrix(&m1, structure[i].pos.x, structure[i].pos.y, structure[i].pos.z);
-						gx3d_MultiplyMatrix(&m, &m1, &m);
-						
-					}
-					else {
-						gx3d_GetTranslateMatrix(&m, structure[i].pos.x, structure[i].pos.y, structure[i].pos.z);
-					}
-
-					// Set a light depending on the structure type
-					if (structure_light[structure_index].world_structure_index == -1) { // light is currently not set to a structure
+						else {
+							gx3d_GetTranslateMatrix(&m, structure->pos.x, structure->pos.y, SIM_DRAW_Z(&sim_draw, structure->pos.z));
+						}
 
+						instance_matrix[count++] = m;
 					}
 
-					// Set object layer matrix to the structures object
-					gx3d_SetObjectLayerMatrix(obj_structures, layer, &m);
-
-					// Update the transformations
-					gx3d_Object_UpdateTransforms(obj_structures);
-
-					// Draw the spawned structure
-					gx3d_SetTexture(0, tex_structures);
-					gx3d_DrawObjectLayer(layer, 0);
-
+					// Draw the structures of this type at this level
+					if (level < lod_structures.num_meshes) {
+						layer = layer_structure[level][type - 1];
+						Draw_List_Instances(DRAW_PASS_OPAQUE, DRAW_BLEND_ALPHA, DRAW_MATERIAL_STRUCTURES, tex_structures, obj_structures_lod[level], 1, &layer, instance_matrix, count);
+					}
+					lod_drawn[level < lod_structures.num_meshes ? level : MAX_LOD_LEVELS] += count;
 				}
 			}
 
-			// Set ambient light to dim
-			gx3d_SetAmbientLight(color3d_dim);
-
 			//========== GAME STATE SPECIFIC CODE ==========//
 			// STATE: STARTING
 			if (*state == STATE_STARTING) {
 
-				// Set material to reflective and enable specular lighting
-				gx3d_SetMaterial(&material_raiu);
-				gx3d_EnableSpecularLighting();
-
-				// Add to entrance animation delay timer
-				if (entrance_delay_timer < entrance_delay_limit)
-					entrance_delay_timer += elapsed_time;
-
-				// Play opening animation
-				if (!sfx_initialized && entrance_delay_timer >= entrance_delay_limit) {
-					snd_PlaySound(s_starting, 0);
-					sfx_initialized = true;
-				}
-
 				// Fade in game bgm at starting
 				if (current_bgm_volume < bgm_volume)
 					snd_SetSoundVolume(s_game_bgm, (current_bgm_volume += 0.20f));
@@ -2001,74 +1952,43 @@ bool Render_GameScreen(int *state) {
 					snd_SetSoundVolume(s_game_bgm, bgm_volume);
 				}
 
-				// Start animation timer at first frame
-				if (ani_raiu_entrance_time == -1)
-					ani_raiu_entrance_time = 0;
-
-				// Add the elapsed frame time to the local timer for the animation
-				else if (entrance_delay_timer >= entrance_delay_limit)
-					ani_raiu_entrance_time += elapsed_time;
-
 				// Display and play entrance animation after the delay timer expires
-				if (entrance_delay_timer >= entrance_delay_limit) {
-
-					if (!snd_IsPlaying(s_starting) && sfx_initialized) {
-						*state = STATE_RUNNING;
-						sfx_initialized = false;
-					}
-
-					// Update speed after a certain amount of time in the animation
-					if (ani_raiu_entrance_time >= 2900.0f) {
-						if (speed == 0)
-							speed = NORMAL_SPEED * 5;
-						else if (ani_raiu_entrance_time >= 3200.0f)
-							speed = Inverse_Lerp(NORMAL_SPEED * 5, NORMAL_SPEED, (1000.0f - (ani_raiu_entrance_time - 3200.0f)) / 1000.0f);
-					}
+				if (sim->ani_raiu_entrance_time > 0) {
 
 					// Display and update an effect after a certain amount of time in the animation
 					float time_from = 500.0;
 					float time_to = 2900.0;
 					gx3dVector pos = { 0, 1.0, -1.0 };
 					gx3dVector scale = { 7.0f, 3.0f, 1.0f };
-					if (ani_raiu_entrance_time >= time_from && ani_raiu_entrance_time <= time_to) {
-						Play_FX(fx_run_charge, billboard_normal, pos, scale, time_to - time_from, ani_raiu_entrance_time, 100, true);
-						gx3d_SetAmbientLight(color3d_dim);
+					if (sim->ani_raiu_entrance_time >= time_from && sim->ani_raiu_entrance_time <= time_to) {
+						Queue_FX(fx_run_charge, billboard_normal, pos, scale, time_to - time_from, sim->ani_raiu_entrance_time, 100, true);
 						// Set character lighting to lightning blue and flicker when within the special effect time window
-						Update_Light(&raiu.light, lightning_blue, &pos, 300, elapsed_time, true);
-						gx3d_EnableLight(raiu.light);
+						Update_Light(&raiu_light, lightning_blue, &pos, 300, elapsed_time, true);
+						gx3d_EnableLight(raiu_light);
 					}
-					else if (ani_raiu_entrance_time > time_to) {
-						pos = { raiu.pos.x, raiu.sphere.center.y, raiu.sphere.center.z - 2 };
-						gx3d_DisableLight(raiu.light);
+					else if (sim->ani_raiu_entrance_time > time_to) {
+						pos = { raiu->pos.x, raiu->sphere.center.y, raiu->sphere.center.z - 2 };
+						gx3d_DisableLight(raiu_light);
 						// Set character lighting to blue cyan when time is after the special effect time window
-						Update_Light(&raiu.light, blue_cyan, &pos, 100, elapsed_time, false);
-						gx3d_EnableLight(raiu.light);
+						Update_Light(&raiu_light, blue_cyan, &pos, 100, elapsed_time, false);
+						gx3d_EnableLight(raiu_light);
 					}
 
 					// Update the animation based on the local timer
-					gx3d_Motion_Update(ani_raiu_entrance, ani_raiu_entrance_time / 1000.0f, false);
+					gx3d_Motion_Update(ani_raiu_entrance, sim->ani_raiu_entrance_time / 1000.0f, false);
 					gx3d_BlendTree_Update(btree_entrance);
 
 					// Transform character into world
-					raiu.sphere = obj_raiu->bound_sphere;
-					raiu.sphere.center.x = raiu.pos.x;
-					gx3d_GetTranslateMatrix(&m, raiu.pos.x, raiu.pos.y, raiu.pos.z);
-					gx3d_SetObjectMatrix(obj_raiu, &m);
-					gx3d_SetTexture(0, tex_raiu);
-					gx3d_DrawObject(obj_raiu, 0);
+					gx3d_GetTranslateMatrix(&m, raiu->pos.x, raiu->pos.y, raiu->pos.z);
+					transform = Draw_List_Transform(obj_raiu, 0, &m);
+					center = To_Gx3d_Vector(raiu->sphere.center);
+					Draw_List_Object(DRAW_PASS_OPAQUE, DRAW_BLEND_ALPHA, DRAW_MATERIAL_RAIU, tex_raiu, transform, obj_raiu, 0, &center);
 				}
-
-				// Disable specular lighting
-				gx3d_DisableSpecularLighting();
-				
 			}
 
 			// STATE: RUNNING
 			else if (*state == STATE_RUNNING) {
 
-				// Set ambient light to white
-				gx3d_SetAmbientLight(color3d_dim);
-
 				// Update sound effects depending when game is paused or unpaused
 				if (!pause) {
 					if (snd_paused) {
@@ -2088,814 +2008,101 @@ bool Render_GameScreen(int *state) {
 					}
 				}
 
-				// Spawn an electric fence (health pad)?
-				if (heal_spawn_timer >= heal_spawn_timer_limit && !pause) {
-					if (!heal_pad.draw) {
-						if (heal_spawn_chance >= random_GetFloat()) {
-							// spawn an electric fence with random x position with respect to the boundary
-							heal_pad.pos.x = random_GetFloat() * (BOUNDARY_X - 8) * 2 - (BOUNDARY_X - 8);
-							heal_pad.pos.y = 0; // always on top of the ground
-							heal_pad.pos.z = 3000.0; // always spawn 3000 ft away from the character
-							heal_pad.heal_amt = RAIU_MAX_HP * 0.25; // electric fence heal 25% of max health
-							heal_pad.sphere = obj_fence->bound_sphere;
-							heal_pad.draw = true;
-							heal_pad.ps_enable = true;
-
-							// Set sound position and play the looping sound effect
-							snd_SetSoundPosition(s_electric_fence, heal_pad.sphere.center.x, heal_pad.sphere.center.y, heal_pad.sphere.center.z, snd_3D_APPLY_NOW);
-							snd_PlaySound(s_electric_fence, 1);
-
-							// Update lighting position
-							gx3d_DisableLight(heal_pad.light);
-							Update_Light(&heal_pad.light, lightning_green, &heal_pad.sphere.center, 300, elapsed_time, true, 0, 0, 0.001);
-							gx3d_EnableLight(heal_pad.light);
-
-							// Reset timer
-							heal_spawn_chance = 0;
-						}
-					}
-				}
-
-				// Update the particle system and the electric fence when drawn
-				if (heal_pad.draw) {
-					// Check first if the current health pad is behind the camera and needs to be recycled
-					if (heal_pad.pos.z <= ground_init_z) { // Health pad is at or past the initial ground position
-						heal_pad.draw = false;
-						heal_pad.ps_enable = false;
-						
-						// Set timer to half of the limit
-						heal_spawn_timer = heal_spawn_timer_limit / 2;
-
-						// Stop the sound effect
-						snd_StopSound(s_electric_fence);
-					}
-
-					else {
-						// Update position
-						heal_pad.pos.z -= distance;
-						heal_pad.sphere.center.x = heal_pad.pos.x;
-						heal_pad.sphere.center.z = heal_pad.pos.z;
-
-						// Update 3D laser sound position (since the world is moving)
-						snd_SetSoundPosition(s_electric_fence, heal_pad.sphere.center.x, heal_pad.sphere.center.y, heal_pad.sphere.center.z, snd_3D_APPLY_NOW);
-
-						// Determine if the character has touched the pad
-						float x1, x2, y1, y2, z1, z2, d, total_sphere_radius;
-						x1 = raiu.sphere.center.x;
-						y1 = raiu.pos.y;
-						z1 = raiu.sphere.center.z;
-
-						x2 = heal_pad.pos.x;
-						y2 = heal_pad.pos.y;
-						z2 = heal_pad.pos.z;
-
-						// Calculate the distacne between the character and the health pad
-						d = sqrt((x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1) + (z2 - z1) * (z2 - z1));
+				// Draw the electric fence (health pad)
+				if (sim->heal_pad.draw) {
 
-						// Calculate the total sphere radius of both spheres
-						total_sphere_radius = raiu.sphere.radius + heal_pad.sphere.radius;
+					// Update 3D sound position (since the world is moving)
+					snd_SetSoundPosition(s_electric_fence, sim->heal_pad.sphere.center.x, sim->heal_pad.sphere.center.y, SIM_DRAW_Z(&sim_draw, sim->heal_pad.sphere.center.z), snd_3D_APPLY_NOW);
 
-						// Determine if the distance between the character and the health pad are close enough for the electric current to "touch" the character
-						if (abs(d) <= total_sphere_radius) {
-
-							// Add the heal ouput of the pad to the character's health
-							if (heal_fx_timer == -1) {
-								raiu.hp += heal_pad.heal_amt;
-								if (raiu.hp > RAIU_MAX_HP)
-									raiu.hp = RAIU_MAX_HP;
-								// Play the "nice" sound effect
-								snd_PlaySound(s_raiu_nice, 0);
-
-								// Activate the heal effect timer
-								heal_fx_timer = 0;
-
-								// Disable the particle system
-								heal_pad.ps_enable = false;
-
-								// Disable the light
-								gx3d_DisableLight(heal_pad.light);
-
-								// Stop sound effect
-								snd_StopSound(s_electric_fence);
-
-								// Reset the spawn timer
-								heal_spawn_timer = 0;
-							}
-						}
+					// Skip it while it is out of view or fully fogged
+					Begin_Cull();
+					Add_Cull_Bound({ sim->heal_pad.sphere.center.x, sim->heal_pad.sphere.center.y, SIM_DRAW_Z(&sim_draw, sim->heal_pad.sphere.center.z) }, sim->heal_pad.sphere.radius, 0);
+					Cull();
 
-						// Draw the electric fence
-						gx3d_GetTranslateMatrix(&m, heal_pad.pos.x, heal_pad.pos.y, heal_pad.pos.z);
-						gx3d_SetObjectMatrix(obj_fence, &m);
-						gx3d_SetTexture(0, tex_structures);
-						gx3d_DrawObject(obj_fence);
+					if (CULL_VISIBLE(cull_bounds.visible, 0)) {
+						gx3d_GetTranslateMatrix(&m, sim->heal_pad.pos.x, sim->heal_pad.pos.y, SIM_DRAW_Z(&sim_draw, sim->heal_pad.pos.z));
+						transform = Draw_List_Transform(obj_fence, 0, &m);
+						center = { sim->heal_pad.pos.x, sim->heal_pad.pos.y, SIM_DRAW_Z(&sim_draw, sim->heal_pad.pos.z) };
+						Draw_List_Object(DRAW_PASS_OPAQUE, DRAW_BLEND_ALPHA, DRAW_MATERIAL_FENCE, tex_structures, transform, obj_fence, 0, &center);
 					}
 				}
 
 				// Only update and draw the particle system when it is enabled
-				if (heal_pad.ps_enable) {
+				if (sim->heal_pad.ps_enable) {
 
 					// Update lighting position
-					gx3d_DisableLight(heal_pad.light);
-					Update_Light(&heal_pad.light, lightning_green, &heal_pad.sphere.center, 300, elapsed_time, true, 0, 0, 0.001);
-					gx3d_EnableLight(heal_pad.light);
+					v = To_Gx3d_Vector(sim->heal_pad.sphere.center);
+					v.z = SIM_DRAW_Z(&sim_draw, v.z);
+					gx3d_DisableLight(heal_pad_light);
+					Update_Light(&heal_pad_light, lightning_green, &v, 300, elapsed_time, true, 0, 0, 0.001);
+					gx3d_EnableLight(heal_pad_light);
 
 					// Get the object translate matrix
-					gx3d_SetAmbientLight(color3d_white);
-					gx3d_EnableAlphaTesting(50);
-					gx3d_GetTranslateMatrix(&m, heal_pad.pos.x, heal_pad.sphere.center.y + 2.09, heal_pad.pos.z + 4.6);
-					gx3d_SetParticleSystemMatrix(heal_pad.psys, &m);
-					gx3d_UpdateParticleSystem(heal_pad.psys, elapsed_time);
-					gx3d_DrawParticleSystem(heal_pad.psys, &heading, false);
-					gx3d_DisableAlphaTesting();
-				}
-
-				// Reset ambient light back to dim
-				gx3d_SetAmbientLight(color3d_dim);
-
-				// Spawn an enemy?
-				if (enemy_spawn_timer >= spawn_timer_limit && !pause) {
-					if (!(enemies.hoshu[enemies.hoshu_index].draw)) {
-						if (enemy_spawn_chance >= random_GetFloat()) {
-							// spawn a Hoshu with random x position with respect to the boundary
-							enemies.hoshu[enemies.hoshu_index].pos.x = random_GetFloat() * BOUNDARY_X * 2 - BOUNDARY_X; // left: -BOUNDARY_X | right: +BOUNDARY_X
-							enemies.hoshu[enemies.hoshu_index].pos.y = 0; // always spawn on top of the floor
-							enemies.hoshu[enemies.hoshu_index].pos.z = 3000.0; // always spawn at the front 3000 ft away from the character
-							enemies.hoshu[enemies.hoshu_index].sphere.radius = obj_hoshu->bound_sphere.radius;
-							enemies.hoshu[enemies.hoshu_index].sphere.center.x = enemies.hoshu[enemies.hoshu_index].pos.x;
-							enemies.hoshu[enemies.hoshu_index].sphere.center.y = obj_hoshu->bound_sphere.center.y;
-							enemies.hoshu[enemies.hoshu_index].sphere.center.z = enemies.hoshu[enemies.hoshu_index].pos.z;
-							enemies.hoshu[enemies.hoshu_index].lv = hoshu_lv;
-							enemies.hoshu[enemies.hoshu_index].hp = 100 * hoshu_lv;
-							enemies.hoshu[enemies.hoshu_index].score_amt = 200 * hoshu_lv;
-							enemies.hoshu[enemies.hoshu_index].exp_amt = 100 * hoshu_lv;
-							enemies.hoshu[enemies.hoshu_index].gun_delay = 1000.0f; // 1 sec shooting delay
-							enemies.hoshu[enemies.hoshu_index].gun_timer = 0.0f;
-							enemies.hoshu[enemies.hoshu_index].gun_damage = 10 * hoshu_lv;
-							enemies.hoshu[enemies.hoshu_index].fire_rate = random_GetFloat() * 0.1; // Generate a randomized fire rate between 0.0 - 0.5
-							enemies.hoshu[enemies.hoshu_index].laser_index = 0;
-							enemies.hoshu[enemies.hoshu_index].explosion_timer = -1;
-							enemies.hoshu[enemies.hoshu_index].explosion_type = -1;
-							enemies.hoshu[enemies.hoshu_index].explode_snd_initialized = false;
-							enemies.hoshu[enemies.hoshu_index].blade_mark_1 = false;
-							enemies.hoshu[enemies.hoshu_index].blade_mark_2 = false;
-							enemies.hoshu[enemies.hoshu_index].draw = true;
-
-							// Increment enemy count by 1
-							enemy_count++;
-
-							// Update to next enemy index
-							enemies.hoshu_index = (enemies.hoshu_index + 1) % current_max_enemy_count;
-
-							// Reset spawn timer
-							enemy_spawn_timer = 0;
-						}
-					}
-				}
-
-				// Update any spawned enemies and draw any newly spawned enemies
-				for (int i = 0; i < current_max_enemy_count; i++) {
-
-					// Set material for enemies and turn on specular lighting
-					gx3d_SetMaterial(&material_hoshu);
-					gx3d_EnableSpecularLighting();
-
-					// Draw the current Hoshu when it is spawned
-					if (enemies.hoshu[i].draw) {
-
-						// Initialize local variables
-						float angle;
-
-						// Check first if the current Hoshu is behind the camera and needs to be recycled
-						if (enemies.hoshu[i].pos.z <= ground_init_z) { // Hoshu is at or past the initial ground position
-							enemies.hoshu[i].explosion_timer = -1;
-							enemies.hoshu[i].explosion_type = -1;
-							enemies.hoshu[i].explode_snd_initialized = false;
-							enemies.hoshu[i].draw = false;
-
-							// Decrement enemy count to spawn new enemies
-							enemy_count--;
-						}
-
-						else {
-							// Update z position
-							enemies.hoshu[i].pos.z -= distance;
-							enemies.hoshu[i].sphere.center.z = enemies.hoshu[i].pos.z;
-
-							// Transform and draw into world
-							float pos_x = enemies.hoshu[i].pos.x;
-							float pos_y = enemies.hoshu[i].pos.y;
-							float pos_z = enemies.hoshu[i].pos.z;
-
-							// Update 3D laser sound position (since the world is moving)
-							snd_SetSoundPosition(s_laser_2, enemies.hoshu[i].sphere.center.x, enemies.hoshu[i].sphere.center.y, enemies.hoshu[i].sphere.center.z, snd_3D_APPLY_NOW);
-
-							// Determine if the Hoshu has taken damage from a blade swing
-							if (blade_active) {
-								float x1, x2, y1, y2, z1, z2, d, total_sphere_radius;
-								x1 = raiu.sphere.center.x;
-								y1 = raiu.sphere.center.y;
-								z1 = raiu.sphere.center.z;
-
-								x2 = enemies.hoshu[i].sphere.center.x;
-								y2 = enemies.hoshu[i].sphere.center.y;
-								z2 = enemies.hoshu[i].sphere.center.z;
-
-								// Calculate the distacne between the character and the enemy
-								d = sqrt((x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1) + (z2 - z1) * (z2 - z1));
-
-								// Calculate the total sphere radius of both spheres
-								total_sphere_radius = raiu.sphere.radius + enemies.hoshu[i].sphere.radius;
-
-								// Determine if the distance between the character and the Hoshu are close enough for the blade swing to be considered as a hit
-								if (abs(d) <= total_sphere_radius) {
-
-									// Subract the damage ouput of the blade to the Hoshu's health when its blade markers have not been set to true
-									if (play_swing_1) { // blade swing 1 is active (always active even when blade swing 2 is active)
-										if (!enemies.hoshu[i].blade_mark_1) {
-											enemies.hoshu[i].hp -= raiu.blade_damage;
-											enemies.hoshu[i].blade_mark_1 = true;
-										}
-										if (play_swing_2) { // blade swing 2 is active
-											if (!enemies.hoshu[i].blade_mark_2) {
-												enemies.hoshu[i].hp -= raiu.blade_damage;
-												enemies.hoshu[i].blade_mark_2 = true;
-											}
-										}
-									}
-
-									// Check if the Hoshu's health reaches 0
-									// Enemy is destroyed if its hp is at 0 or less
-									if (enemies.hoshu[i].explosion_timer == -1) {
-										if (enemies.hoshu[i].hp <= 0) {
-											// add the enemy score amount to the total score if the max score is not reached (sets it to max score when reached)
-											if (score != MAX_SCORE)
-												score += enemies.hoshu[i].score_amt;
-											else
-												score = MAX_SCORE;
-											// add the enemy exp amount to the character's total exp
-											raiu.exp += enemies.hoshu[i].exp_amt;
-
-											// increment enemies defeated and Hoshus defeated
-											enemies_defeated++;
-											hoshus_defeated++;
-											enemy_count--; // decrement enemy count by 1
-
-											// Initialize explosion timer on the enemy
-											enemies.hoshu[i].explosion_timer = 0;
-										}
-									}
-								}
-							}
-
-							// Reset blade damage markers for the Hoshu back to false when blade is inactive and both values are set to true
-							else {
-								if (enemies.hoshu[i].blade_mark_1)
-									enemies.hoshu[i].blade_mark_1 = false;
-								if (enemies.hoshu[i].blade_mark_2)
-									enemies.hoshu[i].blade_mark_2 = false;
-							}
-
-							// Play or update the explosion effect while the Hoshu was just destroyed
-							if (enemies.hoshu[i].explosion_timer >= 0) {
-
-								// Initialize local variables
-								gx3dVector scale = { 10, 10, 10 };
-								gx3dTexture fx_explosion;
-
-								// Set explosion light to the current destroyed Hoshu
-								Update_Light(&explosion_light, explosion_orange, &enemies.hoshu[i].sphere.center, Inverse_Lerp(100, 0, (FX_NORMAL_DURATION * enemies.hoshu[i].explosion_timer) / FX_NORMAL_DURATION), elapsed_time, true, 0, 0, 0.001);
-								gx3d_EnableLight(explosion_light);
-
-								// Generate a randomized explosion effect and sound
-								if (enemies.hoshu[i].explosion_type == -1) {
-									enemies.hoshu[i].explosion_type = random_GetInt(1, 3);
-								}
-
-								// Update 3D explosion sound positions
-								snd_SetSoundPosition(s_explosion_1, enemies.hoshu[i].sphere.center.x, enemies.hoshu[i].sphere.center.y, enemies.hoshu[i].sphere.center.z, snd_3D_APPLY_NOW);
-								snd_SetSoundPosition(s_explosion_2, enemies.hoshu[i].sphere.center.x, enemies.hoshu[i].sphere.center.y, enemies.hoshu[i].sphere.center.z, snd_3D_APPLY_NOW);
-								snd_SetSoundPosition(s_explosion_3, enemies.hoshu[i].sphere.center.x, enemies.hoshu[i].sphere.center.y, enemies.hoshu[i].sphere.center.z, snd_3D_APPLY_NOW);
-
-								if (enemies.hoshu[i].explosion_type == 1) {
-									if (!enemies.hoshu[i].explode_snd_initialized) {
-										snd_PlaySound(s_explosion_1, 0);
-										enemies.hoshu[i].explode_snd_initialized = true;
-										gx3d_MultiplyScalarVector(2, &scale, &scale); // doubles the scale
-									}
-									fx_explosion = fx_explosion_1;
-								}
-								else if (enemies.hoshu[i].explosion_type == 2) {
-									if (!enemies.hoshu[i].explode_snd_initialized) {
-										snd_PlaySound(s_explosion_2, 0);
-										enemies.hoshu[i].explode_snd_initialized = true;
-									}
-									fx_explosion = fx_explosion_2;
-								}
-								else {
-									if (!enemies.hoshu[i].explode_snd_initialized) {
-										snd_PlaySound(s_explosion_3, 0);
-										enemies.hoshu[i].explode_snd_initialized = true;
-									}
-									fx_explosion = fx_explosion_3;
-								}
-
-								// Display and update an effect after a certain amount of time in the animation
-								if (enemies.hoshu[i].explosion_timer <= FX_NORMAL_DURATION) {
-									Play_FX(fx_explosion, billboard_normal, enemies.hoshu[i].sphere.center, scale, FX_NORMAL_DURATION, enemies.hoshu[i].explosion_timer, 100, false);
-									gx3d_SetAmbientLight(color3d_dim);
-
-									// Update timer
-									enemies.hoshu[i].explosion_timer += elapsed_time;
-								}
-
-								// Resets explosion timer and sets draw to false when the explosion effect has finished
-								else {
-									enemies.hoshu[i].explosion_timer = -1;
-									enemies.hoshu[i].explosion_type == -1;
-									enemies.hoshu[i].explode_snd_initialized = false;
-									enemies.hoshu[i].draw = false;
-
-									// Disable the explosion light
-									gx3d_DisableLight(explosion_light);
-								}
-							}
-
-							// Continue displaying the Hoshu while not destroyed
-							else {
-								layer = gx3d_GetObjectLayer(obj_hoshu, "bottom");
-								gx3d_GetTranslateMatrix(&m1, pos_x, pos_y, pos_z);
-								gx3d_SetObjectLayerMatrix(obj_hoshu, layer, &m1);
-
-								// Set layer to the "top" layer of the Hoshu model
-								layer = gx3d_GetObjectLayer(obj_hoshu, "top");
-
-								// Update the Hoshu view vector to point at the character's xz-coordinates
-								hoshu_view.x = -(raiu.pos.x - enemies.hoshu[i].pos.x);
-								hoshu_view.y = 0;
-								hoshu_view.z = (raiu.pos.z - enemies.hoshu[i].pos.z);
-
-								// Compute angle between the two
-								angle = gx3d_AngleBetweenVectors(&hoshu_normal, &hoshu_view);
-								if ((hoshu_view.x - hoshu_normal.x) < 0)
-									angle *= -1;
-
-								// Make sure that angle of rotation does not exceed its max
-								if (angle >= 0 && angle > ROTATE_RIGHT_MAX)
-									angle = ROTATE_RIGHT_MAX;
-								else if (angle < 0 && angle < ROTATE_LEFT_MAX)
-									angle = ROTATE_LEFT_MAX;
-								gx3d_GetRotateYMatrix(&m1, angle);
-								gx3d_SetObjectLayerMatrix(obj_hoshu, layer, &m1);
-
-								// Update transformations
-								gx3d_Object_UpdateTransforms(obj_hoshu);
-
-								// Draw layers
-								gx3d_SetTexture(0, tex_hoshu);
-
-								layer = gx3d_GetObjectLayer(obj_hoshu, "bottom");
-								gx3d_DrawObjectLayer(layer, 0);
-
-								layer = gx3d_GetObjectLayer(obj_hoshu, "top");
-								gx3d_DrawObjectLayer(layer, 0);
-
-								// Make the enemy shoot a projectile?
-								if (enemies.hoshu[i].gun_timer >= enemies.hoshu[i].gun_delay && !pause) {
-									if (!(enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].draw)) {
-										if (enemies.hoshu[i].fire_rate >= random_GetFloat()) {
-
-											// Play laser beam sound effect
-											snd_SetSoundPosition(s_laser_2, enemies.hoshu[i].sphere.center.x, enemies.hoshu[i].sphere.center.y, enemies.hoshu[i].sphere.center.z, snd_3D_APPLY_NOW);
-											snd_PlaySound(s_laser_2, 0);
-
-											// Initialize bounding sphere and position
-											enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].sphere = obj_laser->bound_sphere;
-											enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].sphere.radius *= hoshu_laser_scale; // scales the Hoshu lasers' size
-											enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].pos = enemies.hoshu[i].pos;
-
-											// Set laser position and speed
-											enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].pos = enemies.hoshu[i].sphere.center;
-											enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].pos.y -= 0.5; // laser is 0.5 ft below the center of the Hoshu
-											enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].sphere.center.x = enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].pos.x;
-											enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].sphere.center.y = enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].pos.y;
-											enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].sphere.center.z = enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].pos.z;
-											enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].trajectory.velocity = hoshu_laser_speed;
-											enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].hit = false;
-
-											// Rotates the trajectory based on the rotation angle of the Hoshu's "top" model layer
-											v = { 0,0,-1 };
-											gx3d_GetRotateYMatrix(&m, angle);
-											gx3d_MultiplyVectorMatrix(&v, &m, &enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].trajectory.direction);
-
-											gx3d_NormalizeVector(&enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].trajectory.direction, &enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].trajectory.direction);
-
-											// Indicate that the laser should be drawn in the world
-											enemies.hoshu[i].laser[enemies.hoshu[i].laser_index].draw = true;
-
-											// Update to the next shootable laser
-											enemies.hoshu[i].laser_index = (enemies.hoshu[i].laser_index + 1) % HOSHU_MAX_LASER_COUNT;
-
-											// Reset the cooldown timer
-											enemies.hoshu[i].gun_timer = 0;
-										}
-									}
-								}
-							}
-						}
-					}
-
-					// Disable specular lighting for the lasers and set material for red laser
-					gx3d_DisableSpecularLighting();
-					gx3d_SetMaterial(&material_red_laser);
-
-					// Update any lasers fired by each Hoshu that is drawn in the world
-					for (int j = 0; j < HOSHU_MAX_LASER_COUNT; j++) {
-						if (enemies.hoshu[i].laser[j].draw) {
-
-							// Initialize local variables
-							float x1, y1, z1, x2, y2, z2, d;
-							float total_laser_distance;
-
-							// Enable alpha blending and set ambient light to white
-							gx3d_DisableAlphaBlending();
-							gx3d_SetAmbientLight(color3d_white);
-
-							// Slow down laser movement when destroyed
-							if (enemies.hoshu[i].laser[j].destroyed && enemies.hoshu[i].laser[j].trajectory.velocity == hoshu_laser_speed)
-								enemies.hoshu[i].laser[j].trajectory.velocity *= 0.10;
-
-							// Calculate the distance traveled by the projectile based on the elapsed time
-							total_laser_distance = (enemies.hoshu[i].laser[j].trajectory.velocity) * (elapsed_time / 1000.0f);
-
-							// Don't draw if projectile goes beyond the initial ground position
-							if (abs(enemies.hoshu[i].laser[j].pos.x) >= 1000, abs(enemies.hoshu[i].laser[j].pos.y) >= 1000, abs(enemies.hoshu[i].laser[j].pos.z) >= MAX_PROJECTILE_DISTANCE) {
-								enemies.hoshu[i].laser[j].hit_timer = -1;
-								enemies.hoshu[i].laser[j].draw = false;
-
-								// Reset all laser variables to initial values
-								enemies.hoshu[i].laser[j].distance = { 0, 0, 0 };
-								enemies.hoshu[i].laser[j].sphere = obj_laser->bound_sphere;
-								enemies.hoshu[i].laser[j].pos = enemies.hoshu[i].pos;
-								enemies.hoshu[i].laser[j].world_shift = 0;
-								enemies.hoshu[i].laser[j].destroyed = false;
-								enemies.hoshu[i].laser[j].trajectory = { {0, 0, -1}, 0 };
-							}
-
-							// Display the laser or the hit effect otherwise
-							else {
-
-								// Calculate distance between the enemy projectile and the character
-								x1 = enemies.hoshu[i].laser[j].sphere.center.x;
-								y1 = 0; //enemies.hoshu[i].laser[j].sphere.center.y;
-								z1 = enemies.hoshu[i].laser[j].sphere.center.z;
-
-								x2 = raiu.sphere.center.x;
-								y2 = 0; //raiu.sphere.center.y;
-								z2 = raiu.sphere.center.z;
-
-								// distance = sqrt((x2-x2)^2 + (y2-y1)^2 + (z2-z1)^2)
-								d = sqrt(((x2 - x1) * (x2 - x1)) + ((y2 - y1) * (y2 - y1)) + ((z2 - z1) * (z2 - z1)));
-
-								// Detect if the laser hits the character
-								// Collides if the distance is less than the radius of the character's bounding sphere
-								if (d <= raiu.sphere.radius * 2) { // projectile has collided with the character
-									if (abs(x2 - x1) <= raiu.sphere.radius) {
-
-										// PLAY LASER HIT SOUND FX???
-
-										// Destroy the laser if blade is active on the time of impact
-										if (blade_active)
-											enemies.hoshu[i].laser[j].destroyed = true;
-
-										// Character gets damaged otherwise
-										if (!enemies.hoshu[i].laser[j].hit && !enemies.hoshu[i].laser[j].destroyed) {
-
-											// Play a random raiu_hurt sfx and a laser hit sfx
-											int r = random_GetInt(1, 2);
-											if (r == 1) 
-												snd_PlaySound(s_raiu_hurt_1, 0);
-											else 
-												snd_PlaySound(s_raiu_hurt_2, 0);
-
-											// Subract the damage output of the gun to the character's health
-											raiu.hp -= enemies.hoshu[i].gun_damage;
-
-											// State switches to "Game Ending" if the character's hp is at 0 or less
-											if (raiu.hp <= 0) {
-												*state = STATE_GAME_ENDING;
-											}
-											enemies.hoshu[i].laser[j].hit = true;
-											enemies.hoshu[i].laser[j].destroyed = false;
-										}
-
-										// Activate the laser hit timer
-										enemies.hoshu[i].laser[j].hit_timer = 0;
-									}
-								}
-
-								// Play or update the laser hit effect while the laser had just hit an object
-								if (enemies.hoshu[i].laser[j].hit_timer >= 0) {
-
-									// Initialize local variables
-									gx3dVector scale = { 4, 4, 4 };
-									gx3dVector pos;
-
-									// Set effect position
-									if (enemies.hoshu[i].laser[j].destroyed)
-										pos = { enemies.hoshu[i].laser[j].pos.x, enemies.hoshu[i].laser[j].pos.y, enemies.hoshu[i].laser[j].pos.z };
-									else
-										pos = { raiu.pos.x, raiu.sphere.center.y, raiu.pos.z + 1 };
-
-									// Display and update an effect after a certain amount of time in the animation
-									if (enemies.hoshu[i].laser[j].hit_timer <= FX_NORMAL_DURATION) {
-										Play_FX(fx_laser_red, billboard_normal, pos, scale, FX_NORMAL_DURATION / 2.0f, enemies.hoshu[i].laser[j].hit_timer, 100, false);
-										gx3d_SetAmbientLight(color3d_dim);
-
-										// Update timer
-										enemies.hoshu[i].laser[j].hit_timer += elapsed_time;
-									}
-
-									// Resets the timer and sets draw to false when the hit effect has finished
-									else {
-										enemies.hoshu[i].laser[j].hit_timer = -1;
-										enemies.hoshu[i].laser[j].draw = false;
-
-										// Reset all laser variables to initial values
-										enemies.hoshu[i].laser[j].distance = { 0, 0, 0 };
-										enemies.hoshu[i].laser[j].sphere = obj_laser->bound_sphere;
-										enemies.hoshu[i].laser[j].pos = enemies.hoshu[i].pos;
-										enemies.hoshu[i].laser[j].world_shift = 0;
-										enemies.hoshu[i].laser[j].destroyed = false;
-										enemies.hoshu[i].laser[j].trajectory = { {0, 0, -1}, 0 };
-									}
-								}
-
-								else {
-
-									// Translate to world then draw
-									gx3d_GetTranslateMatrix(&m1, enemies.hoshu[i].laser[j].sphere.center.x, enemies.hoshu[i].laser[j].pos.y, enemies.hoshu[i].laser[j].pos.z);
-									gx3d_GetScaleMatrix(&m2, hoshu_laser_scale, hoshu_laser_scale, hoshu_laser_scale);
-									gx3d_MultiplyMatrix(&m2, &m1, &m);
-									gx3d_SetObjectMatrix(obj_laser, &m);
-									gx3d_SetTexture(0, tex_red_laser);
-									gx3d_DrawObject(obj_laser, 0);
-
-								}
-
-								// Update laser position based on the total laser distance traveled
-								gx3d_MultiplyScalarVector(total_laser_distance, &enemies.hoshu[i].laser[j].trajectory.direction, &v);
-								gx3d_AddVector(&enemies.hoshu[i].laser[j].pos, &v, &enemies.hoshu[i].laser[j].pos);
-								enemies.hoshu[i].laser[j].sphere.center.x = enemies.hoshu[i].laser[j].pos.x;
-								enemies.hoshu[i].laser[j].sphere.center.y = enemies.hoshu[i].laser[j].pos.y;
-								enemies.hoshu[i].laser[j].sphere.center.z = enemies.hoshu[i].laser[j].pos.z;
-							}
-
-							// Reset the light to dark gray
-							gx3d_SetAmbientLight(color3d_darkgray);
-							gx3d_EnableAlphaBlending();
-						}
-					}
+					gx3d_GetTranslateMatrix(&m, sim->heal_pad.pos.x, sim->heal_pad.sphere.center.y + 2.09, SIM_DRAW_Z(&sim_draw, sim->heal_pad.pos.z) + 4.6);
+					gx3d_SetParticleSystemMatrix(heal_pad_psys, &m);
+					gx3d_UpdateParticleSystem(heal_pad_psys, elapsed_time);
+					center = { sim->heal_pad.pos.x, sim->heal_pad.sphere.center.y + 2.09f, SIM_DRAW_Z(&sim_draw, sim->heal_pad.pos.z) + 4.6f };
+					Draw_List_Particles(DRAW_MATERIAL_PARTICLES, heal_pad_psys, &m, &heading, 50, &center);
 				}
 
-				// Set material to blue laser
-				gx3d_SetMaterial(&material_blue_laser);
-
-				// Update any lasers fired by the character and is drawn in the world
-				for (int i = 0; i < RAIU_MAX_LASER_COUNT; i++) {
-
-					// Draw lasers that are currently in the world
-					if (raiu.laser[i].draw) {
-
-						// Initialize local variables
-						gx3dRay ray;
+				// Draw all spawned enemies and their lasers
+				Draw_Hoshus(sim, &sim_draw, billboard_normal, elapsed_time);
 
-						gx3d_NormalizeVector(&raiu.laser[i].trajectory.direction, &ray.direction);
-						ray.origin = raiu.laser[i].sphere.center;
+				// Draw any lasers fired by the character
+				const Projectiles *projectiles = &sim->projectiles;
+				int num_lasers = 0;
+				Begin_Cull();
+				for (int i = 0; i < projectiles->used; i++) {
 
-						// Enable alpha blending and set ambient light to white
-						gx3d_DisableAlphaBlending();
-						gx3d_SetAmbientLight(color3d_white);
+					if (projectiles->live[i] AND projectiles->owner[i] == PROJECTILE_OWNER_RAIU) {
 
-						// Don't draw if maximum distance is reached
-						if (abs(raiu.laser[i].pos.x) >= MAX_PROJECTILE_DISTANCE || abs(raiu.laser[i].pos.y) >= MAX_PROJECTILE_DISTANCE || raiu.laser[i].pos.z >= MAX_PROJECTILE_DISTANCE) {
-
-							// Reset all laser variables to initial values
-							raiu.laser[i].distance = { 0, 0, 0 };
-							raiu.laser[i].sphere = obj_laser->bound_sphere;
-							raiu.laser[i].pos = raiu.sphere.center;
-							raiu.laser[i].world_shift = 0;
-							raiu.laser[i].trajectory = { raiu.view, 0 };
-							raiu.laser[i].hit = false;
-							raiu.laser[i].hit_index = -1;
-							raiu.laser[i].hit_timer = -1;
-							raiu.laser[i].draw = false;
-						}
-
-						// Display the laser otherwise
-						else {
+						// Display the laser hit effect while its timer is active
+						if (projectiles->hit_timer[i] >= 0) {
 
 							// Initialize local variables
-							int j;
-
-							// Calculate the distance traveled by the projectile based on the elapsed time
-							// the projectile direction vector multiplied by the distance traveled by the projectile based on the elapsed time in seconds
-							if (!pause) { // only update laser position when unpaused
-								gx3d_MultiplyScalarVector((raiu.laser[i].trajectory.velocity) * (elapsed_time / 1000.0f), &raiu.laser[i].trajectory.direction, &v);
-								gx3d_AddVector(&raiu.laser[i].distance, &v, &raiu.laser[i].distance);
-								raiu.laser[i].world_shift += distance;
-								raiu.laser[i].pos.x += raiu.laser[i].distance.x;
-								raiu.laser[i].pos.y += raiu.laser[i].distance.y;
-								raiu.laser[i].pos.z += raiu.laser[i].distance.z - raiu.laser[i].world_shift;
-								raiu.laser[i].sphere.center = raiu.laser[i].pos;
-							}
-							else {
+							gx3dVector scale = { 8, 8, 8 };
+							gx3dVector pos = Projectile_Position(sim, &sim_draw, i);
 
+							// Show it on the enemy that was hit while it is still around
+							if (projectiles->target[i] >= 0) {
+								const simSphere *target = &sim->enemies.sphere[projectiles->target[i]];
+								pos = { target->center.x, target->center.y, SIM_DRAW_Z(&sim_draw, target->center.z) - 5 };
 							}
 
-							if (raiu.laser[i].hit)
-								j = raiu.laser[i].hit_index;
-							else
-								j = 0;
-
-							// Detect if the laser hits an enemy
-							for (; j < current_max_enemy_count; j++) {
-								if (enemies.hoshu[j].draw) {
-
-									// Initialize local variables
-									gx3dTrajectory enemy_trajectory, laser_trajectory;
-									float collision_time;
-
-									enemy_trajectory.direction = { 0, 0, -1 }; // all enemies move straight from the front to the back of the character
-									enemy_trajectory.velocity = speed * spd_multiplier;
-									laser_trajectory = raiu.laser[i].trajectory;
-
-									// Detect collision between two moving spheres
-									relation = gx3d_Collide_Sphere_Sphere(&raiu.laser[i].sphere, &laser_trajectory, SECONDS, &enemies.hoshu[j].sphere, &enemy_trajectory, &collision_time);
-									if (relation != gxRELATION_OUTSIDE || (raiu.laser[i].hit && raiu.laser[i].hit_index == j)) { // projectile will interesect with the enemy
-										if (!raiu.laser[i].hit) {
-											raiu.laser[i].hit = true;
-											raiu.laser[i].hit_index = j;
-										}
-
-										// Detected a hit and the laser had already intersected with the target
-										if (collision_time <= 0.0 && raiu.laser[i].hit_timer == -1 && enemies.hoshu[j].explosion_timer == -1) {
-
-											// PLAY LASER HIT SOUND FX???
-
-											// Subract the damage output of the laser to the enemy's health
-											enemies.hoshu[j].hp -= raiu.gun_damage;
-
-											// Enemy is destroyed if its hp is at 0 or less
-											if (enemies.hoshu[j].hp <= 0) {
-
-												// add the enemy score amount to the total score if the max score is not reached (sets it to max score when reached)
-												if (score != MAX_SCORE)
-													score += enemies.hoshu[j].score_amt;
-												else
-													score = MAX_SCORE;
-												// add the enemy exp amount to the character's total exp
-												raiu.exp += enemies.hoshu[j].exp_amt;
-
-												// increment enemies defeated and Hoshus defeated
-												enemies_defeated++;
-												hoshus_defeated++;
-												enemy_count--; // decrement enemy count by 1
-
-												// Initialize explosion timer on the enemy
-												enemies.hoshu[j].explosion_timer = 0;
-											}
-
-											// Activate laser hit timer otherwise
-											else {
-												if (raiu.laser[i].hit_timer == -1)
-													raiu.laser[i].hit_timer = 0;
-											}
-										}
-									}
-								}
-								
-								// Update laser hit effect while the timer is active
-								if (raiu.laser[i].hit_timer >= 0) {
-
-									// Initialize local variables
-									gx3dVector scale = { 8, 8, 8 };
-									gx3dVector pos;
-
-									pos = { enemies.hoshu[j].sphere.center.x, enemies.hoshu[j].sphere.center.y, enemies.hoshu[j].sphere.center.z - 5 };
-
-									// Display and update an effect after a certain amount of time in the animation
-									if (raiu.laser[i].hit_timer <= FX_NORMAL_DURATION) {
-										Play_FX(fx_laser_blue, billboard_normal, pos, scale, FX_NORMAL_DURATION / 2.0f, raiu.laser[i].hit_timer, 100, false);
-										gx3d_SetAmbientLight(color3d_dim);
-
-										// Update timer
-										raiu.laser[i].hit_timer += elapsed_time;
-									}
-									else {
-
-										// Reset all laser variables to initial values
-										raiu.laser[i].distance = { 0, 0, 0 };
-										raiu.laser[i].sphere = obj_laser->bound_sphere;
-										raiu.laser[i].pos = raiu.sphere.center;
-										raiu.laser[i].world_shift = 0;
-										raiu.laser[i].trajectory = { raiu.view, 0 };
-										raiu.laser[i].hit = false;
-										raiu.laser[i].hit_index = -1;
-										raiu.laser[i].hit_timer = -1;
-										raiu.laser[i].draw = false;
-									}
-								}
-
-								// Continue displaying laser otherwise
-								else {
-
-									// Translate to world then draw
-									gx3d_GetTranslateMatrix(&m, raiu.laser[i].sphere.center.x, raiu.laser[i].sphere.center.y, raiu.laser[i].sphere.center.z);
-									gx3d_SetObjectMatrix(obj_laser, &m);
-									gx3d_SetTexture(0, tex_blue_laser);
-									gx3d_DrawObject(obj_laser, 0);
-								}
-
-								// Break off from the enemy search loop when the laser indicates a hit
-								if (raiu.laser[i].hit)
-									break;
-							}
+							Queue_FX(fx_laser_blue, billboard_normal, pos, scale, FX_NORMAL_DURATION / 2.0f, projectiles->hit_timer[i], 100, false);
 						}
 
-						// Reset the light to dark gray
-						gx3d_SetAmbientLight(color3d_darkgray);
-						gx3d_EnableAlphaBlending();
+						// Continue displaying laser otherwise (drawn without alpha blending)
+						else
+							Add_Cull_Bound(Projectile_Position(sim, &sim_draw, i), projectiles->radius[i], i);
 					}
 				}
 
-				// Set material for the character and enable specular lighting
-				gx3d_SetMaterial(&material_raiu);
-				gx3d_EnableSpecularLighting();
-
-				// Play or update level up effect when its timer is active
-				if (level_up_fx_timer >= 0) {
-					
-					// Play the level up sound effect once when the timer was just activated
-					if (level_up_fx_timer == 0)
-						snd_PlaySound(s_lv_up, 0);
-
-					Play_FX(fx_level_up, billboard_normal, raiu.sphere.center, { 5, 5, 5 }, FX_NORMAL_DURATION, level_up_fx_timer, 100, false);
-					gx3d_SetAmbientLight(color3d_dim);
-
-					// Deactivate timer when its duration is reached
-					if (level_up_fx_timer >= FX_NORMAL_DURATION)
-						level_up_fx_timer = -1;
-
-					// Update the timer otherwise
-					else
-						level_up_fx_timer += elapsed_time;
+				// Translate the lasers in view to world
+				Cull();
+				for (int k = 0; k < cull_bounds.count; k++) {
+					if (CULL_VISIBLE(cull_bounds.visible, k))
+						gx3d_GetTranslateMatrix(&instance_matrix[num_lasers++], cull_bounds.x[k], cull_bounds.y[k], cull_bounds.z[k]);
 				}
 
-				// Play the running animation, with looping
-				// If this is the start of the animation (anim_time == -1) then set the local timer for the animation to 0
-				if (ani_raiu_run_time == -1)
-					ani_raiu_run_time = 0;
-				// Add the elapsed frame time to the local timer for the animation
-				else
-					ani_raiu_run_time += elapsed_time;
+				// Draw the lasers in flight all at once
+				Draw_List_Instances(DRAW_PASS_OPAQUE, DRAW_BLEND_NONE, DRAW_MATERIAL_BLUE_LASER, tex_blue_laser, obj_laser, 0, 0, instance_matrix, num_lasers);
+
+				// Play level up effect when its timer is active
+				if (sim->level_up_fx_timer >= 0)
+					Queue_FX(fx_level_up, billboard_normal, To_Gx3d_Vector(raiu->sphere.center), { 5, 5, 5 }, FX_NORMAL_DURATION, sim->level_up_fx_timer, 100, false);
 
 				// Update the animation based on the local timer
-				gx3d_Motion_Update(ani_raiu_run, (ani_raiu_run_time / 1000.0f) * spd_multiplier, true); // update run animation speed depending on the speed multiplier
+				gx3d_Motion_Update(ani_raiu_run, (sim->ani_raiu_run_time / 1000.0f) * sim->spd_multiplier, true); // update run animation speed depending on the speed multiplier
 				gx3d_Motion_Update(ani_raiu_aim_up, (30.0f / 1000.0f) * 21, true);
 				gx3d_Motion_Update(ani_raiu_aim_down, (30.0f / 1000.0f) * 21, true);
 				gx3d_Motion_Update(ani_raiu_aim_left, (30.0f / 1000.0f) * 21, true);
 				gx3d_Motion_Update(ani_raiu_aim_right, (30.0f / 1000.0f) * 21, true);
 
-				// Update blade swing timer and animations only if it is active
-				if (raiu.blade_timer >= 0) {
-
-					// Set blade to active on a specific time window depending on the type of blade swing animation
-					if (play_swing_1 && !play_swing_2) {
-						if (raiu.blade_timer <= 300)
-							blade_active = true;
-						else
-							blade_active = false;
-					}
-					else if (play_swing_2) {
-						if (raiu.blade_timer <= 400)
-							blade_active = true;
-						else
-							blade_active = false;
-					}
-
-					// Deactivate swing timer when its time limit is reached
-					if (raiu.blade_timer >= raiu.blade_delay) {
-						raiu.blade_timer = -1;
-						play_swing_1 = false;
-						play_swing_2 = false;
-					}
-					
-					// Update timer and animation otherwise
-					else {
-						raiu.blade_timer += elapsed_time;
-						gx3d_Motion_Update(ani_raiu_swing_1, (raiu.blade_timer / 1000.0f), false);
-						gx3d_Motion_Update(ani_raiu_swing_2, (raiu.blade_timer / 1000.0f), false);
-					}
+				// Update blade swing animations only if the swing timer is active
+				if (raiu->blade_timer >= 0) {
+					gx3d_Motion_Update(ani_raiu_swing_1, (raiu->blade_timer / 1000.0f), false);
+					gx3d_Motion_Update(ani_raiu_swing_2, (raiu->blade_timer / 1000.0f), false);
 				}
 
 				// Get percent of rotation x and y from its max values for use in blending aim animations below
@@ -2916,11 +2123,11 @@ bool Render_GameScreen(int *state) {
 					aim_y = 0.5;
 
 				// Activate blade swing animation while its timer is active
-				if (raiu.blade_timer >= 0) {
+				if (raiu->blade_timer >= 0) {
 					swing_active = 1.0;
 
 					// Determine if blade swing type is currently blade swing 1 or blade swing 2
-					if (!play_swing_2)
+					if (!sim->play_swing_2)
 						swing_type = 0.0; // swing 1 animation
 					else
 						swing_type = 1.0; // swing 2 animation
@@ -2940,44 +2147,31 @@ bool Render_GameScreen(int *state) {
 				gx3d_BlendTree_Update(btree_movement);
 
 				// Play a special effect if the character has regained health
-				if (heal_fx_timer >= 0 && heal_fx_timer < FX_NORMAL_DURATION * 2) {
-					v = { raiu.pos.x, raiu.sphere.center.y - 2, raiu.pos.z - 1 };
-					Play_FX(fx_run_charge, billboard_normal, v, { 7, 3, 1 }, FX_NORMAL_DURATION, heal_fx_timer, 100, true);
-					gx3d_SetAmbientLight(color3d_dim);
+				if (sim->heal_fx_timer >= 0) {
+					v = { raiu->pos.x, raiu->sphere.center.y - 2, raiu->pos.z - 1 };
+					Queue_FX(fx_run_charge, billboard_normal, v, { 7, 3, 1 }, FX_NORMAL_DURATION, sim->heal_fx_timer, 100, true);
 					// Set character lighting to lightning blue and flicker when within the special effect time window
-					Update_Light(&raiu.light, lightning_blue, &v, 300, elapsed_time, true);
-					gx3d_EnableLight(raiu.light);
-
-					 // update the timer
-					heal_fx_timer += elapsed_time;
-				}
-				else if (heal_fx_timer >= FX_NORMAL_DURATION) {
-					v = { raiu.pos.x, raiu.sphere.center.y, raiu.sphere.center.z - 2 };
-					gx3d_DisableLight(raiu.light);
-					// Set character lighting to blue cyan when time is after the special effect time window
-					Update_Light(&raiu.light, blue_cyan, &v, 100, elapsed_time, false);
-					gx3d_EnableLight(raiu.light);
-					// Deactivate the heal timer
-					heal_fx_timer = -1;
+					Update_Light(&raiu_light, lightning_blue, &v, 300, elapsed_time, true);
+					gx3d_EnableLight(raiu_light);
 				}
 				else {
-					// Update character lighting otherwise
-					gx3dVector light_pos = { raiu.pos.x, raiu.sphere.center.y, raiu.sphere.center.z - 2 };
-					gx3d_DisableLight(raiu.light);
-					Update_Light(&raiu.light, blue_cyan, &light_pos, 100, elapsed_time, false);
-					gx3d_EnableLight(raiu.light);
+					// Set character lighting to blue cyan otherwise
+					gx3dVector light_pos = { raiu->pos.x, raiu->sphere.center.y, raiu->sphere.center.z - 2 };
+					gx3d_DisableLight(raiu_light);
+					Update_Light(&raiu_light, blue_cyan, &light_pos, 100, elapsed_time, false);
+					gx3d_EnableLight(raiu_light);
 				}
 
 				// Transform character into world
-				raiu.sphere = obj_raiu->bound_sphere;
-				raiu.sphere.center.x = raiu.pos.x;
-				gx3d_GetTranslateMatrix(&m, raiu.pos.x, raiu.pos.y, raiu.pos.z);
-				gx3d_SetObjectMatrix(obj_raiu, &m);
-				gx3d_SetTexture(0, tex_raiu);
-				gx3d_DrawObject(obj_raiu, 0);
-
-				// Disable specular lighting and set default material for 2d graphics
-				gx3d_DisableSpecularLighting();
+				gx3d_GetTranslateMatrix(&m, raiu->pos.x, raiu->pos.y, raiu->pos.z);
+				transform = Draw_List_Transform(obj_raiu, 0, &m);
+				center = To_Gx3d_Vector(raiu->sphere.center);
+				Draw_List_Object(DRAW_PASS_OPAQUE, DRAW_BLEND_ALPHA, DRAW_MATERIAL_RAIU, tex_raiu, transform, obj_raiu, 0, &center);
+
+				// Draw the 3D world before the 2D graphics go on top of it
+				Draw_List_Execute();
+
+				// Set default material for 2d graphics
 				gx3d_SetMaterial(&material_default);
 
 				/*____________________________________________________________________
@@ -2994,280 +2188,65 @@ bool Render_GameScreen(int *state) {
 				gx3d_CameraSetPosition(&tfrom, &tto, &twup, gx3d_CAMERA_ORIENTATION_LOOKTO_FIXED);
 				gx3d_CameraSetViewMatrix();
 
-				// Local Variables
-				const float scale_hp = 0.25;
-				const float scale_hp_fonts = 0.04;
-				const float scale_weapons_lv = 0.40;
-				const float scale_weapon_lv_fonts = 0.08;
-				const float scale_scorebar = 0.12;
-				const float scale_score_fonts = 0.08;
-
-				const float hp_font_spacing = 0.04;
-				const float hp_x = -1.40;
-				const float hp_y = -0.75;
-				float hp_font_x = -1.38;
-				const float hp_font_y = -0.77;
-
-				const float weapon_lv_font_spacing = 0.08;
-				const float weapon_lv_x = 1.40;
-				const float weapon_lv_y = -0.60;
-				float weapon_lv_font_x = 1.45;
-				float weapon_lv_font_y = -0.73;
-
-				const float score_font_spacing = 0.08;
-				const float scorebar_x = 1.25;
-				const float scorebar_y = 0.78;
-				float score_font_x = 0.97;
-				const float score_font_y = 0.78;
-
-				char hp_buf[MAX_HP_FONTS + 1];
-				char hp_full_buf[MAX_HP_FONTS * 2 + 1];
-				char lv_buf[MAX_LV_FONTS + 1];
-				char lv_full_buf[MAX_LV_FONTS * 2 + 1];
-				char score_buf[MAX_SCORE_FONTS + 1];
-				int dgt_ctr_1, dgt_ctr_2;
-				int incr;
-
-				// Update HP
-				hp_bar_x_factor = (float)(raiu.hp) / (float)(RAIU_MAX_HP);
-
-				//========== HP setup ==========//
-				layer = gx3d_GetObjectLayer(obj_hud, "hp");
-				gx3d_GetScaleMatrix(&m1, scale_hp, scale_hp, scale_hp);
-				gx3d_GetTranslateMatrix(&m2, hp_x, hp_y, 0);
-				gx3d_MultiplyMatrix(&m1, &m2, &m);
-				gx3d_SetObjectLayerMatrix(obj_hud, layer, &m);
-
-				// HP Bar
-				layer = gx3d_GetObjectLayer(obj_hud, "hp_bar");
-				gx3d_GetScaleMatrix(&m1, (scale_hp * hp_bar_x_factor), scale_hp, scale_hp);
-				gx3d_GetTranslateMatrix(&m2, hp_x, hp_y, 0);
-				gx3d_MultiplyMatrix(&m1, &m2, &m);
-				gx3d_SetObjectLayerMatrix(obj_hud, layer, &m);
-
-				// HP Fonts
-				gx3d_GetScaleMatrix(&m1, scale_hp_fonts, scale_hp_fonts, scale_hp_fonts);
-				for (int i = 0; i < MAX_HP_FONTS * 2; i++) {
-					layer = gx3d_GetObjectLayer(obj_hp_fonts[i], "score_fonts");
-					// first four digits (Current HP)
-					if (i < MAX_HP_FONTS) {
-						if (i == 0) // first digit of current hp
-							gx3d_GetTranslateMatrix(&m2, hp_font_x, hp_font_y, 0);
-						else
-							gx3d_GetTranslateMatrix(&m2, hp_font_x += hp_font_spacing, hp_font_y, 0);
-					}
-					// last four digits (Max HP)
-					else {
-						if (i == MAX_HP_FONTS) // first digit of max hp
-							gx3d_GetTranslateMatrix(&m2, hp_font_x += hp_font_spacing * 1.5, hp_font_y, 0);
-						else
-							gx3d_GetTranslateMatrix(&m2, hp_font_x += hp_font_spacing, hp_font_y, 0);
+				// Rebuild the parts of the HUD whose values have changed
+				Update_HUD(sim);
 
-					}
-					gx3d_MultiplyMatrix(&m1, &m2, &m);
-					gx3d_SetObjectLayerMatrix(obj_hp_fonts[i], layer, &m);
-					gx3d_Object_UpdateTransforms(obj_hp_fonts[i]);
-				}
+				// Draw the appropriate objects on screen
+				Render_State_Z_Buffer(false);
+				Render_State_Alpha_Blending(true);
+				// Set the default light
+				Render_State_Ambient_Light(color3d_white);
 
-				//========== Weapons Lv setup ==========//
-				// Weapons Lv
-				layer = gx3d_GetObjectLayer(obj_hud, "weapons_lv");
-				gx3d_GetScaleMatrix(&m1, scale_weapons_lv, scale_weapons_lv, scale_weapons_lv);
-				gx3d_GetTranslateMatrix(&m2, weapon_lv_x, weapon_lv_y, 0);
-				gx3d_MultiplyMatrix(&m1, &m2, &m);
-				gx3d_SetObjectLayerMatrix(obj_hud, layer, &m);
-
-				// Weapons Lv Fonts
-				gx3d_GetScaleMatrix(&m1, scale_weapon_lv_fonts, scale_weapon_lv_fonts, scale_weapon_lv_fonts);
-				for (int i = 0; i < MAX_LV_FONTS * 2; i++) {
-					layer = gx3d_GetObjectLayer(obj_weapon_lv_fonts[i], "score_fonts");
-					// first two digits (gun lv)
-					if (i < MAX_LV_FONTS) {
-						if (i == 0) // first digit of gun lv
-							gx3d_GetTranslateMatrix(&m2, weapon_lv_font_x, weapon_lv_font_y, 0);
-						else
-							gx3d_GetTranslateMatrix(&m2, weapon_lv_font_x += weapon_lv_font_spacing, weapon_lv_font_y, 0);
-					}
-					// last two digits (blade lv)
-					else {
-						if (i == MAX_LV_FONTS) // first digit of blade lv
-							gx3d_GetTranslateMatrix(&m2, weapon_lv_font_x -= (weapon_lv_font_spacing * (MAX_LV_FONTS - 1)), weapon_lv_font_y += 0.19, 0);
-						else
-							gx3d_GetTranslateMatrix(&m2, weapon_lv_font_x += weapon_lv_font_spacing, weapon_lv_font_y, 0);
+				// Draw elements that requires the use of texture matrix (changing of UV texture coords)
+				Render_State_Texture_Matrix(true);
 
-					}
-					gx3d_MultiplyMatrix(&m1, &m2, &m);
-					gx3d_SetObjectLayerMatrix(obj_weapon_lv_fonts[i], layer, &m);
-					gx3d_Object_UpdateTransforms(obj_weapon_lv_fonts[i]);
-				}
-
-				//========== Score setup ==========//
-				// Score Bar
-				layer = gx3d_GetObjectLayer(obj_hud, "score_bar");
-				gx3d_GetScaleMatrix(&m1, scale_scorebar * 1.5, scale_scorebar, scale_scorebar);
-				gx3d_GetTranslateMatrix(&m2, scorebar_x, scorebar_y, 0);
-				gx3d_MultiplyMatrix(&m1, &m2, &m);
-				gx3d_SetObjectLayerMatrix(obj_hud, layer, &m);
-
-				// Score Fonts
-				gx3d_GetScaleMatrix(&m1, scale_score_fonts, scale_score_fonts, scale_score_fonts);
-				for (int i = 0; i < MAX_SCORE_FONTS; i++) {
-					layer = gx3d_GetObjectLayer(obj_score_fonts[i], "score_fonts");
-
-					if (i == 0) // first digit of score
-						gx3d_GetTranslateMatrix(&m2, score_font_x, score_font_y, 0);
-					else
-						gx3d_GetTranslateMatrix(&m2, score_font_x += score_font_spacing, score_font_y, 0);
-
-					gx3d_MultiplyMatrix(&m1, &m2, &m);
-					gx3d_SetObjectLayerMatrix(obj_score_fonts[i], layer, &m);
-					gx3d_Object_UpdateTransforms(obj_score_fonts[i]);
-				}
-
-				// Update transforms
-				gx3d_Object_UpdateTransforms(obj_hud);
-
-				// Draw the appropriate objects on screen
-				gx3d_DisableZBuffer();
-				gx3d_EnableAlphaBlending();
-				// Set the default light
-				gx3d_SetAmbientLight(color3d_white);
-
-				// Draw elements that requires the use of texture matrix (changing of UV texture coords)
-				gx3d_EnableTextureMatrix(0);
-
-				//========== HP display ==========//
 				// HP background
-				if (raiu.hp > RAIU_MAX_HP * 0.25) // green when hp is >25%
-					gx3d_GetTranslateTextureMatrix(&m, 0, 1); // upper half of texture coords
-				else // red when hp is <=25%
-					gx3d_GetTranslateTextureMatrix(&m, 0, 0.5); // lower half of texture coords
-				layer = gx3d_GetObjectLayer(obj_hud, "hp");
-				gx3d_SetTextureMatrix(0, &m);
+				gx3d_SetTextureMatrix(0, &hud.hp_texture);
 				gx3d_SetTexture(0, tex_hp);
-				gx3d_DrawObjectLayer(layer, 0);
+				gx3d_DrawObjectLayer(layer_hp, 0);
 
 				// HP bar
-				layer = gx3d_GetObjectLayer(obj_hud, "hp_bar");
 				gx3d_SetTexture(0, tex_hp_bar);
-				gx3d_DrawObjectLayer(layer, 0);
-
-				// HP fonts
-				incr = 1;
-				dgt_ctr_1 = 0;
-				dgt_ctr_2 = 0;
-				itoa(raiu.hp, hp_buf, 10);		// convert integer to char array (string)
-				strcpy(hp_full_buf, hp_buf);	// copy current hp string to a larger buffer
-				itoa(RAIU_MAX_HP, hp_buf, 10);	// reuse the smaller buffer to store the max hp string
-				strcat(hp_full_buf, hp_buf);	// concatenate both strings using the larger buffer
-				if (raiu.hp == 0) // ensures that there is at least 1 digit displayed for the current hp when it reaches 0
-					dgt_ctr_1++;
-				else {
-					while (raiu.hp / incr != 0) { // counts the number of digits in the current hp
-						dgt_ctr_1++;
-						incr *= 10;
-					}
-				}
-				dgt_ctr_1 += MAX_HP_FONTS;
-				Display_Fonts(obj_hp_fonts, hp_full_buf, dgt_ctr_1, MAX_HP_FONTS * 2, m, tex_fonts, false);	// display the fonts on screen
-				gx3d_DisableTextureMatrix(0);
+				gx3d_DrawObjectLayer(layer_hp_bar, 0);
+				Render_State_Texture_Matrix(false);
 
-				//========== Weapon Lv display ==========//
 				// Weapons Lv background
-				layer = gx3d_GetObjectLayer(obj_hud, "weapons_lv");
 				gx3d_SetTexture(0, tex_weapons_lv);
-				gx3d_DrawObjectLayer(layer, 0);
-
-				// Weapon Lv fonts
-				incr = 1;
-				dgt_ctr_1 = 0;
-				dgt_ctr_2 = 0;
-				gx3d_EnableTextureMatrix(0);
-				itoa(raiu.gun_lv, lv_buf, 10);		// convert integer to char array (string)
-				strcpy(lv_full_buf, lv_buf);	// copy gun lv string to a larger buffer
-				itoa(raiu.blade_lv, lv_buf, 10);		// reuse the smaller buffer to store the blade lv string
-
-				if (raiu.gun_lv == 0)
-					dgt_ctr_1++;
-				else
-					while (raiu.gun_lv / incr != 0) { // counts the number of digits in gun_lv
-						dgt_ctr_1++;
-						incr *= 10;
-					}
-				incr = 1;
-
-				if (raiu.blade_lv == 0)
-					dgt_ctr_2++;
-				else
-					while (raiu.blade_lv / incr != 0) { // counts the number of digits in blade_lv
-						dgt_ctr_2++;
-						incr *= 10;
-					}
+				gx3d_DrawObjectLayer(layer_weapons_lv, 0);
 
-				// concatenate '0's to the larger buffer if the number of digits in the second set are less than its max number of digits
-				if (dgt_ctr_2 < MAX_LV_FONTS) {
-					string str = "";
-					int zero_ctr = MAX_LV_FONTS - dgt_ctr_2;
-					for (int i = 0; i < zero_ctr; i++) {
-						str += "0";
-						dgt_ctr_1++;
-					}
-					strcat(lv_full_buf, str.c_str());
-				}
-				strcat(lv_full_buf, lv_buf);	// concatenate both strings using the larger buffer
-				dgt_ctr_1 += dgt_ctr_2;
-				Display_Fonts(obj_weapon_lv_fonts, lv_full_buf, dgt_ctr_1, MAX_LV_FONTS * 2, m, tex_fonts, true);	// display the fonts on screen
-				gx3d_DisableTextureMatrix(0);
-
-				//========== Score display ==========//
 				// Score Bar
-				layer = gx3d_GetObjectLayer(obj_hud, "score_bar");
 				gx3d_SetTexture(0, tex_score_bar);
-				gx3d_DrawObjectLayer(layer, 0);
+				gx3d_DrawObjectLayer(layer_score_bar, 0);
 
-				// Score Fonts
-				incr = 1;
-				dgt_ctr_1 = 0;
-				gx3d_EnableTextureMatrix(0);
-				itoa(score, score_buf, 10);		// convert integer to char array (string)
-
-				if (score == 0)
-					dgt_ctr_1++;
-				else
-					while (score / incr != 0) { // counts the number of digits in score
-						dgt_ctr_1++;
-						incr *= 10;
-					}
+				// All the fonts at once, on top of the backgrounds
+				Render_State_Texture_Matrix(true);
+				Glyphs_Draw(&hud.glyphs, obj_fonts, layer_fonts, tex_fonts);
+				Render_State_Texture_Matrix(false);
 
-				Display_Fonts(obj_score_fonts, score_buf, dgt_ctr_1, MAX_SCORE_FONTS, m, tex_fonts, true);	// display the fonts on screen
-				gx3d_DisableTextureMatrix(0);
-
-				gx3d_DisableAlphaBlending();
-				gx3d_EnableZBuffer();
+				Render_State_Alpha_Blending(false);
+				Render_State_Z_Buffer(true);
 
 				// Restore view matrix
 				gx3d_SetViewMatrix(&view_save);
 			}
 
-			// STATE: GAME ENDING
-			else if (*state == STATE_GAME_ENDING) {
 
-				// Set lighting to dim
-				gx3d_SetAmbientLight(color3d_dim);
+			// STATE: GAME ENDING (and the last frame before the game over screen)
+			else if (*state == STATE_GAME_ENDING || *state == STATE_GAME_OVER) {
 
 				// Initialize local variables
+				const float ani_raiu_ending_time = sim->ani_raiu_ending_time;
 				gx3dVector camera_normal_heading = { 0, 0, 1 };
-				float camera_lerp_duration = 1000.0f;
 
 				float fx_shock_time_from = 0.0f, fx_shock_time_to = 1000.0f;
 				float fx_destruct_charge_time_from = 2000.0f, fx_destruct_charge_time_to = 3000.0f;
 				float fx_destruct_charge_loop_time_from = 3000.0f, fx_destruct_charge_loop_time_to = 5000.0f;
 				float fx_destruct_flash_time_from = 6000.0f, fx_destruct_flash_time_to = 10000.0f;
 
-				gx3dVector fx_shock_pos = { raiu.sphere.center.x, 1, 1 };
-				gx3dVector fx_destruct_charge_pos = { raiu.sphere.center.x, gx3d_Lerp(2, 0, (FX_NORMAL_DURATION - (ani_raiu_ending_time - fx_destruct_charge_time_from)) / FX_NORMAL_DURATION), raiu.sphere.center.z };
-				gx3dVector fx_destruct_charge_loop_pos = { raiu.sphere.center.x,  gx3d_Lerp(4, 2, (FX_NORMAL_DURATION - (ani_raiu_ending_time - fx_destruct_charge_loop_time_from)) / FX_NORMAL_DURATION), 0 };
-				gx3dVector fx_destruct_flash_pos = { raiu.sphere.center.x, 5.5, -10 };
+				gx3dVector fx_shock_pos = { raiu->sphere.center.x, 1, 1 };
+				gx3dVector fx_destruct_charge_pos = { raiu->sphere.center.x, gx3d_Lerp(2, 0, (FX_NORMAL_DURATION - (ani_raiu_ending_time - fx_destruct_charge_time_from)) / FX_NORMAL_DURATION), raiu->sphere.center.z };
+				gx3dVector fx_destruct_charge_loop_pos = { raiu->sphere.center.x,  gx3d_Lerp(4, 2, (FX_NORMAL_DURATION - (ani_raiu_ending_time - fx_destruct_charge_loop_time_from)) / FX_NORMAL_DURATION), 0 };
+				gx3dVector fx_destruct_flash_pos = { raiu->sphere.center.x, 5.5, -10 };
 
 				gx3dVector fx_shock_scale = { 4.0f, 4.0f, 4.0f };
 				gx3dVector fx_destruct_charge_scale = { 7.0f, 7.0f, 7.0f };
@@ -3278,310 +2257,41 @@ bool Render_GameScreen(int *state) {
 
 				// Smoothly move the camera back to the center
 				if (heading.x != 0 && heading.y != 0 && heading.z != 1) {
-					gx3d_LerpVector(&heading, &camera_normal_heading, ((camera_lerp_duration - game_ending_speed_timer) / camera_lerp_duration), &heading);
+					gx3d_LerpVector(&heading, &camera_normal_heading, ((camera_lerp_duration - sim->game_ending_speed_timer) / camera_lerp_duration), &heading);
 				}
 
-				for (int i = 0; i < current_max_enemy_count; i++) {
-
-					// Set material for enemies and turn on specular lighting
-					gx3d_SetMaterial(&material_hoshu);
-					gx3d_EnableSpecularLighting();
-
-					// Draw the current Hoshu when it is spawned
-					if (enemies.hoshu[i].draw) {
-
-						// Initialize local variables
-						float angle;
-
-						// Check first if the current Hoshu is behind the camera and needs to be recycled
-						if (enemies.hoshu[i].pos.z <= ground_init_z) { // Hoshu is at or past the initial ground position
-							enemies.hoshu[i].explosion_timer = -1;
-							enemies.hoshu[i].explosion_type = -1;
-							enemies.hoshu[i].explode_snd_initialized = false;
-							enemies.hoshu[i].draw = false;
-
-							// Decrement enemy count to spawn new enemies
-							enemy_count--;
-						}
-
-						else {
-
-							// Update z position
-							enemies.hoshu[i].pos.z -= distance;
-							enemies.hoshu[i].sphere.center.z = enemies.hoshu[i].pos.z;
-
-							// Transform and draw into world
-							float pos_x = enemies.hoshu[i].pos.x;
-							float pos_y = enemies.hoshu[i].pos.y;
-							float pos_z = enemies.hoshu[i].pos.z;
-
-							// Update 3D laser sound position (since the world is moving)
-							snd_SetSoundPosition(s_laser_2, enemies.hoshu[i].sphere.center.x, enemies.hoshu[i].sphere.center.y, enemies.hoshu[i].sphere.center.z, snd_3D_APPLY_NOW);
-
-							// Play or update the explosion effect while the Hoshu was just destroyed
-							if (enemies.hoshu[i].explosion_timer >= 0) {
-
-								// Initialize local variables
-								gx3dVector scale = { 10, 10, 10 };
-								gx3dTexture fx_explosion;
-
-								// Set explosion light to the current destroyed Hoshu
-								Update_Light(&explosion_light, explosion_orange, &enemies.hoshu[i].sphere.center, Inverse_Lerp(100, 0, (FX_NORMAL_DURATION * enemies.hoshu[i].explosion_timer) / FX_NORMAL_DURATION), elapsed_time, true, 0, 0, 0.001);
-								gx3d_EnableLight(explosion_light);
-
-								// Generate a randomized explosion effect and sound
-								if (enemies.hoshu[i].explosion_type == -1) {
-									enemies.hoshu[i].explosion_type = random_GetInt(1, 3);
-								}
-
-								// Update 3D explosion sound positions
-								snd_SetSoundPosition(s_explosion_1, enemies.hoshu[i].sphere.center.x, enemies.hoshu[i].sphere.center.y, enemies.hoshu[i].sphere.center.z, snd_3D_APPLY_NOW);
-								snd_SetSoundPosition(s_explosion_2, enemies.hoshu[i].sphere.center.x, enemies.hoshu[i].sphere.center.y, enemies.hoshu[i].sphere.center.z, snd_3D_APPLY_NOW);
-								snd_SetSoundPosition(s_explosion_3, enemies.hoshu[i].sphere.center.x, enemies.hoshu[i].sphere.center.y, enemies.hoshu[i].sphere.center.z, snd_3D_APPLY_NOW);
-
-								if (enemies.hoshu[i].explosion_type == 1) {
-									if (!enemies.hoshu[i].explode_snd_initialized) {
-										snd_PlaySound(s_explosion_1, 0);
-										enemies.hoshu[i].explode_snd_initialized = true;
-										gx3d_MultiplyScalarVector(2, &scale, &scale); // doubles the scale
-									}
-									else { // update sound position
-
-									}
-									fx_explosion = fx_explosion_1;
-								}
-								else if (enemies.hoshu[i].explosion_type == 2) {
-									if (!enemies.hoshu[i].explode_snd_initialized) {
-										snd_PlaySound(s_explosion_2, 0);
-										enemies.hoshu[i].explode_snd_initialized = true;
-									}
-									fx_explosion = fx_explosion_2;
-								}
-								else {
-									if (!enemies.hoshu[i].explode_snd_initialized) {
-										snd_PlaySound(s_explosion_3, 0);
-										enemies.hoshu[i].explode_snd_initialized = true;
-									}
-									fx_explosion = fx_explosion_3;
-								}
-
-								// Display and update an effect after a certain amount of time in the animation
-								if (enemies.hoshu[i].explosion_timer <= FX_NORMAL_DURATION) {
-									Play_FX(fx_explosion, billboard_normal, enemies.hoshu[i].sphere.center, scale, FX_NORMAL_DURATION, enemies.hoshu[i].explosion_timer, 100, false);
-									gx3d_SetAmbientLight(color3d_dim);
-
-									// Update timer
-									enemies.hoshu[i].explosion_timer += elapsed_time;
-								}
-
-								// Resets explosion timer and sets draw to false when the explosion effect has finished
-								else {
-									enemies.hoshu[i].explosion_timer = -1;
-									enemies.hoshu[i].explosion_type == -1;
-									enemies.hoshu[i].explode_snd_initialized = false;
-									enemies.hoshu[i].draw = false;
-
-									// Disable explosion light
-									gx3d_DisableLight(explosion_light);
-								}
-							}
-
-							// Continue displaying the Hoshu while not destroyed
-							else {
-								layer = gx3d_GetObjectLayer(obj_hoshu, "bottom");
-								gx3d_GetTranslateMatrix(&m1, pos_x, pos_y, pos_z);
-								gx3d_SetObjectLayerMatrix(obj_hoshu, layer, &m1);
-
-								// Set layer to the "top" layer of the Hoshu model
-								layer = gx3d_GetObjectLayer(obj_hoshu, "top");
-
-								// Update the Hoshu view vector to point at the character's xz-coordinates
-								hoshu_view.x = -(raiu.pos.x - enemies.hoshu[i].pos.x);
-								hoshu_view.y = 0;
-								hoshu_view.z = (raiu.pos.z - enemies.hoshu[i].pos.z);
-
-								// Compute angle between the two
-								angle = gx3d_AngleBetweenVectors(&hoshu_normal, &hoshu_view);
-								if ((hoshu_view.x - hoshu_normal.x) < 0)
-									angle *= -1;
-
-								// Make sure that angle of rotation does not exceed its max
-								if (angle >= 0 && angle > ROTATE_RIGHT_MAX)
-									angle = ROTATE_RIGHT_MAX;
-								else if (angle < 0 && angle < ROTATE_LEFT_MAX)
-									angle = ROTATE_LEFT_MAX;
-								gx3d_GetRotateYMatrix(&m1, angle);
-								gx3d_SetObjectLayerMatrix(obj_hoshu, layer, &m1);
-
-								// Update transformations
-								gx3d_Object_UpdateTransforms(obj_hoshu);
-
-								// Draw layers
-								gx3d_SetTexture(0, tex_hoshu);
-
-								layer = gx3d_GetObjectLayer(obj_hoshu, "bottom");
-								gx3d_DrawObjectLayer(layer, 0);
-
-								layer = gx3d_GetObjectLayer(obj_hoshu, "top");
-								gx3d_DrawObjectLayer(layer, 0);
-							}
-						}
-					}
-
-					// Disable specular lighting and set materail for red lasers
-					gx3d_DisableSpecularLighting();
-					gx3d_SetMaterial(&material_red_laser);
-
-					// Update any lasers fired by each Hoshu that is drawn in the world
-					for (int j = 0; j < HOSHU_MAX_LASER_COUNT; j++) {
-						if (enemies.hoshu[i].laser[j].draw) {
-
-							// Initialize local variables
-							float total_laser_distance;
-
-							// Enable alpha blending and set ambient light to white
-							gx3d_DisableAlphaBlending();
-							gx3d_SetAmbientLight(color3d_white);
-
-							// Slow down laser movement when destroyed
-							if (enemies.hoshu[i].laser[j].destroyed && enemies.hoshu[i].laser[j].trajectory.velocity == hoshu_laser_speed)
-								enemies.hoshu[i].laser[j].trajectory.velocity *= 0.10;
-
-							// Calculate the distance traveled by the projectile based on the elapsed time
-							total_laser_distance = (enemies.hoshu[i].laser[j].trajectory.velocity) * (elapsed_time / 1000.0f);
-
-							// Don't draw if projectile goes beyond the initial ground position
-							if (abs(enemies.hoshu[i].laser[j].pos.x) >= MAX_PROJECTILE_DISTANCE, abs(enemies.hoshu[i].laser[j].pos.y) >= MAX_PROJECTILE_DISTANCE, abs(enemies.hoshu[i].laser[j].pos.z) >= MAX_PROJECTILE_DISTANCE) {
-								enemies.hoshu[i].laser[j].hit_timer = -1;
-								enemies.hoshu[i].laser[j].draw = false;
-
-								// Reset all laser variables to initial values
-								enemies.hoshu[i].laser[j].distance = { 0, 0, 0 };
-								enemies.hoshu[i].laser[j].sphere = obj_laser->bound_sphere;
-								enemies.hoshu[i].laser[j].pos = enemies.hoshu[i].pos;
-								enemies.hoshu[i].laser[j].world_shift = 0;
-								enemies.hoshu[i].laser[j].destroyed = false;
-								enemies.hoshu[i].laser[j].trajectory = { {0, 0, -1}, 0 };
-							}
-
-							// Display the laser or the hit effect otherwise
-							else {
-
-								// Play or update the laser hit effect while the laser had just hit an object
-								if (enemies.hoshu[i].laser[j].hit_timer >= 0) {
-
-									// Initialize local variables
-									gx3dVector scale = { 4, 4, 4 };
-									gx3dVector pos;
-
-									// Set effect position
-									if (enemies.hoshu[i].laser[j].destroyed)
-										pos = { enemies.hoshu[i].laser[j].pos.x, enemies.hoshu[i].laser[j].pos.y, enemies.hoshu[i].laser[j].pos.z };
-									else
-										pos = { raiu.pos.x, raiu.sphere.center.y, raiu.pos.z + 1 };
-
-									// Display and update an effect after a certain amount of time in the animation
-									if (enemies.hoshu[i].laser[j].hit_timer <= FX_NORMAL_DURATION) {
-										Play_FX(fx_laser_red, billboard_normal, pos, scale, FX_NORMAL_DURATION / 2.0f, enemies.hoshu[i].laser[j].hit_timer, 100, false);
-										gx3d_SetAmbientLight(color3d_dim);
-
-										// Update timer
-										enemies.hoshu[i].laser[j].hit_timer += elapsed_time;
-									}
-
-									// Resets the timer and sets draw to false when the hit effect has finished
-									else {
-										enemies.hoshu[i].laser[j].hit_timer = -1;
-										enemies.hoshu[i].laser[j].draw = false;
-
-										// Reset all laser variables to initial values
-										enemies.hoshu[i].laser[j].distance = { 0, 0, 0 };
-										enemies.hoshu[i].laser[j].sphere = obj_laser->bound_sphere;
-										enemies.hoshu[i].laser[j].pos = enemies.hoshu[i].pos;
-										enemies.hoshu[i].laser[j].world_shift = 0;
-										enemies.hoshu[i].laser[j].destroyed = false;
-										enemies.hoshu[i].laser[j].trajectory = { {0, 0, -1}, 0 };
-									}
-								}
-
-								else {
-
-									// Translate to world then draw
-									gx3d_GetTranslateMatrix(&m1, enemies.hoshu[i].laser[j].sphere.center.x, enemies.hoshu[i].laser[j].pos.y, enemies.hoshu[i].laser[j].pos.z);
-									gx3d_GetScaleMatrix(&m2, hoshu_laser_scale, hoshu_laser_scale, hoshu_laser_scale);
-									gx3d_MultiplyMatrix(&m2, &m1, &m);
-									gx3d_SetObjectMatrix(obj_laser, &m);
-									gx3d_SetTexture(0, tex_red_laser);
-									gx3d_DrawObject(obj_laser, 0);
-
-								}
-
-								// Update laser position based on the total laser distance traveled
-								gx3d_MultiplyScalarVector(total_laser_distance, &enemies.hoshu[i].laser[j].trajectory.direction, &v);
-								gx3d_AddVector(&enemies.hoshu[i].laser[j].pos, &v, &enemies.hoshu[i].laser[j].pos);
-								enemies.hoshu[i].laser[j].sphere.center.x = enemies.hoshu[i].laser[j].pos.x;
-								enemies.hoshu[i].laser[j].sphere.center.y = enemies.hoshu[i].laser[j].pos.y;
-								enemies.hoshu[i].laser[j].sphere.center.z = enemies.hoshu[i].laser[j].pos.z;
-							}
-							gx3d_SetAmbientLight(color3d_dim);
-						}
-					}
-				}
-
-				// Set ambient light to dim
-				gx3d_SetAmbientLight(color3d_dim);
+				// Draw all spawned enemies and their lasers
+				Draw_Hoshus(sim, &sim_draw, billboard_normal, elapsed_time);
 
 				// Update sound effects when unpaused
-				snd_SetSoundFrequency(s_footstep, (snd_GetSoundFrequency(s_footstep) * (1.0f - ((NORMAL_SPEED - speed) / NORMAL_SPEED))));
+				snd_SetSoundFrequency(s_footstep, (snd_GetSoundFrequency(s_footstep) * (1.0f - ((NORMAL_SPEED - sim->speed) / NORMAL_SPEED))));
 				if (!snd_IsPlaying(s_footstep)) {
 					snd_PlaySound(s_footstep, 1);
 				}
 
-				// Deactivate swing timer when it is active
-				if (raiu.blade_timer != -1) {
-					raiu.blade_timer = -1;
-					play_swing_1 = false;
-					play_swing_2 = false;
-				}
-
-				// Set material for character and enable specular lighting
-				gx3d_SetMaterial(&material_raiu);
-				gx3d_EnableSpecularLighting();
-
 				// Update the animation ending blend trees depending on whichever one is the one playing
 				// Play the trip animation right after the speed had decreased to 0
-				if (game_ending_speed_timer <= lerp_speed_duration) {
-					gx3d_Motion_Update(ani_raiu_trip, (game_ending_speed_timer / 1000.0f), false); // update run animation speed depending on the decreasing speed
+				if (sim->game_ending_speed_timer <= ENDING_SLOWDOWN_DURATION) {
+					gx3d_Motion_Update(ani_raiu_trip, (sim->game_ending_speed_timer / 1000.0f), false); // update run animation speed depending on the decreasing speed
 					gx3d_BlendTree_Update(btree_trip);
 				}
 
 				// Play the self destruct animation and effects after the trip animation
 				else {
 
-					// Activate the timer and play the sound effect for self destruct
-					if (ani_raiu_ending_time == -1) {
-						ani_raiu_ending_time = 0;
-						snd_PlaySound(s_ending, 0);
-					}
-
-					// State switches to Game Over after the animation and sound effect
-					else if (!snd_IsPlaying(s_ending)) {
+					// Continue to the game over screen after the animation and sound effect
+					if (*state == STATE_GAME_OVER) {
 						// Set the 3D viewport clear color to white
 						color.r = 255;
 						color.g = 255;
 						color.b = 255;
 						color.a = 0;
+						Draw_List_Clear(); // everything recorded so far would be cleared anyway
 						gx3d_ClearViewport(gx3d_CLEAR_SURFACE | gx3d_CLEAR_ZBUFFER, color, gx3d_MAX_ZBUFFER_VALUE, 0);
 
-						// Update game state to Game Over
-						*state = STATE_GAME_OVER;
 						next_screen = true; // continue to game over screen
 					}
 
-					// Update otherwise
-					else {
-						ani_raiu_ending_time += elapsed_time;
-					}
 					gx3d_Motion_Update(ani_raiu_self_destruct, (ani_raiu_ending_time / 1000.0f), false);
 					gx3d_BlendTree_Update(btree_self_destruct);
 
@@ -3599,72 +2309,50 @@ bool Render_GameScreen(int *state) {
 					// Display and update an effect after a certain amount of time in the animation
 					// Shock FX
 					if (ani_raiu_ending_time >= fx_shock_time_from && ani_raiu_ending_time <= fx_shock_time_to) {
-						Play_FX(fx_destruct_shock, billboard_normal, fx_shock_pos, fx_shock_scale, FX_NORMAL_DURATION, ani_raiu_ending_time, 100, false);
-						gx3d_SetAmbientLight(color3d_dim);
+						Queue_FX(fx_destruct_shock, billboard_normal, fx_shock_pos, fx_shock_scale, FX_NORMAL_DURATION, ani_raiu_ending_time, 100, false);
 						// Set character lighting to lightning purple and flicker when within the special effect time window
-						gx3d_DisableLight(raiu.light);
-						Update_Light(&raiu.light, lightning_purple, &fx_shock_pos, 100, elapsed_time, true);
-						gx3d_EnableLight(raiu.light);
-						
+						gx3d_DisableLight(raiu_light);
+						Update_Light(&raiu_light, lightning_purple, &fx_shock_pos, 100, elapsed_time, true);
+						gx3d_EnableLight(raiu_light);
+
 					}
 					// Self Destruct Charge Start
 					else if (ani_raiu_ending_time >= fx_destruct_charge_time_from && ani_raiu_ending_time <= fx_destruct_charge_time_to) {
-						Play_FX(fx_destruct_charge, billboard_normal, fx_destruct_charge_pos, fx_destruct_charge_scale, FX_NORMAL_DURATION, ani_raiu_ending_time - fx_destruct_charge_time_from, 100, false);
-						gx3d_SetAmbientLight(color3d_dim);
+						Queue_FX(fx_destruct_charge, billboard_normal, fx_destruct_charge_pos, fx_destruct_charge_scale, FX_NORMAL_DURATION, ani_raiu_ending_time - fx_destruct_charge_time_from, 100, false);
 						// Set character lighting to lightning purple and flicker when within the special effect time window
-						gx3d_DisableLight(raiu.light);
-						Update_Light(&raiu.light, lightning_purple, &fx_destruct_charge_pos, 300, elapsed_time, true);
-						gx3d_EnableLight(raiu.light);
+						gx3d_DisableLight(raiu_light);
+						Update_Light(&raiu_light, lightning_purple, &fx_destruct_charge_pos, 300, elapsed_time, true);
+						gx3d_EnableLight(raiu_light);
 					}
 					// Self Destruct Charge Loop
 					else if (ani_raiu_ending_time >= fx_destruct_charge_loop_time_from && ani_raiu_ending_time <= fx_destruct_charge_loop_time_to) {
-						Play_FX(fx_destruct_charge_loop, billboard_normal, fx_destruct_charge_loop_pos, fx_destruct_charge_scale, FX_NORMAL_DURATION/2, ani_raiu_ending_time - fx_destruct_charge_loop_time_from, 100, true);
-						gx3d_SetAmbientLight(color3d_dim);
-						gx3d_DisableLight(raiu.light);
-						Update_Light(&raiu.light, lightning_purple, &fx_destruct_charge_loop_pos, 300, elapsed_time, true);
-						gx3d_EnableLight(raiu.light);
+						Queue_FX(fx_destruct_charge_loop, billboard_normal, fx_destruct_charge_loop_pos, fx_destruct_charge_scale, FX_NORMAL_DURATION/2, ani_raiu_ending_time - fx_destruct_charge_loop_time_from, 100, true);
+						gx3d_DisableLight(raiu_light);
+						Update_Light(&raiu_light, lightning_purple, &fx_destruct_charge_loop_pos, 300, elapsed_time, true);
+						gx3d_EnableLight(raiu_light);
 					}
 					// Self Destruct Flash
 					else if (ani_raiu_ending_time >= fx_destruct_flash_time_from && ani_raiu_ending_time <= fx_destruct_flash_time_to) {
-						Play_FX(fx_destruct_flash, billboard_normal, fx_destruct_flash_pos, fx_destruct_flash_scale, FX_NORMAL_DURATION, ani_raiu_ending_time - fx_destruct_flash_time_from, 50, false);
-						gx3d_SetAmbientLight(color3d_dim);
+						Queue_FX(fx_destruct_flash, billboard_normal, fx_destruct_flash_pos, fx_destruct_flash_scale, FX_NORMAL_DURATION, ani_raiu_ending_time - fx_destruct_flash_time_from, 50, false);
 					}
 				}
-				
+
 				// Transform character into world when not moving to the next screen
 				if (!next_screen) {
-					raiu.sphere = obj_raiu->bound_sphere;
-					raiu.sphere.center.x = raiu.pos.x;
 
 					// Update sound listener position
-					snd_SetListenerPosition(raiu.pos.x, raiu.sphere.center.y, raiu.pos.z, snd_3D_APPLY_NOW);
-
-					gx3d_GetTranslateMatrix(&m, raiu.pos.x, raiu.pos.y, raiu.pos.z);
-					gx3d_SetObjectMatrix(obj_raiu, &m);
-					gx3d_SetTexture(0, tex_raiu);
-					gx3d_DrawObject(obj_raiu, 0);
-
-					// Reset the light to dark gray
-					gx3d_SetAmbientLight(color3d_darkgray);
-					gx3d_EnableAlphaBlending();
-				}
+					snd_SetListenerPosition(raiu->pos.x, raiu->sphere.center.y, raiu->pos.z, snd_3D_APPLY_NOW);
 
-				// Destroy all enemies on screen and add their score values to the total score and inrement enemeies defeated for each one before continuing to the game over screen
-				else {
-					for (int i = 0; i < MAX_ENEMY_COUNT; i++) {
-						if (enemies.hoshu[i].draw) {
-							score += enemies.hoshu[i].score_amt;
-							enemies.hoshu[i].draw = false;
-							enemies_defeated++;
-							hoshus_defeated++;
-						}
-					}
+					gx3d_GetTranslateMatrix(&m, raiu->pos.x, raiu->pos.y, raiu->pos.z);
+					transform = Draw_List_Transform(obj_raiu, 0, &m);
+					center = To_Gx3d_Vector(raiu->sphere.center);
+					Draw_List_Object(DRAW_PASS_OPAQUE, DRAW_BLEND_ALPHA, DRAW_MATERIAL_RAIU, tex_raiu, transform, obj_raiu, 0, &center);
 				}
-
-				// Disable specular lighting
-				gx3d_DisableSpecularLighting();
 			}
 
+			// Draw the 3D world (already done before the 2D graphics while running)
+			Draw_List_Execute();
+
 			// Stop rendering
 			gx3d_EndRender();
 
@@ -3693,12 +2381,326 @@ bool Render_GameScreen(int *state) {
 		}
 	}
 
+	Report_Layer_Lookups("Game screen", lookups);
+	Render_State_Report("Game screen");
+	Transform_Report("Game screen");
+	Draw_List_Report("Game screen");
+	Asset_Report("Game screen");
+	Report_Culling("Game screen");
+	Report_Lod("Game screen");
 	Free_GameScreen();
 
 	// Prevents quitting the game
 	return false;
 }
 
+/*____________________________________________________________________
+|
+| Function: Draw_Hoshus
+|
+| Input: Called from Render_GameScreen
+| Output: Draws all spawned enemies, their explosions and their lasers.
+|___________________________________________________________________*/
+
+static void Draw_Hoshus(const SimFrame *sim, const SimDraw *draw, gx3dVector billboard_normal, unsigned elapsed_time) {
+
+	const Raiu *raiu = &sim->raiu;
+	const Enemy *enemies = &sim->enemies;
+	int count = 0;
+
+	// Draw all spawned Hoshus
+	Begin_Cull();
+	for (int k = 0; k < enemies->count; k++) {
+		int i = HOSHU_SLOT(enemies, k);
+
+		if (!enemies->active[i])
+			continue;
+
+		// Initialize local variables
+		gx3dVector center = To_Gx3d_Vector(enemies->sphere[i].center);
+		center.z = SIM_DRAW_Z(draw, center.z);
+
+		// Update 3D laser sound position (since the world is moving)
+		snd_SetSoundPosition(s_laser_2, center.x, center.y, center.z, snd_3D_APPLY_NOW);
+
+		// Play the explosion effect while the Hoshu was just destroyed
+		if (enemies->explosion_timer[i] >= 0) {
+
+			// Initialize local variables
+			gx3dVector scale = { 10, 10, 10 };
+			gx3dTexture fx_explosion;
+
+			// Set explosion light to the current destroyed Hoshu
+			Update_Light(&explosion_light, explosion_orange, &center, Inverse_Lerp(100, 0, (FX_NORMAL_DURATION * enemies->explosion_timer[i]) / FX_NORMAL_DURATION), elapsed_time, true, 0, 0, 0.001);
+			gx3d_EnableLight(explosion_light);
+
+			// Update 3D explosion sound positions
+			snd_SetSoundPosition(s_explosion_1, center.x, center.y, center.z, snd_3D_APPLY_NOW);
+			snd_SetSoundPosition(s_explosion_2, center.x, center.y, center.z, snd_3D_APPLY_NOW);
+			snd_SetSoundPosition(s_explosion_3, center.x, center.y, center.z, snd_3D_APPLY_NOW);
+
+			if (enemies->explosion_type[i] == 1)
+				fx_explosion = fx_explosion_1;
+			else if (enemies->explosion_type[i] == 2)
+				fx_explosion = fx_explosion_2;
+			else
+				fx_explosion = fx_explosion_3;
+
+			// Display the effect until the explosion has finished
+			if (enemies->explosion_timer[i] <= FX_NORMAL_DURATION) {
+				Queue_FX(fx_explosion, billboard_normal, center, scale, FX_NORMAL_DURATION, enemies->explosion_timer[i], 100, false);
+			}
+		}
+
+		// Continue displaying the Hoshu while not destroyed (and in view)
+		else
+			Add_Cull_Bound(center, enemies->sphere[i].radius, i);
+	}
+
+	Cull();
+
+	// Pick the detail level of every Hoshu in view (a new Hoshu in a slot starts at full detail)
+	for (int k = 0; k < cull_bounds.count; k++) {
+		if (!CULL_VISIBLE(cull_bounds.visible, k))
+			continue;
+		int i = cull_bounds.index[k];
+
+		if (hoshu_lod_id[i] != enemies->id[i]) {
+			hoshu_lod_id[i] = enemies->id[i];
+			hoshu_lod[i] = 0;
+		}
+		gx3dVector pos = { cull_bounds.x[k], cull_bounds.y[k], cull_bounds.z[k] };
+		hoshu_lod[i] = Lod_Select(&lod_hoshu, Lod_Projected_Size(cull_bounds.radius[k], Eye_Distance(&pos), GAME_FOV), hoshu_lod[i]);
+	}
+
+	for (int level = 0; level <= lod_hoshu.num_meshes; level++) {
+		count = 0;
+
+		for (int k = 0; k < cull_bounds.count; k++) {
+			if (!CULL_VISIBLE(cull_bounds.visible, k) || hoshu_lod[cull_bounds.index[k]] != level)
+				continue;
+			int i = cull_bounds.index[k];
+
+			// Far away Hoshus are impostors
+			if (level == lod_hoshu.num_meshes) {
+				gx3dVector pos = { cull_bounds.x[k], cull_bounds.y[k], cull_bounds.z[k] };
+				Queue_Impostor(tex_hoshu_impostor, DRAW_MATERIAL_HOSHU, billboard_normal, pos, 2 * cull_bounds.radius[k]);
+				count += 2;
+				continue;
+			}
+
+			gx3d_GetTranslateMatrix(&instance_matrix[count++], enemies->pos[i].x, enemies->pos[i].y, SIM_DRAW_Z(draw, enemies->pos[i].z));
+
+			// Rotate the "top" layer of the Hoshu model towards the character
+			gx3d_GetRotateYMatrix(&instance_matrix[count++], enemies->angle[i]);
+		}
+
+		// Draw both layers of every Hoshu at this level at once
+		if (level < lod_hoshu.num_meshes)
+			Draw_List_Instances(DRAW_PASS_OPAQUE, DRAW_BLEND_ALPHA, DRAW_MATERIAL_HOSHU, tex_hoshu, obj_hoshu_lod[level], 2, layer_hoshu[level], instance_matrix, count / 2);
+		lod_drawn[level < lod_hoshu.num_meshes ? level : MAX_LOD_LEVELS] += count / 2;
+	}
+
+	// Draw any lasers fired by the Hoshus
+	const Projectiles *projectiles = &sim->projectiles;
+	count = 0;
+	Begin_Cull();
+	for (int i = 0; i < projectiles->used; i++) {
+
+		if (projectiles->live[i] AND projectiles->owner[i] != PROJECTILE_OWNER_RAIU) {
+
+			// Display the laser hit effect while the laser had just hit an object
+			if (projectiles->hit_timer[i] >= 0) {
+
+				// Initialize local variables
+				gx3dVector scale = { 4, 4, 4 };
+				gx3dVector pos;
+
+				// Set effect position
+				if (projectiles->destroyed[i])
+					pos = Projectile_Position(sim, draw, i);
+				else
+					pos = { raiu->pos.x, raiu->sphere.center.y, raiu->pos.z + 1 };
+
+				if (projectiles->hit_timer[i] <= FX_NORMAL_DURATION)
+					Queue_FX(fx_laser_red, billboard_normal, pos, scale, FX_NORMAL_DURATION / 2.0f, projectiles->hit_timer[i], 100, false);
+			}
+
+			// Continue displaying laser otherwise (drawn without alpha blending)
+			else
+				Add_Cull_Bound(Projectile_Position(sim, draw, i), projectiles->radius[i], i);
+		}
+	}
+
+	// Translate the lasers in view to world
+	Cull();
+	gx3d_GetScaleMatrix(&m2, HOSHU_LASER_SCALE, HOSHU_LASER_SCALE, HOSHU_LASER_SCALE);
+	for (int k = 0; k < cull_bounds.count; k++) {
+		if (!CULL_VISIBLE(cull_bounds.visible, k))
+			continue;
+		gx3d_GetTranslateMatrix(&m1, cull_bounds.x[k], cull_bounds.y[k], cull_bounds.z[k]);
+		gx3d_MultiplyMatrix(&m2, &m1, &instance_matrix[count++]);
+	}
+
+	// Draw the lasers in flight all at once
+	Draw_List_Instances(DRAW_PASS_OPAQUE, DRAW_BLEND_NONE, DRAW_MATERIAL_RED_LASER, tex_red_laser, obj_laser, 0, 0, instance_matrix, count);
+}
+
+/*____________________________________________________________________
+|
+| Function: Init_HUD
+|
+| Input: Called from Init_GameScreen
+| Output: Lays out the HUD: the fixed layer matrices and the position
+|		  of every digit.  Everything else is built by Update_HUD.
+|___________________________________________________________________*/
+
+static void Init_HUD() {
+
+	// Local Variables
+	const float scale_weapons_lv = 0.40;
+	const float scale_scorebar = 0.12;
+
+	const float hp_font_spacing = 0.04;
+	float hp_font_x = -1.38;
+	const float hp_font_y = -0.77;
+
+	const float weapon_lv_font_spacing = 0.08;
+	const float weapon_lv_x = 1.40;
+	const float weapon_lv_y = -0.60;
+	float weapon_lv_font_x = 1.45;
+	float weapon_lv_font_y = -0.73;
+
+	const float score_font_spacing = 0.08;
+	const float scorebar_x = 1.25;
+	const float scorebar_y = 0.78;
+	float score_font_x = 0.97;
+	const float score_font_y = 0.78;
+
+	//========== HP setup ==========//
+	gx3d_GetScaleMatrix(&m1, HUD_HP_SCALE, HUD_HP_SCALE, HUD_HP_SCALE);
+	gx3d_GetTranslateMatrix(&m2, HUD_HP_X, HUD_HP_Y, 0);
+	gx3d_MultiplyMatrix(&m1, &m2, &m);
+	Transform_Set(obj_hud, layer_hp, &m);
+
+	// HP Fonts
+	for (int i = 0; i < MAX_HP_FONTS * 2; i++) {
+		// first four digits (Current HP)
+		if (i < MAX_HP_FONTS) {
+			if (i != 0) // after the first digit of current hp
+				hp_font_x += hp_font_spacing;
+		}
+		// last four digits (Max HP)
+		else {
+			if (i == MAX_HP_FONTS) // first digit of max hp
+				hp_font_x += hp_font_spacing * 1.5;
+			else
+				hp_font_x += hp_font_spacing;
+
+		}
+		hp_font_slot[i] = { hp_font_x, hp_font_y, 0 };
+	}
+
+	//========== Weapons Lv setup ==========//
+	// Weapons Lv
+	gx3d_GetScaleMatrix(&m1, scale_weapons_lv, scale_weapons_lv, scale_weapons_lv);
+	gx3d_GetTranslateMatrix(&m2, weapon_lv_x, weapon_lv_y, 0);
+	gx3d_MultiplyMatrix(&m1, &m2, &m);
+	Transform_Set(obj_hud, layer_weapons_lv, &m);
+
+	// Weapons Lv Fonts
+	for (int i = 0; i < MAX_LV_FONTS * 2; i++) {
+		// first two digits (gun lv)
+		if (i < MAX_LV_FONTS) {
+			if (i != 0) // after the first digit of gun lv
+				weapon_lv_font_x += weapon_lv_font_spacing;
+		}
+		// last two digits (blade lv)
+		else {
+			if (i == MAX_LV_FONTS) { // first digit of blade lv
+				weapon_lv_font_x -= (weapon_lv_font_spacing * (MAX_LV_FONTS - 1));
+				weapon_lv_font_y += 0.19;
+			}
+			else
+				weapon_lv_font_x += weapon_lv_font_spacing;
+
+		}
+		weapon_lv_font_slot[i] = { weapon_lv_font_x, weapon_lv_font_y, 0 };
+	}
+
+	//========== Score setup ==========//
+	// Score Bar
+	gx3d_GetScaleMatrix(&m1, scale_scorebar * 1.5, scale_scorebar, scale_scorebar);
+	gx3d_GetTranslateMatrix(&m2, scorebar_x, scorebar_y, 0);
+	gx3d_MultiplyMatrix(&m1, &m2, &m);
+	Transform_Set(obj_hud, layer_score_bar, &m);
+
+	// Score Fonts
+	for (int i = 0; i < MAX_SCORE_FONTS; i++) {
+		if (i != 0) // after the first digit of score
+			score_font_x += score_font_spacing;
+		score_font_slot[i] = { score_font_x, score_font_y, 0 };
+	}
+
+	// Build everything on the first frame
+	hud.dirty = HUD_DIRTY_ALL;
+}
+
+/*____________________________________________________________________
+|
+| Function: Update_HUD
+|
+| Input: Called from Render_GameScreen
+| Output: Marks the parts of the HUD whose values have changed since
+|		  the last frame and rebuilds them.  Does nothing while the
+|		  values stay the same.
+|___________________________________________________________________*/
+
+static void Update_HUD(const SimFrame *sim) {
+
+	const Raiu *raiu = &sim->raiu;
+
+	if (raiu->hp != hud.hp)
+		hud.dirty |= HUD_DIRTY_HP;
+	if (raiu->gun_lv != hud.gun_lv || raiu->blade_lv != hud.blade_lv)
+		hud.dirty |= HUD_DIRTY_LV;
+	if (sim->score != hud.score)
+		hud.dirty |= HUD_DIRTY_SCORE;
+
+	if (!hud.dirty)
+		return;
+
+	hud.hp = raiu->hp;
+	hud.gun_lv = raiu->gun_lv;
+	hud.blade_lv = raiu->blade_lv;
+	hud.score = sim->score;
+
+	// HP Bar and the color of the HP background
+	if (hud.dirty & HUD_DIRTY_HP) {
+		float hp_bar_x_factor = (float)(hud.hp) / (float)(RAIU_MAX_HP);
+		gx3d_GetScaleMatrix(&m1, (HUD_HP_SCALE * hp_bar_x_factor), HUD_HP_SCALE, HUD_HP_SCALE);
+		gx3d_GetTranslateMatrix(&m2, HUD_HP_X, HUD_HP_Y, 0);
+		gx3d_MultiplyMatrix(&m1, &m2, &m);
+		Transform_Set(obj_hud, layer_hp_bar, &m);
+		Transform_Update(obj_hud);
+
+		if (hud.hp > RAIU_MAX_HP * 0.25) // green when hp is >25%
+			gx3d_GetTranslateTextureMatrix(&hud.hp_texture, 0, 1); // upper half of texture coords
+		else // red when hp is <=25%
+			gx3d_GetTranslateTextureMatrix(&hud.hp_texture, 0, 0.5); // lower half of texture coords
+	}
+
+	// Fonts (negative hp shows as 0)
+	Glyphs_Begin(&hud.glyphs);
+	Glyphs_Add_Number(&hud.glyphs, hud.hp > 0 ? hud.hp : 0, MAX_HP_FONTS, hp_font_slot, HUD_HP_FONT_SCALE, false);
+	Glyphs_Add_Number(&hud.glyphs, RAIU_MAX_HP, MAX_HP_FONTS, hp_font_slot + MAX_HP_FONTS, HUD_HP_FONT_SCALE, false);
+	Glyphs_Add_Number(&hud.glyphs, hud.gun_lv, MAX_LV_FONTS, weapon_lv_font_slot, HUD_LV_FONT_SCALE, true);
+	Glyphs_Add_Number(&hud.glyphs, hud.blade_lv, MAX_LV_FONTS, weapon_lv_font_slot + MAX_LV_FONTS, HUD_LV_FONT_SCALE, true);
+	Glyphs_Add_Number(&hud.glyphs, hud.score, MAX_SCORE_FONTS, score_font_slot, HUD_SCORE_FONT_SCALE, true);
+
+	hud.dirty = 0;
+}
+
 /*____________________________________________________________________
 |
 | Function: Render_GameOverScreen
@@ -3715,11 +2717,13 @@ bool Render_GameOverScreen(int *state) {
 	|___________________________________________________________________*/
 
 	// Variables
+	const SimFrame *sim = Sim_Get_Frame();
 	unsigned elapsed_time, new_time, last_time;
 	float game_over_timer, current_bgm_volume;
 	bool enter_pressed;
 	gx3dVector billboard_normal, fade_pos, fade_scale;
 	int hours, minutes, seconds;
+	unsigned lookups = layer_lookups;
 
 	// Init loop variables
 	last_time = 0;
@@ -3734,7 +2738,6 @@ bool Render_GameOverScreen(int *state) {
 	const float score_font_spacing = 0.08;
 	float score_font_x = -1.2;
 	const float score_font_y = 0.3;
-	char score_buf[MAX_SCORE_FONTS + 1];
 
 	const float scale_time_fonts = 0.08;
 	const float time_font_spacing = 0.08;
@@ -3742,16 +2745,13 @@ bool Render_GameOverScreen(int *state) {
 	float time_min_font_x = -0.94;
 	float time_sec_font_x = -0.76;
 	const float time_font_y = -0.038;
-	char time_hr_buf[MAX_TIME_FONTS + 1], time_min_buf[MAX_TIME_FONTS + 1], time_sec_buf[MAX_TIME_FONTS + 1];
 
 	const float scale_defeated_fonts = 0.08;
 	const float defeated_font_spacing = 0.08;
 	float defeated_font_x = -0.95;
 	const float defeated_font_y = -0.4;
-	char defeated_buf[MAX_DEFEATED_FONTS + 1];
 	
-	int dgt_ctr_1;
-	int incr;
+	GlyphBatch fonts;		// the numbers do not change on this screen
 	bool fonts_init = false;
 
 	// Setup game over screen sounds
@@ -3762,7 +2762,7 @@ bool Render_GameOverScreen(int *state) {
 	snd_PlaySound(s_game_over_bgm, 1);
 
 	// Convert total time played in milliseconds to hours : minutes : seconds
-	seconds = game_timer / 1000;
+	seconds = sim->game_timer / 1000;
 	minutes = seconds / 60;
 
 	hours = minutes / 60;
@@ -3834,12 +2834,15 @@ bool Render_GameOverScreen(int *state) {
 			gx3d_ClearViewport(gx3d_CLEAR_SURFACE | gx3d_CLEAR_ZBUFFER, color, gx3d_MAX_ZBUFFER_VALUE, 0);
 			// Start rendering in 3D
 			if (gx3d_BeginRender()) {
+				// Count the render state calls and transform updates of this frame
+				Render_State_Begin_Frame();
+				Transform_Begin_Frame();
 				// Set the default light
-				gx3d_SetAmbientLight(color3d_white);
+				Render_State_Ambient_Light(color3d_white);
 				// Set the default material
 				gx3d_SetMaterial(&material_default);
 				// Disable specular lighting
-				gx3d_DisableSpecularLighting();
+				Render_State_Specular_Lighting(false);
 
 				// Fade in game bgm at starting
 				if (current_bgm_volume < bgm_volume)
@@ -3864,15 +2867,15 @@ bool Render_GameOverScreen(int *state) {
 				gx3d_CameraSetViewMatrix();
 
 				// Draw the appropriate objects on screen
-				gx3d_DisableZBuffer();
-				gx3d_EnableAlphaBlending();
+				Render_State_Z_Buffer(false);
+				Render_State_Alpha_Blending(true);
 
 				// Game Over Screen Objects
-				layer = gx3d_GetObjectLayer(obj_hud, "full_screen_l");
+				layer = layer_full_screen_l;
 				gx3d_SetTexture(0, tex_game_over_l);
 				gx3d_DrawObjectLayer(layer, 0);
 
-				layer = gx3d_GetObjectLayer(obj_hud, "full_screen_r");
+				layer = layer_full_screen_r;
 				gx3d_SetTexture(0, tex_game_over_r);
 				gx3d_DrawObjectLayer(layer, 0);
 
@@ -3880,151 +2883,54 @@ bool Render_GameOverScreen(int *state) {
 				if (!fonts_init) {
 
 					// Final Score Fonts
-					gx3d_GetScaleMatrix(&m1, scale_score_fonts, scale_score_fonts, scale_score_fonts);
 					for (int i = 0; i < MAX_SCORE_FONTS; i++) {
-						layer = gx3d_GetObjectLayer(obj_score_fonts[i], "score_fonts");
-
-						if (i == 0) // first digit of score
-							gx3d_GetTranslateMatrix(&m2, score_font_x, score_font_y, 1);
-						else
-							gx3d_GetTranslateMatrix(&m2, score_font_x += score_font_spacing, score_font_y, 1);
-
-						gx3d_MultiplyMatrix(&m1, &m2, &m);
-						gx3d_SetObjectLayerMatrix(obj_score_fonts[i], layer, &m);
-						gx3d_Object_UpdateTransforms(obj_score_fonts[i]);
+						if (i != 0) // after the first digit of score
+							score_font_x += score_font_spacing;
+						score_font_slot[i] = { score_font_x, score_font_y, 1 };
 					}
 
 					// Total Gameplay Time Fonts
-					gx3d_GetScaleMatrix(&m4, scale_time_fonts, scale_time_fonts, scale_time_fonts);
-					for (int i = 0; i < 2; i++) {
-
-						if (i == 0) {// first digit of hours, minutes, and seconds
-							gx3d_GetTranslateMatrix(&m1, time_hr_font_x, time_font_y, 1); // hours
-							gx3d_GetTranslateMatrix(&m2, time_min_font_x, time_font_y, 1); // minutes
-							gx3d_GetTranslateMatrix(&m3, time_sec_font_x, time_font_y, 1); // seconds
-						}
-						else {
-							gx3d_GetTranslateMatrix(&m1, time_hr_font_x += time_font_spacing, time_font_y, 1); // hours
-							gx3d_GetTranslateMatrix(&m2, time_min_font_x += time_font_spacing, time_font_y, 1); // minutes
-							gx3d_GetTranslateMatrix(&m3, time_sec_font_x += time_font_spacing, time_font_y, 1); // seconds
+					for (int i = 0; i < MAX_TIME_FONTS; i++) {
+						if (i != 0) { // after the first digit of hours, minutes, and seconds
+							time_hr_font_x += time_font_spacing;
+							time_min_font_x += time_font_spacing;
+							time_sec_font_x += time_font_spacing;
 						}
-						gx3d_MultiplyMatrix(&m4, &m1, &m1); // hours
-						gx3d_MultiplyMatrix(&m4, &m2, &m2); // minutes
-						gx3d_MultiplyMatrix(&m4, &m3, &m3); // seconds
-
-						layer = gx3d_GetObjectLayer(obj_hr_fonts[i], "score_fonts");
-						gx3d_SetObjectLayerMatrix(obj_hr_fonts[i], layer, &m1); // hours
-						layer = gx3d_GetObjectLayer(obj_min_fonts[i], "score_fonts");
-						gx3d_SetObjectLayerMatrix(obj_min_fonts[i], layer, &m2); // minutes
-						layer = gx3d_GetObjectLayer(obj_sec_fonts[i], "score_fonts");
-						gx3d_SetObjectLayerMatrix(obj_sec_fonts[i], layer, &m3); // seconds
-
-						gx3d_Object_UpdateTransforms(obj_hr_fonts[i]); // hours
-						gx3d_Object_UpdateTransforms(obj_min_fonts[i]); // minutes
-						gx3d_Object_UpdateTransforms(obj_sec_fonts[i]); // seconds
+						hr_font_slot[i] = { time_hr_font_x, time_font_y, 1 }; // hours
+						min_font_slot[i] = { time_min_font_x, time_font_y, 1 }; // minutes
+						sec_font_slot[i] = { time_sec_font_x, time_font_y, 1 }; // seconds
 					}
 					
 					// Total Enemies Defeated Fonts
-					gx3d_GetScaleMatrix(&m1, scale_defeated_fonts, scale_defeated_fonts, scale_defeated_fonts);
 					for (int i = 0; i < MAX_DEFEATED_FONTS; i++) {
-						layer = gx3d_GetObjectLayer(obj_defeated_fonts[i], "score_fonts");
-
-						if (i == 0) // first digit of score
-							gx3d_GetTranslateMatrix(&m2, defeated_font_x, defeated_font_y, 1);
-						else
-							gx3d_GetTranslateMatrix(&m2, defeated_font_x += defeated_font_spacing, defeated_font_y, 1);
-
-						gx3d_MultiplyMatrix(&m1, &m2, &m);
-						gx3d_SetObjectLayerMatrix(obj_defeated_fonts[i], layer, &m);
-						gx3d_Object_UpdateTransforms(obj_defeated_fonts[i]);
+						if (i != 0) // after the first digit of enemies defeated
+							defeated_font_x += defeated_font_spacing;
+						defeated_font_slot[i] = { defeated_font_x, defeated_font_y, 1 };
 					}
 
-					fonts_init = true;
-				}
-
-				// Draw elements that requires the use of texture matrix (changing of UV texture coords)
-				gx3d_EnableTextureMatrix(0);
-
-				// Final Score Display
-				incr = 1;
-				dgt_ctr_1 = 0;
-				itoa(score, score_buf, 10);		// convert integer to char array (string)
-
-				if (score == 0)
-					dgt_ctr_1++;
-				else
-					while (score / incr != 0) { // counts the number of digits in score
-						dgt_ctr_1++;
-						incr *= 10;
-					}
-
-				Display_Fonts(obj_score_fonts, score_buf, dgt_ctr_1, MAX_SCORE_FONTS, m, tex_fonts, false);	// display the fonts on screen
-
-				// Total Time Played Display
-				// HOURS
-				incr = 1;
-				dgt_ctr_1 = 0;
-				itoa(hours, time_hr_buf, 10);		// convert integer to char array (string)
-
-				if (hours == 0)
-					dgt_ctr_1++;
-				else
-					while (hours / incr != 0) { // counts the number of digits in hours
-						dgt_ctr_1++;
-						incr *= 10;
-					}
+					// Final Score Display
+					Glyphs_Begin(&fonts);
+					Glyphs_Add_Number(&fonts, sim->score, MAX_SCORE_FONTS, score_font_slot, scale_score_fonts, false);
 
-				Display_Fonts(obj_hr_fonts, time_hr_buf, dgt_ctr_1, MAX_TIME_FONTS, m, tex_fonts, true);	// display the fonts on screen
+					// Total Time Played Display
+					Glyphs_Add_Number(&fonts, hours, MAX_TIME_FONTS, hr_font_slot, scale_time_fonts, true);
+					Glyphs_Add_Number(&fonts, minutes, MAX_TIME_FONTS, min_font_slot, scale_time_fonts, true);
+					Glyphs_Add_Number(&fonts, seconds, MAX_TIME_FONTS, sec_font_slot, scale_time_fonts, true);
 
-				// MINUTES
-				incr = 1;
-				dgt_ctr_1 = 0;
-				itoa(minutes, time_min_buf, 10); // convert integer to char array (string)
+					// Total Enemies Defeated Display
+					Glyphs_Add_Number(&fonts, sim->enemies_defeated, MAX_DEFEATED_FONTS, defeated_font_slot, scale_defeated_fonts, false);
 
-				if (minutes == 0)
-					dgt_ctr_1++;
-				else
-					while (minutes / incr != 0) { // counts the number of digits in minutes
-						dgt_ctr_1++;
-						incr *= 10;
-					}
-
-				Display_Fonts(obj_min_fonts, time_min_buf, dgt_ctr_1, MAX_TIME_FONTS, m, tex_fonts, true);	// display the fonts on screen
-
-				// SECONDS
-				incr = 1;
-				dgt_ctr_1 = 0;
-				itoa(seconds, time_sec_buf, 10); // convert integer to char array (string)
-
-				if (seconds == 0)
-					dgt_ctr_1++;
-				else
-					while (seconds / incr != 0) { // counts the number of digits in seconds
-						dgt_ctr_1++;
-						incr *= 10;
-					}
-
-				Display_Fonts(obj_sec_fonts, time_sec_buf, dgt_ctr_1, MAX_TIME_FONTS, m, tex_fonts, true);	// display the fonts on screen
-
-				// Total Enemies Defeated Display
-				incr = 1;
-				dgt_ctr_1 = 0;
-				itoa(enemies_defeated, defeated_buf, 10);		// convert integer to char array (string)
-
-				if (enemies_defeated == 0)
-					dgt_ctr_1++;
-				else
-					while (enemies_defeated / incr != 0) { // counts the number of digits in enemies defeated
-						dgt_ctr_1++;
-						incr *= 10;
-					}
+					fonts_init = true;
+				}
 
-				Display_Fonts(obj_defeated_fonts, defeated_buf, dgt_ctr_1, MAX_DEFEATED_FONTS, m, tex_fonts, false);	// display the fonts on screen
+				// Draw all the fonts at once (they require the use of texture matrix)
+				Render_State_Texture_Matrix(true);
+				Glyphs_Draw(&fonts, obj_fonts, layer_fonts, tex_fonts);
 
 				// Disable texture matrix and alpha blending
-				gx3d_DisableTextureMatrix(0);
-				gx3d_DisableAlphaBlending();
-				gx3d_EnableZBuffer();
+				Render_State_Texture_Matrix(false);
+				Render_State_Alpha_Blending(false);
+				Render_State_Z_Buffer(true);
 
 				Play_FX(fx_fade_white, billboard_normal, fade_pos, fade_scale, FX_NORMAL_DURATION, game_over_timer, 0, false);
 
@@ -4052,6 +2958,10 @@ bool Render_GameOverScreen(int *state) {
 			}
 		}
 	}
+	Report_Layer_Lookups("Game over screen", lookups);
+	Render_State_Report("Game over screen");
+	Transform_Report("Game over screen");
+	Asset_Report("Game over screen");
 	Free_GameOverScreen();
 
 	return false; // continue to next screen
@@ -4067,12 +2977,15 @@ bool Render_GameOverScreen(int *state) {
 
 void Render_Free(void)
 {
+	// Free the assets kept loaded between the screens
+	Asset_Free_All();
+
 	if (initialized) {
 		gx3d_FreeAllObjects();
 		gx3d_FreeAllTextures();
 		gx3d_FreeLight(dir_light);
 		gx3d_FreeLight(explosion_light);
-		gx3d_FreeLight(raiu.light);
+		gx3d_FreeLight(raiu_light);
 		for (Structure_Lights structure : structure_light)
 			gx3d_FreeLight(structure.light);
 
@@ -4095,13 +3008,21 @@ void Free_TitleScreen() {
 	| Free stuff and exit
 	|___________________________________________________________________*/
 	if (obj_billboards)
-		gx3d_FreeObject(obj_billboards);
+		Asset_Release_Object(obj_billboards);
 	if (obj_quit_button)
-		gx3d_FreeObject(obj_quit_button);
+		Asset_Release_Object(obj_quit_button);
+	Asset_Release_Texture(tex_title_screen_l);
+	Asset_Release_Texture(tex_title_screen_r);
+	Asset_Release_Texture(tex_button_start_game);
+	Asset_Release_Texture(tex_button_quit_game);
+	Asset_Release_Texture(tex_help_screen);
 	if (snd_IsPlaying(s_title_screen_bgm))
 		snd_StopSound(s_title_screen_bgm);
 	snd_Free();
 
+	// Forget the matrices of the released objects (the asset cache may free them)
+	Transform_Reset();
+
 	initialized = FALSE;
 }
 
@@ -4121,45 +3042,53 @@ void Free_GameScreen() {
 	|___________________________________________________________________*/
 
 	// Free Objects
-	gx3d_FreeObject(obj_raiu);
-	gx3d_FreeObject(obj_hoshu);
-	gx3d_FreeObject(obj_skydome);
-	gx3d_FreeObject(obj_ground);
-	gx3d_FreeObject(obj_structures);
-	gx3d_FreeObject(obj_laser);
-	gx3d_FreeObject(obj_fence);
-	for (int i = 0; i < MAX_HP_FONTS * 2; i++)
-		gx3d_FreeObject(obj_hp_fonts[i]);
-	for (int i = 0; i < MAX_LV_FONTS; i++)
-		gx3d_FreeObject(obj_weapon_lv_fonts[i]);
+	Asset_Release_Object(obj_raiu);
+	Asset_Release_Object(obj_hoshu);
+	Asset_Release_Object(obj_skydome);
+	Asset_Release_Object(obj_ground);
+	Asset_Release_Object(obj_structures);
+	Asset_Release_Object(obj_laser);
+	Asset_Release_Object(obj_fence);
+	for (int level = 1; level < MAX_LOD_LEVELS; level++) {
+		if (obj_hoshu_lod[level])
+			Asset_Release_Object(obj_hoshu_lod[level]);
+		if (obj_structures_lod[level])
+			Asset_Release_Object(obj_structures_lod[level]);
+	}
 
 	// Free Textures
-	gx3d_FreeTexture(tex_hp);
-	gx3d_FreeTexture(tex_hp_bar);
-	gx3d_FreeTexture(tex_score_bar);
-	gx3d_FreeTexture(tex_weapons_lv);
-	gx3d_FreeTexture(tex_raiu);
-	gx3d_FreeTexture(tex_hoshu);
-	gx3d_FreeTexture(tex_blue_laser);
-	gx3d_FreeTexture(tex_red_laser);
-	gx3d_FreeTexture(tex_skydome);
-	gx3d_FreeTexture(tex_earth);
-	gx3d_FreeTexture(tex_ground);
-	gx3d_FreeTexture(tex_ground_inner);
-	gx3d_FreeTexture(tex_ground_under);
-	gx3d_FreeTexture(tex_structures);
-	gx3d_FreeTexture(fx_run_charge);
-	gx3d_FreeTexture(fx_fence);
-	gx3d_FreeTexture(fx_explosion_1);
-	gx3d_FreeTexture(fx_explosion_2);
-	gx3d_FreeTexture(fx_explosion_3);
-	gx3d_FreeTexture(fx_laser_blue);
-	gx3d_FreeTexture(fx_laser_red);
-	gx3d_FreeTexture(fx_level_up);
-	gx3d_FreeTexture(fx_destruct_shock);
-	gx3d_FreeTexture(fx_destruct_charge);
-	gx3d_FreeTexture(fx_destruct_charge_loop);
-	gx3d_FreeTexture(fx_destruct_flash);
+	Asset_Release_Texture(tex_hp);
+	Asset_Release_Texture(tex_hp_bar);
+	Asset_Release_Texture(tex_score_bar);
+	Asset_Release_Texture(tex_weapons_lv);
+	Asset_Release_Texture(tex_raiu);
+	Asset_Release_Texture(tex_hoshu);
+	Asset_Release_Texture(tex_blue_laser);
+	Asset_Release_Texture(tex_red_laser);
+	Asset_Release_Texture(tex_skydome);
+	Asset_Release_Texture(tex_earth);
+	Asset_Release_Texture(tex_ground);
+	Asset_Release_Texture(tex_ground_inner);
+	Asset_Release_Texture(tex_ground_under);
+	Asset_Release_Texture(tex_structures);
+	if (tex_hoshu_impostor)
+		Asset_Release_Texture(tex_hoshu_impostor);
+	for (int i = 0; i < 4; i++)
+		if (tex_structure_impostor[i])
+			Asset_Release_Texture(tex_structure_impostor[i]);
+	Asset_Release_Texture(fx_run_charge);
+	Asset_Release_Texture(fx_fence);
+	Asset_Release_Texture(fx_explosion_1);
+	Asset_Release_Texture(fx_explosion_2);
+	Asset_Release_Texture(fx_explosion_3);
+	Asset_Release_Texture(fx_laser_blue);
+	Asset_Release_Texture(fx_laser_red);
+	Asset_Release_Texture(fx_level_up);
+	Asset_Release_Texture(fx_destruct_shock);
+	Asset_Release_Texture(fx_destruct_charge);
+	Asset_Release_Texture(fx_destruct_charge_loop);
+	Asset_Release_Texture(fx_destruct_flash);
+	Asset_Release_Texture(fx_fade_white);
 
 	// Free Sounds
 	snd_StopSound(s_game_bgm);
@@ -4167,12 +3096,15 @@ void Free_GameScreen() {
 
 	// Free Lights
 	gx3d_FreeLight(dir_light);
-	gx3d_FreeLight(raiu.light);
+	gx3d_FreeLight(raiu_light);
 	gx3d_FreeLight(explosion_light);
-	gx3d_FreeLight(heal_pad.light);
+	gx3d_FreeLight(heal_pad_light);
 
 	// Free Particle Systems
-	gx3d_FreeParticleSystem(heal_pad.psys);
+	gx3d_FreeParticleSystem(heal_pad_psys);
+
+	// Forget the matrices of the released objects (the asset cache may free them)
+	Transform_Reset();
 
 	initialized = FALSE;
 }
@@ -4192,15 +3124,21 @@ void Free_GameOverScreen() {
 	| Free stuff and exit
 	|___________________________________________________________________*/
 	if (obj_hud)
-		gx3d_FreeObject(obj_hud);
-	for (int i = 0; i < MAX_SCORE_FONTS; i++)
-		if (obj_score_fonts[i])
-			gx3d_FreeObject(obj_score_fonts[i]);
+		Asset_Release_Object(obj_hud);
+	if (obj_fonts)
+		Asset_Release_Object(obj_fonts);
+	Asset_Release_Texture(tex_fonts);
+	Asset_Release_Texture(tex_game_over_l);
+	Asset_Release_Texture(tex_game_over_r);
+	Asset_Release_Texture(fx_fade_white);
 
 	if (snd_IsPlaying(s_game_over_bgm))
 		snd_StopSound(s_game_over_bgm);
 	snd_Free();
 
+	// Forget the matrices of the released objects (the asset cache may free them)
+	Transform_Reset();
+
 	initialized = FALSE;
 }
 
@@ -4241,146 +3179,385 @@ static gx3dMotion *Load_Motion(gx3dMotionSkeleton *mskeleton, char *filename, in
 
 /*____________________________________________________________________
 |
-| Function: Display_Fonts
+| Function: Play_FX
 |
-| Input: Called from Render_GameScreen
-| Output: parses a char array of digits (integers) into graphical 
-|		  digits for the HUD.
+| Input: Called from Render_GameOverScreen
+| Output: Displays and plays an effect with respect to time.
+|		  (Only works on a 4x4 sprite sheet)
 |___________________________________________________________________*/
 
-static void Display_Fonts(gx3dObject *billboards[], char buf[], int buf_size, int max_buf_size, gx3dMatrix m, gx3dTexture tex, bool show_zeros) 
+static void Play_FX(gx3dTexture effect, gx3dVector normal, gx3dVector position, gx3dVector scale, float duration, unsigned time, int alpha_test, bool repeat) 
 {
-	// Local variables
-	float u, v;
+	// Initialize local variables;
+	gx3dObjectLayer *billboard;
+	gx3dMatrix world, texture;
 
-	// draws each digits in reverse to accomodate the varying size of the buffer
-	for (int i = buf_size-1, j = max_buf_size -1; i >= 0; i--, j--) {
-		Display_Font(billboards[j], buf[i], m, tex);
-	}
-	if (show_zeros) {
-		u = 0; v = 0;
-		gx3d_GetTranslateTextureMatrix(&m, u, v);
-		for (int i = max_buf_size - buf_size - 1; i >= 0; i--) {
-			layer = gx3d_GetObjectLayer(billboards[i], "score_fonts");
-			gx3d_SetTextureMatrix(0, &m);
-			gx3d_SetTexture(0, tex);
-			gx3d_DrawObjectLayer(layer, 0);
-		}
-	}
-}
+	billboard = layer_fx;
+	Render_State_Alpha_Blending(true);
+	Render_State_Alpha_Testing(true, alpha_test); // 100
+	Render_State_Texture_Matrix(true);
+	Render_State_Ambient_Light(color3d_white);
 
-static void Display_Font(gx3dObject *billboard, char ch, gx3dMatrix m, gx3dTexture tex) {
-	float u, v;
+	// Draw object when time is > 0
+	if (FX_Matrices(normal, position, scale, duration, time, repeat, &world, &texture)) {
 
-	switch (ch) {
+		// Translate into world
+		Transform_Set(obj_hud, billboard, &world);
+		Transform_Update(obj_hud);
 
-	case '0': u = 0; v = 0;
-		goto display;
+		// Set the texture offset to the current frame
+		gx3d_SetTextureMatrix(0, &texture);
 
-	case '1': u = 0.25; v = 0;
-		goto display;
+		// Set texture and draw object
+		gx3d_SetTexture(0, effect);
+		gx3d_DrawObjectLayer(billboard, 0);
 
-	case '2': u = 0.50; v = 0;
-		goto display;
+	}
 
-	case '3': u = 0.75; v = 0;
-		goto display;
+	Render_State_Texture_Matrix(false);
+	Render_State_Alpha_Testing(false, 0);
+	Render_State_Alpha_Blending(false);
+}
 
-	case '4': u = 0; v = 0.25;
-		goto display;
+/*____________________________________________________________________
+|
+| Function: Queue_FX
+|
+| Input: Called from Render_GameScreen, Draw_Hoshus
+| Output: Same as Play_FX, recorded in the draw list (alpha pass).
+|___________________________________________________________________*/
 
-	case '5': u = 0.25; v = 0.25;
-		goto display;
+static void Queue_FX(gx3dTexture effect, gx3dVector normal, gx3dVector position, gx3dVector scale, float duration, unsigned time, int alpha_test, bool repeat)
+{
+	gx3dObjectLayer *billboard;
+	gx3dMatrix world, texture;
 
-	case '6': u = 0.50; v = 0.25;
-		goto display;
+	if (FX_Matrices(normal, position, scale, duration, time, repeat, &world, &texture)) {
+		billboard = layer_fx;
+		int transform = Draw_List_Transform(obj_hud, billboard, &world);
+		Draw_List_Billboard(DRAW_MATERIAL_FX, effect, transform, billboard, &texture, alpha_test, &position);
+	}
+}
 
-	case '7': u = 0.75; v = 0.25;
-		goto display;
+/*____________________________________________________________________
+|
+| Function: Queue_Impostor
+|
+| Input: Called from Render_GameScreen, Draw_Hoshus
+| Output: Records a camera facing quad showing a whole object in the
+|		  draw list (alpha pass), the billboard layer scaled by size.
+|___________________________________________________________________*/
 
-	case '8': u = 0; v = 0.50;
-		goto display;
+static void Queue_Impostor(gx3dTexture impostor, int material, gx3dVector normal, gx3dVector position, float size)
+{
+	gx3dMatrix world, texture;
 
-	case '9': u = 0.25; v = 0.50;
-		goto display;
+	gx3d_GetScaleMatrix(&m1, size, size, size);
+	gx3d_GetBillboardRotateXYMatrix(&m2, &normal, &heading);
+	gx3d_GetTranslateMatrix(&m3, position.x, position.y, position.z);
+	gx3d_MultiplyMatrix(&m1, &m2, &m1);
+	gx3d_MultiplyMatrix(&m1, &m3, &world);
+	gx3d_GetIdentityMatrix(&texture);
 
-	display:
-		gx3d_GetTranslateTextureMatrix(&m, u, v);
-		layer = gx3d_GetObjectLayer(billboard, "score_fonts");
-		gx3d_SetTextureMatrix(0, &m);
-		gx3d_SetTexture(0, tex);
-		gx3d_DrawObjectLayer(layer, 0);
-		break;
-	}
+	int transform = Draw_List_Transform(obj_hud, layer_fx, &world);
+	Draw_List_Billboard(material, impostor, transform, layer_fx, &texture, IMPOSTOR_ALPHA_TEST, &position);
 }
 
 /*____________________________________________________________________
 |
-| Function: Play_FX
+| Function: FX_Matrices
 |
-| Input: Called from Render_GameScreen
-| Output: Displays and plays an effect with respect to time.
-|		  (Only works on a 4x4 sprite sheet)
+| Input: Called from Play_FX, Queue_FX
+| Output: Computes the billboard matrix and the texture matrix of the
+|		  current frame of an effect.  Returns false if there is
+|		  nothing to draw yet.
 |___________________________________________________________________*/
 
-static void Play_FX(gx3dTexture effect, gx3dVector normal, gx3dVector position, gx3dVector scale, float duration, unsigned time, int alpha_test, bool repeat) 
+static bool FX_Matrices(gx3dVector normal, gx3dVector position, gx3dVector scale, float duration, unsigned time, bool repeat, gx3dMatrix *world, gx3dMatrix *texture)
 {
-
 	// Check first if the desired effect is looping
 	if (repeat)
 		time %= (unsigned)duration;
 	else if (time > duration)
 		time = duration;
 
+	// Draw object when time is > 0
+	if (time == 0)
+		return (false);
+
 	// Initialize local variables;
-	gx3dObjectLayer *billboard;
 	int frame = (int)gx3d_Lerp(0, 15, ((float)(duration - time) / duration));
 	float offset[4] = { 0.75, 0.5, 0.25, 0.0 };
 
-	billboard = gx3d_GetObjectLayer(obj_hud, "fx");
-	gx3d_EnableAlphaBlending();
-	gx3d_EnableAlphaTesting(alpha_test); // 100
-	gx3d_EnableTextureMatrix(0);
-	gx3d_SetAmbientLight(color3d_white);
+	// Translate into world
+	gx3d_GetScaleMatrix(&m1, scale.x, scale.y, scale.z);
+	gx3d_GetBillboardRotateXYMatrix(&m2, &normal, &heading);
+	gx3d_GetTranslateMatrix(&m3, position.x, position.y, position.z);
+	gx3d_MultiplyMatrix(&m1, &m2, &m1);
+	gx3d_MultiplyMatrix(&m1, &m3, world);
 
-	// Draw object when time is > 0
-	if (time > 0) {
+	// Define the texture offset to the current frame
+	gx3d_GetTranslateTextureMatrix(texture, offset[frame % 4], offset[frame / 4]);
 
-		// Translate into world
-		gx3d_GetScaleMatrix(&m1, scale.x, scale.y, scale.z);
-		gx3d_GetBillboardRotateXYMatrix(&m2, &normal, &heading);
-		gx3d_GetTranslateMatrix(&m3, position.x, position.y, position.z);
-		gx3d_MultiplyMatrix(&m1, &m2, &m1);
-		gx3d_MultiplyMatrix(&m1, &m3, &m);
-		gx3d_SetObjectLayerMatrix(obj_hud, billboard, &m);
+	return (true);
+}
 
-		gx3d_Object_UpdateTransforms(obj_hud);
+/*____________________________________________________________________
+|
+| Function: To_Sim_Sphere
+|
+| Input: Called from Render_GameScreen
+| Output: Converts a gx3d bounding sphere to the simulation's sphere type
+|___________________________________________________________________*/
+static simSphere To_Sim_Sphere(gx3dSphere *sphere)
+{
+	simSphere s = { { sphere->center.x, sphere->center.y, sphere->center.z }, sphere->radius };
+	return (s);
+}
 
-		// Define the texture offset to the current frame
-		gx3d_GetTranslateTextureMatrix(&m, offset[frame % 4], offset[frame / 4]);
-		gx3d_SetTextureMatrix(0, &m);
+/*____________________________________________________________________
+|
+| Function: To_Gx3d_Vector
+|
+| Input: Called from Render_GameScreen, Draw_Hoshus
+| Output: Converts a simulation vector to a gx3d vector
+|___________________________________________________________________*/
+static gx3dVector To_Gx3d_Vector(simVector v)
+{
+	gx3dVector u = { v.x, v.y, v.z };
+	return (u);
+}
 
-		// Set texture and draw object
-		gx3d_SetTexture(0, effect);
-		gx3d_DrawObjectLayer(billboard, 0);
+/*____________________________________________________________________
+|
+| Function: Projectile_Position
+|
+| Input: Called from Render_GameScreen, Draw_Hoshus
+| Output: Position of projectile i at the time being drawn, in the
+|   character's frame (moved back along its velocity by the draw lag)
+|___________________________________________________________________*/
+static gx3dVector Projectile_Position(const SimFrame *sim, const SimDraw *draw, int i)
+{
+	const Projectiles *projectiles = &sim->projectiles;
+	gx3dVector u = {
+		projectiles->x[i] - projectiles->vx[i] * draw->lag,
+		projectiles->y[i] - projectiles->vy[i] * draw->lag,
+		SIM_DRAW_Z(draw, projectiles->z[i] - projectiles->vz[i] * draw->lag)
+	};
+	return (u);
+}
+
+/*____________________________________________________________________
+|
+| Function: Find_Layer
+|
+| Input: Called from Init_LoadingScreen, Init_TitleScreen, Init_GameScreen,
+|		 Init_GameOverScreen (and in place of any gx3d_GetObjectLayer
+|		 call in this file)
+| Output: Looks up an object layer by name and counts the lookup.  Only
+|		  called when loading, the screens draw through the layer
+|		  handles found here.
+|___________________________________________________________________*/
+
+static gx3dObjectLayer *Find_Layer(gx3dObject *object, char *name)
+{
+	layer_lookups++;
+
+	// The parentheses call gx3d itself instead of the macro
+	return ((gx3d_GetObjectLayer)(object, name));
+}
+
+/*____________________________________________________________________
+|
+| Function: Report_Layer_Lookups
+|
+| Input: Called from Render_TitleScreen, Render_GameScreen,
+|		 Render_GameOverScreen
+| Output: Writes to DEBUG.TXT how many layers were looked up by name
+|		  since the screen started drawing (should be 0).
+|___________________________________________________________________*/
+
+static void Report_Layer_Lookups(char *screen, unsigned lookups)
+{
+	char str[100];
+
+	sprintf(str, "%s: %u layer lookups by name while drawing", screen, layer_lookups - lookups);
+	DEBUG_WRITE(str);
+}
+
+/*____________________________________________________________________
+|
+| Function: Begin_Cull
+|
+| Input: Called from Render_GameScreen, Draw_Hoshus
+| Output: Empties the bounding spheres to cull.
+|___________________________________________________________________*/
+
+static void Begin_Cull()
+{
+	cull_bounds.count = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Add_Cull_Bound
+|
+| Input: Called from Render_GameScreen, Draw_Hoshus
+| Output: Adds the bounding sphere (in view of the eye) of what index
+|		  stands for.
+|___________________________________________________________________*/
+
+static void Add_Cull_Bound(gx3dVector center, float radius, int index)
+{
+	int i = cull_bounds.count;
+
+	if (i == MAX_CULL_BOUNDS)
+		return;
+	cull_bounds.x[i] = center.x;
+	cull_bounds.y[i] = center.y;
+	cull_bounds.z[i] = center.z;
+	cull_bounds.radius[i] = radius;
+	cull_bounds.index[i] = index;
+	cull_bounds.count++;
+}
+
+/*____________________________________________________________________
+|
+| Function: Cull
+|
+| Input: Called from Render_GameScreen, Draw_Hoshus
+| Output: Tests the bounding spheres against the frustum of the frame.
+|		  CULL_VISIBLE(cull_bounds.visible, i) tells if sphere i is
+|		  drawn.
+|___________________________________________________________________*/
+
+static void Cull()
+{
+	int num_visible = Cull_Sphere_Batch(&frustum, cull_bounds.x, cull_bounds.y, cull_bounds.z, cull_bounds.radius, cull_bounds.count, cull_bounds.visible);
+
+	cull_tested += cull_bounds.count;
+	cull_culled += cull_bounds.count - num_visible;
+}
+
+/*____________________________________________________________________
+|
+| Function: Report_Culling
+|
+| Input: Called from Render_GameScreen
+| Output: Writes to DEBUG.TXT how many bounding spheres were tested
+|		  and culled per frame since the last report.
+|___________________________________________________________________*/
 
+static void Report_Culling(char *screen)
+{
+	char str[100];
+
+	if (cull_frames) {
+		sprintf(str, "%s: %u bounding spheres tested, %u culled per frame", screen, cull_tested / cull_frames, cull_culled / cull_frames);
+		DEBUG_WRITE(str);
 	}
+	cull_frames = 0;
+	cull_tested = 0;
+	cull_culled = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Load_Lods
+|
+| Input: Called from Init_GameScreen
+| Output: Loads the coarser meshes of an object (format is the file name
+|		  with %d for the level, starting at 1) into objects[1] and
+|		  after, up to the first file that is not there.  Returns the
+|		  number of mesh levels, counting the full mesh in objects[0].
+|___________________________________________________________________*/
 
-	gx3d_DisableTextureMatrix(0);
-	gx3d_DisableAlphaTesting();
-	gx3d_DisableAlphaBlending();
+static int Load_Lods(char *format, gx3dObject **objects, int vertex_format, int flags)
+{
+	char filename[100];
+	int num_meshes = 1;
+
+	for (int level = 1; level < MAX_LOD_LEVELS; level++) {
+		objects[level] = 0;
+		sprintf(filename, format, level);
+		if (num_meshes == level && File_Exists(filename)) {
+			objects[level] = Asset_Object(filename, vertex_format, flags, 0);
+			if (objects[level])
+				num_meshes++;
+		}
+	}
+
+	return (num_meshes);
 }
 
 /*____________________________________________________________________
 |
-| Function: Inverse_Lerp
+| Function: Load_Impostor
 |
-| Input: Called from Render_GameScreen and position.cpp
-| Output: Similar to gx3d_Lerp but calculates with decreasing values
+| Input: Called from Init_GameScreen
+| Output: Loads an impostor texture, or returns 0 if it is not there.
 |___________________________________________________________________*/
-float Inverse_Lerp(float start, float end, float t) 
+
+static gx3dTexture Load_Impostor(char *filename, char *alpha_filename)
 {
-	return (start - (1.0f - t) * (start - end));
+	if (!File_Exists(filename) || !File_Exists(alpha_filename))
+		return (0);
+
+	return (Asset_Texture(filename, alpha_filename, 0));
+}
+
+/*____________________________________________________________________
+|
+| Function: File_Exists
+|
+| Input: Called from Load_Lods, Load_Impostor
+| Output: Returns true if a file can be opened.
+|___________________________________________________________________*/
+
+static bool File_Exists(char *filename)
+{
+	FILE *fp = fopen(filename, "rb");
+
+	if (fp == NULL)
+		return (false);
+	fclose(fp);
+	return (true);
+}
+
+/*____________________________________________________________________
+|
+| Function: Eye_Distance
+|
+| Input: Called from Render_GameScreen, Draw_Hoshus
+| Output: Returns the distance from the camera to a point.
+|___________________________________________________________________*/
+
+static float Eye_Distance(gx3dVector *point)
+{
+	gx3dVector d = { point->x - position.x, point->y - position.y, point->z - position.z };
+	return (gx3d_VectorMagnitude(&d));
+}
+
+/*____________________________________________________________________
+|
+| Function: Report_Lod
+|
+| Input: Called from Render_GameScreen
+| Output: Writes to DEBUG.TXT how many instances were drawn at each
+|		  detail level per frame since the last report.
+|___________________________________________________________________*/
+
+static void Report_Lod(char *screen)
+{
+	char str[200];
+
+	if (cull_frames) {
+		sprintf(str, "%s: %u full, %u lod 1, %u lod 2, %u impostor draws per frame", screen,
+			lod_drawn[0] / cull_frames, lod_drawn[1] / cull_frames, lod_drawn[2] / cull_frames, lod_drawn[3] / cull_frames);
+		DEBUG_WRITE(str);
+	}
+	for (int i = 0; i <= MAX_LOD_LEVELS; i++)
+		lod_drawn[i] = 0;
 }
 
 /*____________________________________________________________________
@@ -4465,8 +3642,11 @@ static void Update_Light(gx3dLight *light, gx3dColor color, gx3dVector *position
 
 static void Init_Render_State(void)
 {
+	// The device state was reset
+	Render_State_Reset();
+
 	// Enable zbuffering
-	gx3d_EnableZBuffer();
+	Render_State_Z_Buffer(true);
 
 	// Enable lighting
 	gx3d_EnableLighting();
@@ -0,0 +1,354 @@
+/*____________________________________________________________________
+|
+| File: renderstate.cpp
+|
+| Description: Render state cache.  The screens switch blending, the
+|   z buffer, fog, specular lighting, the ambient light and the
+|   projection many times a frame, mostly to the value already set.
+|   Every state starts unknown (always issued), then only changes are
+|   passed on to gx3d.
+|
+| Functions: Render_State_Reset
+|            Render_State_Begin_Frame
+|            Render_State_Alpha_Blending
+|            Render_State_Alpha_Testing
+|            Render_State_Z_Buffer
+|            Render_State_Fog
+|            Render_State_Specular_Lighting
+|            Render_State_Texture_Matrix
+|            Render_State_Ambient_Light
+|            Render_State_Projection
+|            Render_State_Frame_Stats
+|            Render_State_Report
+|             Changed
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <first_header.h>
+#include "dp.h"
+
+#include "renderstate.h"
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define STATE_UNKNOWN	-1
+
+/*___________________
+|
+| Type definitions
+|__________________*/
+
+// Values last sent to gx3d (STATE_UNKNOWN, 0 or 1 for the switches)
+struct Render_State {
+	int alpha_blending;
+	int alpha_testing, alpha_reference;
+	int z_buffer;
+	int fog;
+	int specular_lighting;
+	int texture_matrix;
+	bool ambient_known;
+	gx3dColor ambient;
+	bool projection_known;
+	float fov, near_plane, far_plane;
+};
+
+/*___________________
+|
+| Function prototypes
+|__________________*/
+
+static bool Changed (int *state, bool enable);
+
+/*___________________
+|
+| Global variables
+|__________________*/
+
+static Render_State state = {
+	STATE_UNKNOWN,
+	STATE_UNKNOWN, 0,
+	STATE_UNKNOWN,
+	STATE_UNKNOWN,
+	STATE_UNKNOWN,
+	STATE_UNKNOWN,
+	false, { 0, 0, 0, 0 },
+	false, 0, 0, 0
+};
+
+// Calls issued and filtered in the current frame, the last frame and
+// all the frames since the last report
+static unsigned issued, filtered;
+static unsigned last_issued, last_filtered;
+static unsigned total_issued, total_filtered, total_frames;
+
+/*____________________________________________________________________
+|
+| Function: Render_State_Reset
+|
+| Input: Called from Init_Render_State, RESTORE_PROGRAM_WITH_MOUSE
+| Output: Forgets every cached state.
+|___________________________________________________________________*/
+
+void Render_State_Reset ()
+{
+	state.alpha_blending = STATE_UNKNOWN;
+	state.alpha_testing = STATE_UNKNOWN;
+	state.z_buffer = STATE_UNKNOWN;
+	state.fog = STATE_UNKNOWN;
+	state.specular_lighting = STATE_UNKNOWN;
+	state.texture_matrix = STATE_UNKNOWN;
+	state.ambient_known = false;
+	state.projection_known = false;
+}
+
+/*____________________________________________________________________
+|
+| Function: Render_State_Begin_Frame
+|
+| Input: Called from Display_LoadingScreen, Render_TitleScreen,
+|   Render_GameScreen, Render_GameOverScreen
+| Output: Keeps the counts of the frame that ended and starts new ones.
+|___________________________________________________________________*/
+
+void Render_State_Begin_Frame ()
+{
+	last_issued = issued;
+	last_filtered = filtered;
+	total_issued += issued;
+	total_filtered += filtered;
+	total_frames++;
+	issued = 0;
+	filtered = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Render_State_Alpha_Blending
+|
+| Input: Called from render.cpp, Draw_List_Execute
+| Output: Enables or disables alpha blending.
+|___________________________________________________________________*/
+
+void Render_State_Alpha_Blending (bool enable)
+{
+	if (Changed (&state.alpha_blending, enable)) {
+		if (enable)
+			gx3d_EnableAlphaBlending ();
+		else
+			gx3d_DisableAlphaBlending ();
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Render_State_Alpha_Testing
+|
+| Input: Called from Play_FX, Draw_List_Execute
+| Output: Enables alpha testing with a reference value, or disables it
+|   (reference is then ignored).
+|___________________________________________________________________*/
+
+void Render_State_Alpha_Testing (bool enable, int reference)
+{
+	if (enable AND state.alpha_testing == 1 AND reference != state.alpha_reference)
+		state.alpha_testing = STATE_UNKNOWN;
+
+	if (Changed (&state.alpha_testing, enable)) {
+		if (enable) {
+			gx3d_EnableAlphaTesting (reference);
+			state.alpha_reference = reference;
+		}
+		else
+			gx3d_DisableAlphaTesting ();
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Render_State_Z_Buffer
+|
+| Input: Called from render.cpp
+| Output: Enables or disables the z buffer.
+|___________________________________________________________________*/
+
+void Render_State_Z_Buffer (bool enable)
+{
+	if (Changed (&state.z_buffer, enable)) {
+		if (enable)
+			gx3d_EnableZBuffer ();
+		else
+			gx3d_DisableZBuffer ();
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Render_State_Fog
+|
+| Input: Called from Draw_List_Execute
+| Output: Enables or disables fog.
+|___________________________________________________________________*/
+
+void Render_State_Fog (bool enable)
+{
+	if (Changed (&state.fog, enable)) {
+		if (enable)
+			gx3d_EnableFog ();
+		else
+			gx3d_DisableFog ();
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Render_State_Specular_Lighting
+|
+| Input: Called from render.cpp, Draw_List_Execute
+| Output: Enables or disables specular lighting.
+|___________________________________________________________________*/
+
+void Render_State_Specular_Lighting (bool enable)
+{
+	if (Changed (&state.specular_lighting, enable)) {
+		if (enable)
+			gx3d_EnableSpecularLighting ();
+		else
+			gx3d_DisableSpecularLighting ();
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Render_State_Texture_Matrix
+|
+| Input: Called from render.cpp, Draw_List_Execute
+| Output: Enables or disables the texture matrix of texture stage 0.
+|___________________________________________________________________*/
+
+void Render_State_Texture_Matrix (bool enable)
+{
+	if (Changed (&state.texture_matrix, enable)) {
+		if (enable)
+			gx3d_EnableTextureMatrix (0);
+		else
+			gx3d_DisableTextureMatrix (0);
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Render_State_Ambient_Light
+|
+| Input: Called from render.cpp, Draw_List_Execute
+| Output: Sets the ambient light.
+|___________________________________________________________________*/
+
+void Render_State_Ambient_Light (gx3dColor color)
+{
+	if (state.ambient_known AND color.r == state.ambient.r AND color.g == state.ambient.g AND color.b == state.ambient.b AND color.a == state.ambient.a) {
+		filtered++;
+		return;
+	}
+	gx3d_SetAmbientLight (color);
+	state.ambient = color;
+	state.ambient_known = true;
+	issued++;
+}
+
+/*____________________________________________________________________
+|
+| Function: Render_State_Projection
+|
+| Input: Called from render.cpp, Draw_List_Execute
+| Output: Sets the projection matrix.
+|___________________________________________________________________*/
+
+void Render_State_Projection (float fov, float near_plane, float far_plane)
+{
+	if (state.projection_known AND fov == state.fov AND near_plane == state.near_plane AND far_plane == state.far_plane) {
+		filtered++;
+		return;
+	}
+	gx3d_SetProjectionMatrix (fov, near_plane, far_plane);
+	state.fov = fov;
+	state.near_plane = near_plane;
+	state.far_plane = far_plane;
+	state.projection_known = true;
+	issued++;
+}
+
+/*____________________________________________________________________
+|
+| Function: Render_State_Frame_Stats
+|
+| Input: Called from Render_State_Report
+| Output: Returns the calls issued and filtered in the last whole frame.
+|___________________________________________________________________*/
+
+void Render_State_Frame_Stats (unsigned *issued_calls, unsigned *filtered_calls)
+{
+	*issued_calls = last_issued;
+	*filtered_calls = last_filtered;
+}
+
+/*____________________________________________________________________
+|
+| Function: Render_State_Report
+|
+| Input: Called from Render_TitleScreen, Render_GameScreen,
+|   Render_GameOverScreen
+| Output: Writes to DEBUG.TXT the average calls issued and filtered per
+|   frame since the last report, and starts counting again.
+|___________________________________________________________________*/
+
+void Render_State_Report (char *screen)
+{
+	char str[200];
+	unsigned frame_issued, frame_filtered;
+
+	Render_State_Frame_Stats (&frame_issued, &frame_filtered);
+	if (total_frames) {
+		sprintf (str, "%s: %u render state calls issued, %u filtered per frame (last frame %u, %u) over %u frames",
+			screen, total_issued / total_frames, total_filtered / total_frames, frame_issued, frame_filtered, total_frames);
+		DEBUG_WRITE (str);
+	}
+
+	total_issued = 0;
+	total_filtered = 0;
+	total_frames = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Changed
+|
+| Input: Called from the Render_State switches
+| Output: Returns true and records the new value if a switch changes
+|   (or was unknown), counting the call as issued or filtered.
+|___________________________________________________________________*/
+
+static bool Changed (int *switch_state, bool enable)
+{
+	int value = enable ? 1 : 0;
+
+	if (*switch_state == value) {
+		filtered++;
+		return (false);
+	}
+	*switch_state = value;
+	issued++;
+	return (true);
+}
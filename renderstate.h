@@ -0,0 +1,35 @@
+/*____________________________________________________________________
+|
+| File: renderstate.h
+|
+| Description: Cache of the gx3d render states that are switched during
+|   a frame.  Each setter remembers the value last sent to gx3d and drops
+|   calls that would not change it, counting the calls issued and
+|   filtered.  Everything that switches these states must go through
+|   here, or the cache no longer knows what is set.
+|   Include after dp.h.
+|___________________________________________________________________*/
+
+// Forgets every cached state, so the next call to each setter is issued
+// (call after the device state was reset or changed behind the cache)
+void Render_State_Reset ();
+
+// Starts counting the calls of a new frame
+void Render_State_Begin_Frame ();
+
+void Render_State_Alpha_Blending (bool enable);
+void Render_State_Alpha_Testing (bool enable, int reference);
+void Render_State_Z_Buffer (bool enable);
+void Render_State_Fog (bool enable);
+void Render_State_Specular_Lighting (bool enable);
+void Render_State_Texture_Matrix (bool enable); // texture stage 0
+void Render_State_Ambient_Light (gx3dColor color);
+void Render_State_Projection (float fov, float near_plane, float far_plane);
+
+// Gets the number of calls issued to gx3d and filtered out in the last
+// whole frame
+void Render_State_Frame_Stats (unsigned *issued, unsigned *filtered);
+
+// Writes to DEBUG.TXT the calls issued and filtered per frame since the
+// last report
+void Render_State_Report (char *screen);
@@ -0,0 +1,1746 @@
+/*____________________________________________________________________
+|
+| File: sim.cpp
+|
+| Description: Gameplay simulation for the game screen.  Everything that
+|   changes the state of the game (spawning, lasers, blade hits, scoring,
+|   levelling and game state transitions) happens here.  Sounds, lights
+|   and effects are reported to the renderer as events.
+|
+| Functions: Sim_Init
+|            Sim_Update
+|            Sim_Get_Frame
+|             Run_Step
+|             Update_Timers
+|             Update_Speed
+|             Update_Levels
+|             Process_Input
+|             Update_World
+|             Rebase_World
+|             Update_Starting
+|             Update_Health_Pad
+|             Spawn_Hoshu
+|             Update_Hoshus
+|              Aim_Hoshus
+|             Update_Blade
+|             Update_Projectiles
+|              Move_Projectiles
+|             Schedule_Laser_Hit
+|             Reschedule_Laser_Hits
+|             Laser_Hit_Time
+|             Queue_Laser_Hit
+|             Cancel_Laser_Hit
+|             Find_Laser_Hit
+|             Update_Raiu
+|             Update_Ending
+|             Defeat_Hoshu
+|             Retire_Hoshus
+|             Find_Hoshu
+|             Fire_Hoshu_Laser
+|             Fire_Projectile
+|             Remove_Projectile
+|             Collide_Moving_Spheres
+|             Add_Event
+|             Add_World_Event
+|             Random_Float
+|             Random_Int
+|             Fast_Acos
+|            Inverse_Lerp
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include "sim.h"
+#include "collide.h"
+#include "jobs.h"
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define HOSHU_ROTATE_LEFT_MAX	((float)-80)
+#define HOSHU_ROTATE_RIGHT_MAX	((float)80)
+#define RAD_TO_DEG				((float)57.29577951)
+#define REBASE_DISTANCE			((float)16384.0) // scroll after which stored z values are moved back near 0 (keeps float precision)
+#define HOSHU_JOB_GRAIN			1024 // Hoshus aimed per job range
+#define PROJECTILE_JOB_GRAIN	2048 // projectiles moved per job range
+#define MAX_BATCH_COUNT			(MAX_ENEMY_COUNT > MAX_PROJECTILE_COUNT ? MAX_ENEMY_COUNT : MAX_PROJECTILE_COUNT) // largest batch of spheres tested at once
+
+/*___________________
+|
+| Type definitions
+|__________________*/
+
+// A character laser hit waiting to happen
+struct Laser_Hit {
+	unsigned time;						// laser_clock time of impact (milliseconds)
+	int laser;							// projectile slot of the character's laser (its target is the Hoshu that will be hit)
+};
+
+/*___________________
+|
+| Function prototypes
+|__________________*/
+
+static void Run_Step (SimInput *input, unsigned elapsed_time);
+static void Update_Timers (unsigned elapsed_time);
+static void Update_Speed (unsigned elapsed_time);
+static void Update_Levels ();
+static void Process_Input (SimInput *input);
+static void Update_World (SimInput *input);
+static void Rebase_World ();
+static void Update_Starting (SimInput *input, unsigned elapsed_time);
+static void Update_Health_Pad (SimInput *input);
+static void Spawn_Hoshu (SimInput *input);
+static void Update_Hoshus (SimInput *input, unsigned elapsed_time, bool running);
+static void Aim_Hoshus (void *, int start, int end);
+static void Update_Blade (bool running);
+static void Update_Projectiles (unsigned elapsed_time, bool running);
+static void Move_Projectiles (void *data, int start, int end);
+static void Schedule_Laser_Hit (int i);
+static void Reschedule_Laser_Hits (int i);
+static bool Laser_Hit_Time (int laser, int i, float *collision_time);
+static void Queue_Laser_Hit (int i, unsigned time);
+static void Cancel_Laser_Hit (int i);
+static int Find_Laser_Hit (int i);
+static void Update_Raiu (unsigned elapsed_time);
+static void Update_Ending (SimInput *input, unsigned elapsed_time);
+static void Defeat_Hoshu (int i);
+static void Retire_Hoshus ();
+static int Find_Hoshu (float z, bool after);
+static void Fire_Hoshu_Laser (int i);
+static int Fire_Projectile (simVector *pos, simVector *direction, float speed, float radius, unsigned owner, int damage);
+static void Remove_Projectile (int i);
+static bool Collide_Moving_Spheres (simSphere *s1, simTrajectory *t1, float max_time, simSphere *s2, simTrajectory *t2, float *collision_time);
+static void Add_Event (int type, int index, simVector *pos);
+static void Add_World_Event (int type, int index, simVector *pos);
+static float Random_Float ();
+static int Random_Int (int low, int high);
+static float Fast_Acos (float x);
+
+/*___________________
+|
+| Global variables
+|__________________*/
+
+static SimFrame frame;
+static SimConfig config;
+static unsigned random_state;
+
+// Fixed steps
+static unsigned step_time_left; // time not simulated yet, less than SIM_STEP_TIME after an update (milliseconds)
+static unsigned pending_buttons; // presses that are waiting for the next step
+
+// Spawning
+static unsigned enemy_spawn_timer, spawn_timer_limit, heal_spawn_timer, heal_spawn_timer_limit;
+static float enemy_spawn_chance, heal_spawn_chance;
+static float spawn_structure_distance, structure_interval, structure_spawn_chance;
+static int structure_index;
+
+// Weapons
+static unsigned raiu_laser_delay_limit, hoshu_laser_delay_limit;
+static float raiu_laser_speed, hoshu_laser_speed;
+static Laser_Hit laser_hits[MAX_PROJECTILE_COUNT]; // queued character laser hits, earliest first
+static int num_laser_hits;
+static int raiu_laser[MAX_PROJECTILE_COUNT]; // slots of the character's lasers in flight
+static int num_raiu_lasers;
+static unsigned laser_clock; // time the character lasers have been moving (milliseconds)
+
+// Levels
+static int raiu_levels[MAX_LV], hoshu_levels[MAX_LV];
+
+// Spheres gathered for Collide_Sphere_Batch
+static float batch_x[MAX_BATCH_COUNT], batch_y[MAX_BATCH_COUNT], batch_z[MAX_BATCH_COUNT], batch_radius[MAX_BATCH_COUNT];
+static unsigned batch_hits[COLLIDE_MASK_WORDS(MAX_BATCH_COUNT)];
+static float flat_y[MAX_PROJECTILE_COUNT], zero_radius[MAX_PROJECTILE_COUNT]; // projectiles are tested against the character on the xz plane
+
+// Starting state
+static float entrance_delay_limit;
+static bool speed_initialized, sfx_initialized;
+
+/*____________________________________________________________________
+|
+| Function: Sim_Init
+|
+| Input: Called from Render_GameScreen
+| Output: Resets the game to its starting state.
+|___________________________________________________________________*/
+
+void Sim_Init (SimConfig *sim_config)
+{
+	Raiu *raiu = &frame.raiu;
+
+	config = *sim_config;
+	random_state = config.seed ? config.seed : 1;
+
+	//========== Game variables ==========//
+	frame.state =					STATE_STARTING;
+	frame.score =					0;
+	frame.game_timer =				0; // amount of time since the game has started
+	frame.enemies_defeated =		0; // number of enemies defeated so far
+	frame.hoshus_defeated =			0; // number of Hoshus defeated so far
+	frame.current_max_enemy_count =	MAX_ENEMY_COUNT / MAX_LV; // Increases depending on the max number of levels
+	frame.speed =					NORMAL_SPEED;
+	frame.spd_multiplier =			1;
+	frame.distance =				0; // the amount of distance traveled based on the elapsed time (amount of shift performed in the world)
+	frame.scroll =					0; // the world has not moved yet
+	frame.draw.scroll =				0;
+	frame.draw.lag =				0;
+	frame.steps =					0;
+	step_time_left =				0;
+	pending_buttons =				0;
+	frame.num_events =				0;
+	enemy_spawn_chance =			0.05f; // 5% chance of spawning an enemy for every loop after the spawn cooldown timer expires
+	heal_spawn_chance =				0.0001f; // hp > 75%: 0.01% chance of spawning for every loop || hp < 75%: 1% chance of spawning an electric fence for every loop
+
+	//========== Timers ==========//
+	frame.ani_raiu_run_time =		-1;
+	frame.ani_raiu_entrance_time =	-1;
+	frame.ani_raiu_ending_time =	-1;
+	frame.game_ending_speed_timer =	0; // timer for the game ending state (used for "lerp-ing" the speed at the beginning of the state)
+	frame.entrance_delay_timer =	0;
+	frame.level_up_fx_timer =		-1; // timer for the level up effect when the character levels up
+	frame.heal_fx_timer =			-1; // timer for the heal effect when the character regains health
+	entrance_delay_limit =			1000.0f; // 1 second entrance animation delay
+	raiu_laser_delay_limit =		250; // 0.25 seconds
+	hoshu_laser_delay_limit =		1000; // 1 second enemy laser delay
+	spawn_timer_limit =				1000; // 1 second until able to spawn an object
+	enemy_spawn_timer =				spawn_timer_limit; // able to spawn an enemy after the game starts
+	heal_spawn_timer_limit =		60000; // 1 minute cooldown timer for an electric fence to spawn
+	heal_spawn_timer =				0;
+
+	//========== Booleans ==========//
+	sfx_initialized =				false;
+	speed_initialized =				false;
+	frame.play_swing_1 =			false;
+	frame.play_swing_2 =			false;
+	frame.blade_active =			false; // is the character swinging his blade?
+
+	//========== World Parameters ==========//
+	frame.ground_init_z =			-200;
+	frame.ground_1_z =				frame.ground_init_z;
+	frame.ground_2_z =				frame.ground_1_z + MAX_GROUND_LENGTH;
+	spawn_structure_distance =		0; // total distance traveled since the last spawned structure
+	structure_interval =			1000; // distance in feet that needs to be traveled before spawning a new structure
+	structure_spawn_chance =		0.10f; // 10% spawn chance for a structure to spawn on every loop where spawn structure distance >= structure interval
+	structure_index =				0; // current index of the next structure element in the world structure array
+
+	for (int i = 0; i < MAX_STRUCTURE_COUNT; i++)
+		frame.structure[i].spawned = false; // world structures are updated and set to default values when being spawned dynamically
+
+	//========== Character Parameters ==========//
+	raiu->sphere =					config.raiu_sphere;
+	raiu->hp =						RAIU_MAX_HP;
+	raiu->blade_lv =				1;
+	raiu->blade_damage =			40 * raiu->blade_lv; // 10 blade levels : {40, 80, 120, 160, 200, 240, 280, 320, 360, 400}
+	raiu->blade_delay =				750; // each swings last for 0.75 second
+	raiu->blade_timer =				-1; // timer for blade swing (deactivated when value is at -1)
+	raiu->gun_lv =					1;
+	raiu->gun_damage =				25 * raiu->gun_lv; // 10 gun levels : {25, 50, 75, 100, 125, 150, 175, 200, 225, 250}
+	raiu->gun_delay =				raiu_laser_delay_limit;
+	raiu->gun_timer =				raiu->gun_delay; // start off being able to shoot
+	raiu->exp =						0;
+	raiu_laser_speed =				1000.0f; // 1000 ft per second
+	num_laser_hits =				0;
+	num_raiu_lasers =				0;
+	laser_clock =					0;
+
+	//========== Enemy Parameters ==========//
+	frame.hoshu_lv =				1;
+	frame.enemies.first =			0;
+	frame.enemies.count =			0; // Hoshus are set to default values when being spawned dynamically
+	frame.enemies.live =			0;
+	frame.enemies.next_id =			1;
+	hoshu_laser_speed =				750.0f; // 750 ft per second (slower than the character's laser speed to give the players time to react)
+
+	//========== Projectile Parameters ==========//
+	frame.projectiles.count =		0;
+	frame.projectiles.used =		0; // slots are set to default values when a laser is fired
+	frame.projectiles.num_free =	0;
+	for (int i = 0; i < MAX_PROJECTILE_COUNT; i++) {
+		frame.projectiles.live[i] =	false;
+		flat_y[i] =					config.raiu_sphere.center.y;
+	}
+
+	//========== Level Up Parameters ==========//
+	for (int i = 0; i < MAX_LV; i++) {
+		if (i == 0) {
+			raiu_levels[i] =		1000; // Raiu first levels up after gaining 1000 exp
+			hoshu_levels[i] =		20; // Hoshus first levels up after defeating 20 of them
+		}
+		else {
+			raiu_levels[i] =		raiu_levels[i - 1] * 2; // 2x exponential increase in experience points required
+			hoshu_levels[i] =		hoshu_levels[i - 1] * 2; // 2x exponential increase in number of Hoshus defeated until Hoshus level
+		}
+	}
+
+	//========== Health Pad (Electric Fence) Parameters ==========//
+	frame.heal_pad =				Health_Pad();
+	frame.heal_pad.sphere =			config.fence_sphere;
+	frame.heal_pad.pos =			{ 0, 0, 4000 }; // position of the electric fence in the world (changes dynamically)
+	frame.heal_pad.heal_amt =		RAIU_MAX_HP / 4; // electric fence heal 25% of max health
+}
+
+/*____________________________________________________________________
+|
+| Function: Sim_Update
+|
+| Input: Called from Render_GameScreen
+| Output: Adds elapsed_time milliseconds to the time waiting to be
+|   simulated and runs as many fixed steps as fit in it (at most
+|   SIM_MAX_STEPS).  Returns the new state of the game, with the events
+|   of all the steps that were run.
+|___________________________________________________________________*/
+
+const SimFrame *Sim_Update (SimInput *input, unsigned elapsed_time)
+{
+	SimInput step_input = *input;
+	unsigned presses = SIM_INPUT_FIRE | SIM_INPUT_SWING;
+
+	frame.num_events = 0;
+
+	// Presses wait for the next step if none is due yet
+	pending_buttons |= input->buttons & presses;
+
+	// Drop the time that can't be caught up after a hitch (the game slows down instead of jumping ahead)
+	step_time_left += elapsed_time;
+	if (step_time_left > SIM_MAX_STEPS * SIM_STEP_TIME)
+		step_time_left = SIM_MAX_STEPS * SIM_STEP_TIME;
+
+	while (step_time_left >= SIM_STEP_TIME) {
+		step_input.buttons = (input->buttons & ~presses) | pending_buttons;
+		pending_buttons = 0;
+		Run_Step (&step_input, SIM_STEP_TIME);
+		step_time_left -= SIM_STEP_TIME;
+	}
+
+	// The world is drawn between the last two steps, lagging the last one by the part of a step not simulated yet
+	float lag = (float)(SIM_STEP_TIME - step_time_left) / SIM_STEP_TIME;
+	frame.draw.scroll = frame.scroll - frame.distance * lag;
+	frame.draw.lag = lag * (SIM_STEP_TIME / 1000.0f);
+
+	return (&frame);
+}
+
+/*____________________________________________________________________
+|
+| Function: Run_Step
+|
+| Input: Called from Sim_Update
+| Output: Advances the game by elapsed_time milliseconds.
+|___________________________________________________________________*/
+
+static void Run_Step (SimInput *input, unsigned elapsed_time)
+{
+	frame.steps++;
+
+	Update_Timers (elapsed_time);
+
+	// Update the character's position and heading
+	frame.raiu.pos = input->pos;
+	frame.raiu.view = input->view;
+
+	Update_Speed (elapsed_time);
+	Update_Levels ();
+	if (frame.state == STATE_RUNNING AND NOT input->paused)
+		Process_Input (input);
+	Update_World (input);
+
+	switch (frame.state) {
+	case STATE_STARTING:
+		Update_Starting (input, elapsed_time);
+		break;
+	case STATE_RUNNING:
+		Update_Health_Pad (input);
+		Spawn_Hoshu (input);
+		Update_Hoshus (input, elapsed_time, true);
+		Update_Projectiles (elapsed_time, true);
+		Update_Raiu (elapsed_time);
+		break;
+	case STATE_GAME_ENDING:
+		Update_Hoshus (input, elapsed_time, false);
+		Update_Projectiles (elapsed_time, false);
+		Update_Ending (input, elapsed_time);
+		break;
+	}
+
+	// Move the character's bounding sphere along with the character
+	frame.raiu.sphere = config.raiu_sphere;
+	frame.raiu.sphere.center.x = frame.raiu.pos.x;
+}
+
+/*____________________________________________________________________
+|
+| Function: Sim_Get_Frame
+|
+| Input: Called from Render_GameScreen, Render_GameOverScreen
+| Output: Returns the state of the game after the last step.
+|___________________________________________________________________*/
+
+const SimFrame *Sim_Get_Frame ()
+{
+	return (&frame);
+}
+
+/*____________________________________________________________________
+|
+| Function: Update_Timers
+|
+| Input: Called from Run_Step
+| Output: Updates gameplay, spawn and cooldown timers.
+|___________________________________________________________________*/
+
+static void Update_Timers (unsigned elapsed_time)
+{
+	// Update gameplay timer
+	if (frame.state == STATE_RUNNING) {
+		frame.game_timer += elapsed_time;
+		// makes sure that the gameplay timer does not exceed 99 hours 59 minutes 59 seconds
+		if (frame.game_timer > MAX_GAME_TIME)
+			frame.game_timer = MAX_GAME_TIME;
+	}
+	else if (frame.state == STATE_GAME_ENDING)
+		frame.game_ending_speed_timer += elapsed_time;
+
+	// Update spawn timers
+	if (enemy_spawn_timer < spawn_timer_limit)
+		enemy_spawn_timer += elapsed_time;
+
+	// Update cooldown timers
+	if (frame.raiu.gun_timer < frame.raiu.gun_delay)
+		frame.raiu.gun_timer += elapsed_time;
+	for (int k = 0; k < frame.enemies.count; k++) {
+		int i = HOSHU_SLOT(&frame.enemies, k);
+		if (frame.enemies.gun_timer[i] < frame.enemies.gun_delay[i])
+			frame.enemies.gun_timer[i] += elapsed_time;
+	}
+
+	// Update health pad spawn timer when timer is < its limit
+	if (heal_spawn_timer < heal_spawn_timer_limit)
+		heal_spawn_timer += elapsed_time;
+}
+
+/*____________________________________________________________________
+|
+| Function: Update_Speed
+|
+| Input: Called from Run_Step
+| Output: Updates the world speed and the distance traveled.
+|___________________________________________________________________*/
+
+static void Update_Speed (unsigned elapsed_time)
+{
+	if (frame.state == STATE_STARTING AND NOT speed_initialized) {
+		frame.speed = 0;
+		speed_initialized = true;
+	}
+	else if (frame.state == STATE_RUNNING)
+		frame.speed = NORMAL_SPEED * frame.spd_multiplier;
+	else if (frame.state == STATE_GAME_ENDING) {
+
+		// Speed gradually slows down at the beginning of game state game ending
+		if (frame.spd_multiplier != 1) {
+			frame.spd_multiplier = 1;
+			frame.speed = NORMAL_SPEED;
+		}
+
+		if (ENDING_SLOWDOWN_DURATION >= frame.game_ending_speed_timer)
+			frame.speed = Inverse_Lerp(NORMAL_SPEED, 0, (ENDING_SLOWDOWN_DURATION - frame.game_ending_speed_timer) / (float)ENDING_SLOWDOWN_DURATION);
+		else
+			frame.speed = 0;
+	}
+
+	// distance travelled = ([speed -> (distance in feet / time in seconds)] * speed multiplier) * (elapsed time in milliseconds to seconds)
+	frame.distance = (frame.speed * frame.spd_multiplier) * (elapsed_time / 1000.0f);
+
+	// update structures spawn distance
+	spawn_structure_distance += frame.distance;
+}
+
+/*____________________________________________________________________
+|
+| Function: Update_Levels
+|
+| Input: Called from Run_Step
+| Output: Levels up the character and the enemies.
+|___________________________________________________________________*/
+
+static void Update_Levels ()
+{
+	Raiu *raiu = &frame.raiu;
+
+	if (raiu->gun_lv < MAX_LV AND (raiu->exp >= raiu_levels[raiu->blade_lv] OR raiu->exp >= raiu_levels[raiu->gun_lv])) {
+		// Update character parameters
+		raiu->blade_lv++;
+		raiu->blade_damage = 50 * raiu->blade_lv;
+		raiu->gun_lv++;
+		raiu->gun_damage = 25 * raiu->gun_lv;
+		raiu->gun_delay = raiu_laser_delay_limit;
+		raiu->gun_timer = raiu->gun_delay; // start off being able to shoot
+		raiu->exp = 0;
+
+		// Activate the level up effects timer
+		frame.level_up_fx_timer = 0;
+		Add_Event (SIM_EVENT_RAIU_LEVEL_UP, -1, &raiu->sphere.center);
+
+		// Increase max number of enemies that can appear on the screen
+		frame.current_max_enemy_count += MAX_ENEMY_COUNT / MAX_LV;
+	}
+	if (frame.hoshu_lv < HOSHU_MAX_LV AND frame.hoshus_defeated >= hoshu_levels[frame.hoshu_lv]) {
+		frame.hoshu_lv++;
+		frame.hoshus_defeated = 0;
+		Add_Event (SIM_EVENT_HOSHU_LEVEL_UP, -1, &raiu->pos);
+	}
+
+	// update health pad spawn chance depending on the character's health
+	if (raiu->hp > RAIU_MAX_HP * 0.75) // 0.01% chance spawn rate for every loop after the cooldown timer expires
+		heal_spawn_chance = 0.0001f;
+	else // 1% chance spawn rate for every loop after the cooldown timer expires
+		heal_spawn_chance = 0.01f;
+}
+
+/*____________________________________________________________________
+|
+| Function: Process_Input
+|
+| Input: Called from Run_Step
+| Output: Applies the player's input while the game is running.
+|___________________________________________________________________*/
+
+static void Process_Input (SimInput *input)
+{
+	Raiu *raiu = &frame.raiu;
+
+	// Run faster or slower while the key is held down
+	if (input->buttons & SIM_INPUT_FAST) {
+		frame.spd_multiplier = 1.75f;
+		spawn_timer_limit = 500;
+	}
+	else if (input->buttons & SIM_INPUT_SLOW) {
+		frame.spd_multiplier = 0.75f;
+		spawn_timer_limit = 2000;
+	}
+	else {
+		frame.spd_multiplier = 1;
+		spawn_timer_limit = 1000;
+	}
+
+	// Shoot a laser beam when cooldown timer for shooting the ray gun has expired
+	if ((input->buttons & SIM_INPUT_FIRE) AND raiu->gun_timer >= raiu->gun_delay) {
+		// Set laser position and trajectory
+		simVector pos = raiu->sphere.center;
+		pos.x += 1.0f; // shift 1.0 ft to the right since the gun is on the right side of the camera view
+		pos.z += frame.scroll;
+		int i = Fire_Projectile (&pos, &raiu->view, raiu_laser_speed, config.laser_sphere.radius, PROJECTILE_OWNER_RAIU, raiu->gun_damage);
+
+		if (i >= 0) {
+			// Reset the cooldown timer
+			raiu->gun_timer = 0;
+			Add_World_Event (SIM_EVENT_RAIU_FIRE, i, &pos);
+
+			// Find out which enemy it will hit, and when
+			Schedule_Laser_Hit (i);
+		}
+	}
+
+	// Swing the blade
+	if (input->buttons & SIM_INPUT_SWING) {
+		// Activate swing timer if not yet activated
+		if (raiu->blade_timer == -1) {
+			raiu->blade_timer = 0;
+			frame.play_swing_1 = true;
+			Add_Event (SIM_EVENT_BLADE_SWING_1, -1, &raiu->pos);
+		}
+		// Activate blade swing 2 when the key is pressed again after a certain time window
+		if (frame.play_swing_1 AND NOT frame.play_swing_2) {
+			if (raiu->blade_timer >= 150 AND raiu->blade_timer <= 350) {
+				frame.play_swing_2 = true;
+				Add_Event (SIM_EVENT_BLADE_SWING_2, -1, &raiu->pos);
+			}
+		}
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Update_World
+|
+| Input: Called from Run_Step
+| Output: Scrolls the world, spawning new structures after a certain
+|   distance is traveled.  Only the scroll offset changes, so nothing
+|   in the world is touched unless it has to be recycled.
+|___________________________________________________________________*/
+
+static void Update_World (SimInput *input)
+{
+	// Move the world towards the back by moving the character's frame forward
+	frame.scroll += frame.distance;
+	if (frame.scroll >= REBASE_DISTANCE)
+		Rebase_World ();
+
+	// If the end of a ground object reaches 100 ft back from the character, it moves to the end of the other ground object
+	float ground_end_z = frame.ground_init_z - MAX_GROUND_LENGTH + frame.scroll;
+	if (frame.ground_1_z <= ground_end_z)
+		frame.ground_1_z = frame.ground_2_z + MAX_GROUND_LENGTH;
+	else if (frame.ground_2_z <= ground_end_z)
+		frame.ground_2_z = frame.ground_1_z + MAX_GROUND_LENGTH;
+
+	// Generate a randomized structure in the world after a certain distance is reached
+	if (spawn_structure_distance >= structure_interval AND NOT input->paused) {
+
+		// Generate a structure based on the spawn chance
+		if (structure_spawn_chance >= Random_Float()) {
+
+			World_Structures *structure = &frame.structure[structure_index];
+			int r = Random_Int(1, 4);
+
+			// Spawn a random world structure
+			structure->type = r;
+
+			// Set structure side depending on the generated structure type
+			if (r == 2) // structure 2 takes up both left and right sides
+				structure->side = STRUCTURE_SIDE_BOTH;
+			else if (Random_Float() > 0.5f) {
+				structure->side = STRUCTURE_SIDE_LEFT; // rotate model 180 degrees to move object to the left side
+				structure->rotated = false;
+			}
+			else
+				structure->side = STRUCTURE_SIDE_RIGHT; // original model is on the right side so no rotation needed
+
+			structure->pos = { 0, 0, 4000 + frame.scroll }; // always spawn new structures 4000 ft away from the character
+			structure->spawned = true;
+
+			structure_index = (structure_index + 1) % MAX_STRUCTURE_COUNT;
+			spawn_structure_distance = 0;
+		}
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Rebase_World
+|
+| Input: Called from Update_World
+| Output: Moves everything in the world back by the scroll offset and
+|   resets the offset to 0.  Nothing moves relative to the character.
+|___________________________________________________________________*/
+
+static void Rebase_World ()
+{
+	Enemy *enemies = &frame.enemies;
+	Projectiles *projectiles = &frame.projectiles;
+	float shift = frame.scroll;
+
+	frame.ground_1_z -= shift;
+	frame.ground_2_z -= shift;
+
+	for (int i = 0; i < MAX_STRUCTURE_COUNT; i++)
+		frame.structure[i].pos.z -= shift;
+
+	frame.heal_pad.pos.z -= shift;
+	frame.heal_pad.sphere.center.z = frame.heal_pad.pos.z;
+
+	for (int k = 0; k < enemies->count; k++) {
+		int i = HOSHU_SLOT(enemies, k);
+		enemies->pos[i].z -= shift;
+		enemies->sphere[i].center.z = enemies->pos[i].z;
+	}
+
+	for (int i = 0; i < projectiles->used; i++)
+		projectiles->z[i] -= shift;
+
+	frame.scroll = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Update_Starting
+|
+| Input: Called from Run_Step
+| Output: Plays the entrance of the character, switching to the running
+|   state once the starting sound effect has finished.
+|___________________________________________________________________*/
+
+static void Update_Starting (SimInput *input, unsigned elapsed_time)
+{
+	// Add to entrance animation delay timer
+	if (frame.entrance_delay_timer < entrance_delay_limit)
+		frame.entrance_delay_timer += elapsed_time;
+
+	if (frame.entrance_delay_timer >= entrance_delay_limit) {
+		// Play opening animation
+		if (NOT sfx_initialized) {
+			Add_Event (SIM_EVENT_INTRO_START, -1, &frame.raiu.pos);
+			sfx_initialized = true;
+		}
+		// Start the game after the starting sound effect
+		else if (input->intro_done) {
+			frame.state = STATE_RUNNING;
+			sfx_initialized = false;
+		}
+	}
+
+	// Start animation timer at first frame
+	if (frame.ani_raiu_entrance_time == -1)
+		frame.ani_raiu_entrance_time = 0;
+	// Add the elapsed frame time to the local timer for the animation
+	else if (frame.entrance_delay_timer >= entrance_delay_limit)
+		frame.ani_raiu_entrance_time += elapsed_time;
+
+	// Update speed after a certain amount of time in the animation
+	if (frame.entrance_delay_timer >= entrance_delay_limit AND frame.ani_raiu_entrance_time >= 2900.0f) {
+		if (frame.speed == 0)
+			frame.speed = NORMAL_SPEED * 5;
+		else if (frame.ani_raiu_entrance_time >= 3200.0f)
+			frame.speed = Inverse_Lerp(NORMAL_SPEED * 5, NORMAL_SPEED, (1000.0f - (frame.ani_raiu_entrance_time - 3200.0f)) / 1000.0f);
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Update_Health_Pad
+|
+| Input: Called from Run_Step
+| Output: Spawns, moves and recycles the electric fence (health pad),
+|   healing the character when touched.
+|___________________________________________________________________*/
+
+static void Update_Health_Pad (SimInput *input)
+{
+	Raiu *raiu = &frame.raiu;
+	Health_Pad *heal_pad = &frame.heal_pad;
+
+	// Spawn an electric fence (health pad)?
+	if (heal_spawn_timer >= heal_spawn_timer_limit AND NOT input->paused AND NOT heal_pad->draw) {
+		if (heal_spawn_chance >= Random_Float()) {
+			// spawn an electric fence with random x position with respect to the boundary
+			heal_pad->pos.x = Random_Float() * (config.boundary_x - 8) * 2 - (config.boundary_x - 8);
+			heal_pad->pos.y = 0; // always on top of the ground
+			heal_pad->pos.z = 3000.0f + frame.scroll; // always spawn 3000 ft away from the character
+			heal_pad->heal_amt = RAIU_MAX_HP / 4; // electric fence heal 25% of max health
+			heal_pad->sphere = config.fence_sphere;
+			heal_pad->sphere.center.x = heal_pad->pos.x;
+			heal_pad->sphere.center.z = heal_pad->pos.z;
+			heal_pad->draw = true;
+			heal_pad->ps_enable = true;
+			Add_World_Event (SIM_EVENT_HEAL_PAD_SPAWN, -1, &heal_pad->sphere.center);
+
+			heal_spawn_chance = 0;
+		}
+	}
+
+	if (NOT heal_pad->draw)
+		return;
+
+	// Check first if the current health pad is behind the camera and needs to be recycled
+	if (heal_pad->pos.z <= frame.ground_init_z + frame.scroll) {
+		heal_pad->draw = false;
+		heal_pad->ps_enable = false;
+
+		// Set timer to half of the limit
+		heal_spawn_timer = heal_spawn_timer_limit / 2;
+		Add_World_Event (SIM_EVENT_HEAL_PAD_DESPAWN, -1, &heal_pad->pos);
+		return;
+	}
+
+	// Determine if the character has touched the pad (a batch of one)
+	simSphere feet = { { raiu->sphere.center.x, raiu->pos.y, raiu->sphere.center.z + frame.scroll }, raiu->sphere.radius };
+	bool touched = Collide_Sphere_Batch (&feet, &heal_pad->pos.x, &heal_pad->pos.y, &heal_pad->pos.z, &heal_pad->sphere.radius, 1, batch_hits) > 0;
+
+	if (touched AND frame.heal_fx_timer == -1) {
+		// Add the heal ouput of the pad to the character's health
+		raiu->hp += heal_pad->heal_amt;
+		if (raiu->hp > RAIU_MAX_HP)
+			raiu->hp = RAIU_MAX_HP;
+
+		// Activate the heal effect timer and disable the particle system
+		frame.heal_fx_timer = 0;
+		heal_pad->ps_enable = false;
+		Add_World_Event (SIM_EVENT_HEAL_PAD_TOUCH, -1, &heal_pad->pos);
+
+		// Reset the spawn timer
+		heal_spawn_timer = 0;
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Spawn_Hoshu
+|
+| Input: Called from Run_Step
+| Output: Spawns an enemy after the spawn timer expires.
+|___________________________________________________________________*/
+
+static void Spawn_Hoshu (SimInput *input)
+{
+	Enemy *enemies = &frame.enemies;
+	int lv = frame.hoshu_lv;
+
+	if (enemy_spawn_timer < spawn_timer_limit OR input->paused OR enemies->live >= frame.current_max_enemy_count OR enemies->count == MAX_ENEMY_COUNT)
+		return;
+	if (enemy_spawn_chance < Random_Float())
+		return;
+
+	// Add the new Hoshu to the back of the ring (it is the farthest one)
+	int i = HOSHU_SLOT(enemies, enemies->count);
+	enemies->count++;
+	enemies->live++;
+	enemies->active[i] = true;
+
+	// spawn a Hoshu with random x position with respect to the boundary
+	enemies->id[i] = enemies->next_id++;
+	enemies->pos[i].x = Random_Float() * config.boundary_x * 2 - config.boundary_x; // left: -boundary | right: +boundary
+	enemies->pos[i].y = 0; // always spawn on top of the floor
+	enemies->pos[i].z = 3000.0f + frame.scroll; // always spawn at the front 3000 ft away from the character
+	enemies->sphere[i].radius = config.hoshu_sphere.radius;
+	enemies->sphere[i].center.x = enemies->pos[i].x;
+	enemies->sphere[i].center.y = config.hoshu_sphere.center.y;
+	enemies->sphere[i].center.z = enemies->pos[i].z;
+	enemies->angle[i] = 0;
+	enemies->lv[i] = lv;
+	enemies->hp[i] = 100 * lv; // 10 hp levels : {100, 200, 300, 400, 500, 600, 700, 800, 900, 1000}
+	enemies->score_amt[i] = 200 * lv; // 10 score levels : {200, 400, 600, 800, 1000, 1200, 1400, 1600, 1800, 2000}
+	enemies->exp_amt[i] = 100 * lv; // 10 exp levels : {100, 200, 300, 400, 500, 600, 700, 800, 900, 1000}
+	enemies->gun_delay[i] = hoshu_laser_delay_limit; // 1 sec shooting delay
+	enemies->gun_timer[i] = 0;
+	enemies->gun_damage[i] = 10 * lv; // 10 gun levels : {10, 20, 30, 40, 50, 60, 70, 80, 90, 100}
+	enemies->fire_rate[i] = Random_Float() * 0.1f; // Generate a randomized fire rate between 0.0 - 0.1
+	enemies->laser_index[i] = -1;
+	enemies->explosion_timer[i] = -1;
+	enemies->explosion_type[i] = -1;
+	enemies->blade_mark_1[i] = false;
+	enemies->blade_mark_2[i] = false;
+
+	// Lasers already flying may hit it first
+	Reschedule_Laser_Hits (i);
+
+	// Reset spawn timer
+	enemy_spawn_timer = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Update_Hoshus
+|
+| Input: Called from Run_Step
+| Output: Moves, damages and recycles all spawned enemies.  While the
+|   game is running enemies aim at the character and shoot.
+|___________________________________________________________________*/
+
+static void Update_Hoshus (SimInput *input, unsigned elapsed_time, bool running)
+{
+	Enemy *enemies = &frame.enemies;
+
+	// Recycle the Hoshus that are behind the camera
+	Retire_Hoshus ();
+
+	// Determine if any Hoshu has taken damage from a blade swing
+	Update_Blade (running);
+
+	// Point every Hoshu at the character (each one only writes its own angle)
+	Jobs_Parallel_For (Aim_Hoshus, 0, enemies->count, HOSHU_JOB_GRAIN);
+
+	for (int k = 0; k < enemies->count; k++) {
+		int i = HOSHU_SLOT(enemies, k);
+
+		if (NOT enemies->active[i])
+			continue;
+
+		// Update the explosion while the Hoshu was just destroyed
+		if (enemies->explosion_timer[i] >= 0) {
+
+			// Generate a randomized explosion effect and sound
+			if (enemies->explosion_type[i] == -1) {
+				enemies->explosion_type[i] = Random_Int(1, 3);
+				Add_World_Event (SIM_EVENT_HOSHU_EXPLODE, enemies->explosion_type[i], &enemies->sphere[i].center);
+			}
+
+			if (enemies->explosion_timer[i] <= FX_NORMAL_DURATION)
+				enemies->explosion_timer[i] += elapsed_time;
+
+			// Removes the Hoshu from the world when the explosion has finished (its slot is freed once it reaches the front)
+			else {
+				enemies->active[i] = false;
+				enemies->live--;
+				Add_World_Event (SIM_EVENT_EXPLOSION_END, -1, &enemies->sphere[i].center);
+			}
+			continue;
+		}
+
+		// Make the enemy shoot a projectile?
+		if (running AND enemies->gun_timer[i] >= enemies->gun_delay[i] AND NOT input->paused)
+			Fire_Hoshu_Laser (i);
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Aim_Hoshus
+|
+| Input: Called from Update_Hoshus (on any job thread)
+| Output: Turns the Hoshus at ring positions start to end - 1 towards
+|   the character, unless they are exploding.
+|___________________________________________________________________*/
+
+static void Aim_Hoshus (void *, int start, int end)
+{
+	Raiu *raiu = &frame.raiu;
+	Enemy *enemies = &frame.enemies;
+
+	for (int k = start; k < end; k++) {
+		int i = HOSHU_SLOT(enemies, k);
+
+		if (NOT enemies->active[i] OR enemies->explosion_timer[i] >= 0)
+			continue;
+
+		// Update the Hoshu view vector to point at the character's xz-coordinates
+		// and compute the angle between it and the Hoshu's normal view vector (0,0,-1)
+		float view_x = -(raiu->pos.x - enemies->pos[i].x);
+		float view_z = (raiu->pos.z + frame.scroll - enemies->pos[i].z);
+		float length = sqrtf(view_x * view_x + view_z * view_z);
+		float angle = 0;
+		if (length > 0) {
+			float cosine = -view_z / length;
+			if (cosine > 1)
+				cosine = 1;
+			else if (cosine < -1)
+				cosine = -1;
+			angle = Fast_Acos(cosine) * RAD_TO_DEG;
+		}
+		if (view_x < 0)
+			angle *= -1;
+
+		// Make sure that angle of rotation does not exceed its max
+		if (angle > HOSHU_ROTATE_RIGHT_MAX)
+			angle = HOSHU_ROTATE_RIGHT_MAX;
+		else if (angle < HOSHU_ROTATE_LEFT_MAX)
+			angle = HOSHU_ROTATE_LEFT_MAX;
+		enemies->angle[i] = angle;
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Update_Blade
+|
+| Input: Called from Update_Hoshus
+| Output: Damages the Hoshus within reach of the character's blade.
+|   Only the Hoshus whose z is close enough to the character are
+|   looked at.
+|___________________________________________________________________*/
+
+static void Update_Blade (bool running)
+{
+	Raiu *raiu = &frame.raiu;
+	Enemy *enemies = &frame.enemies;
+	simSphere reach = raiu->sphere;
+	reach.center.z += frame.scroll;
+	float total_sphere_radius = reach.radius + config.hoshu_sphere.radius;
+
+	// Hoshus only move towards the back, so one that has left this window can't be hit again
+	int start = Find_Hoshu (reach.center.z - total_sphere_radius, false);
+	int end = Find_Hoshu (reach.center.z + total_sphere_radius, true);
+
+	// Reset blade damage markers for the Hoshus back to false when blade is inactive
+	if (NOT (running AND frame.blade_active)) {
+		for (int k = start; k < end; k++) {
+			int i = HOSHU_SLOT(enemies, k);
+			enemies->blade_mark_1[i] = false;
+			enemies->blade_mark_2[i] = false;
+		}
+		return;
+	}
+
+	// Determine which Hoshus are close enough for the blade swing to be considered as a hit
+	for (int k = start; k < end; k++) {
+		int i = HOSHU_SLOT(enemies, k);
+		batch_x[k - start] = enemies->sphere[i].center.x;
+		batch_y[k - start] = enemies->sphere[i].center.y;
+		batch_z[k - start] = enemies->sphere[i].center.z;
+		batch_radius[k - start] = enemies->sphere[i].radius;
+	}
+	if (Collide_Sphere_Batch (&reach, batch_x, batch_y, batch_z, batch_radius, end - start, batch_hits) == 0)
+		return;
+
+	for (int k = start; k < end; k++) {
+		int i = HOSHU_SLOT(enemies, k);
+
+		if (NOT COLLIDE_HIT(batch_hits, k - start) OR NOT enemies->active[i])
+			continue;
+
+		// Subract the damage ouput of the blade to the Hoshu's health when its blade markers have not been set to true
+		if (frame.play_swing_1) { // blade swing 1 is active (always active even when blade swing 2 is active)
+			if (NOT enemies->blade_mark_1[i]) {
+				enemies->hp[i] -= raiu->blade_damage;
+				enemies->blade_mark_1[i] = true;
+			}
+			if (frame.play_swing_2 AND NOT enemies->blade_mark_2[i]) {
+				enemies->hp[i] -= raiu->blade_damage;
+				enemies->blade_mark_2[i] = true;
+			}
+		}
+
+		// Enemy is destroyed if its hp is at 0 or less
+		if (enemies->explosion_timer[i] == -1 AND enemies->hp[i] <= 0)
+			Defeat_Hoshu (i);
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Fire_Hoshu_Laser
+|
+| Input: Called from Update_Hoshus
+| Output: Fires a laser from Hoshu i if its last laser is gone and a
+|   free projectile is available.
+|___________________________________________________________________*/
+
+static void Fire_Hoshu_Laser (int i)
+{
+	Enemy *enemies = &frame.enemies;
+	Projectiles *projectiles = &frame.projectiles;
+
+	// Only one laser in flight per Hoshu
+	int last = enemies->laser_index[i];
+	if (last >= 0 AND projectiles->live[last] AND projectiles->owner[last] == enemies->id[i])
+		return;
+	if (enemies->fire_rate[i] < Random_Float())
+		return;
+
+	// Laser is 0.5 ft below the center of the Hoshu
+	simVector pos = enemies->sphere[i].center;
+	pos.y -= 0.5f;
+
+	// Rotates the trajectory based on the rotation angle of the Hoshu's "top" model layer
+	simVector direction;
+	direction.x = -sinf(enemies->angle[i] / RAD_TO_DEG);
+	direction.y = 0;
+	direction.z = -cosf(enemies->angle[i] / RAD_TO_DEG);
+
+	// The Hoshu lasers are scaled up
+	int index = Fire_Projectile (&pos, &direction, hoshu_laser_speed, config.laser_sphere.radius * HOSHU_LASER_SCALE, enemies->id[i], enemies->gun_damage[i]);
+	if (index == -1)
+		return;
+	enemies->laser_index[i] = index;
+	Add_World_Event (SIM_EVENT_HOSHU_FIRE, -1, &enemies->sphere[i].center);
+
+	// Reset the cooldown timer
+	enemies->gun_timer[i] = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Fire_Projectile
+|
+| Input: Called from Process_Input, Fire_Hoshu_Laser
+| Output: Takes a slot from the projectile pool and starts a laser at
+|   pos moving along direction.  Returns the slot (-1 if the pool is
+|   full).
+|___________________________________________________________________*/
+
+static int Fire_Projectile (simVector *pos, simVector *direction, float speed, float radius, unsigned owner, int damage)
+{
+	Projectiles *projectiles = &frame.projectiles;
+	int i;
+
+	// Reuse a released slot before handing out a new one
+	if (projectiles->num_free > 0)
+		i = projectiles->free_list[--projectiles->num_free];
+	else if (projectiles->used < MAX_PROJECTILE_COUNT)
+		i = projectiles->used++;
+	else
+		return (-1);
+	projectiles->count++;
+
+	projectiles->live[i] = true;
+	projectiles->x[i] = pos->x;
+	projectiles->y[i] = pos->y;
+	projectiles->z[i] = pos->z;
+	projectiles->vx[i] = direction->x * speed;
+	projectiles->vy[i] = direction->y * speed;
+	projectiles->vz[i] = direction->z * speed;
+	projectiles->radius[i] = radius;
+	projectiles->owner[i] = owner;
+	projectiles->damage[i] = damage;
+	projectiles->target[i] = -1;
+	projectiles->hit_timer[i] = -1;
+	projectiles->hit[i] = false;
+	projectiles->destroyed[i] = false;
+	if (owner == PROJECTILE_OWNER_RAIU)
+		raiu_laser[num_raiu_lasers++] = i;
+
+	return (i);
+}
+
+/*____________________________________________________________________
+|
+| Function: Remove_Projectile
+|
+| Input: Called from Update_Projectiles
+| Output: Returns projectile i to the pool.
+|___________________________________________________________________*/
+
+static void Remove_Projectile (int i)
+{
+	Projectiles *projectiles = &frame.projectiles;
+
+	if (projectiles->owner[i] == PROJECTILE_OWNER_RAIU) {
+		Cancel_Laser_Hit (i);
+		for (int n = 0; n < num_raiu_lasers; n++)
+			if (raiu_laser[n] == i) {
+				raiu_laser[n] = raiu_laser[--num_raiu_lasers];
+				break;
+			}
+	}
+
+	projectiles->live[i] = false;
+	projectiles->free_list[projectiles->num_free++] = i;
+	projectiles->count--;
+}
+
+/*____________________________________________________________________
+|
+| Function: Update_Projectiles
+|
+| Input: Called from Run_Step
+| Output: Moves all lasers fired by the character and the enemies.
+|   While the game is running enemy lasers can hit the character and
+|   character lasers damage the enemies they hit.
+|___________________________________________________________________*/
+
+static void Update_Projectiles (unsigned elapsed_time, bool running)
+{
+	Raiu *raiu = &frame.raiu;
+	Enemy *enemies = &frame.enemies;
+	Projectiles *projectiles = &frame.projectiles;
+	float seconds = elapsed_time / 1000.0f;
+	bool any_near = false;
+
+	// Find the lasers near the character on the xz plane (within twice its radius)
+	if (running) {
+		simSphere reach = raiu->sphere;
+		reach.center.z += frame.scroll;
+		reach.radius *= 2;
+		any_near = Collide_Sphere_Batch_Parallel (&reach, projectiles->x, flat_y, projectiles->z, zero_radius, projectiles->used, batch_hits) > 0;
+	}
+
+	for (int i = 0; i < projectiles->used; i++) {
+		if (NOT projectiles->live[i])
+			continue;
+
+		// Remove if projectile goes beyond the max projectile distance
+		if (fabsf(projectiles->x[i]) >= MAX_PROJECTILE_DISTANCE OR fabsf(projectiles->y[i]) >= MAX_PROJECTILE_DISTANCE OR fabsf(projectiles->z[i] - frame.scroll) >= MAX_PROJECTILE_DISTANCE) {
+			Remove_Projectile (i);
+			continue;
+		}
+
+		// Detect if an enemy laser hits the character (distance on the xz plane)
+		if (any_near AND projectiles->owner[i] != PROJECTILE_OWNER_RAIU AND COLLIDE_HIT(batch_hits, i)) {
+			float dx = raiu->sphere.center.x - projectiles->x[i];
+
+			if (fabsf(dx) <= raiu->sphere.radius) {
+
+				// Destroy the laser if blade is active on the time of impact (it slows down)
+				if (frame.blade_active AND NOT projectiles->destroyed[i]) {
+					projectiles->destroyed[i] = true;
+					projectiles->vx[i] *= 0.10f;
+					projectiles->vy[i] *= 0.10f;
+					projectiles->vz[i] *= 0.10f;
+				}
+
+				// Character gets damaged otherwise
+				if (NOT projectiles->hit[i] AND NOT projectiles->destroyed[i]) {
+					Add_Event (SIM_EVENT_RAIU_HURT, -1, &raiu->pos);
+
+					// Subract the damage output of the gun to the character's health
+					raiu->hp -= projectiles->damage[i];
+
+					// State switches to "Game Ending" if the character's hp is at 0 or less
+					if (raiu->hp <= 0)
+						frame.state = STATE_GAME_ENDING;
+
+					projectiles->hit[i] = true;
+				}
+
+				// Activate the laser hit timer
+				projectiles->hit_timer[i] = 0;
+			}
+		}
+
+		// Update the laser hit effect timer while the laser had just hit an object
+		if (projectiles->hit_timer[i] >= 0) {
+			if (projectiles->hit_timer[i] <= FX_NORMAL_DURATION)
+				projectiles->hit_timer[i] += elapsed_time;
+			else {
+				Remove_Projectile (i);
+				continue;
+			}
+		}
+	}
+
+	// Move the lasers that are left along their trajectories
+	Jobs_Parallel_For (Move_Projectiles, &seconds, projectiles->used, PROJECTILE_JOB_GRAIN);
+
+	if (NOT running)
+		return;
+
+	// Apply the character laser hits that are due
+	laser_clock += elapsed_time;
+	while (num_laser_hits > 0 AND laser_hits[0].time <= laser_clock) {
+		int laser = laser_hits[0].laser;
+		int target = projectiles->target[laser];
+		Cancel_Laser_Hit (laser);
+
+		// Subract the damage output of the laser to the enemy's health
+		enemies->hp[target] -= projectiles->damage[laser];
+
+		// Enemy is destroyed if its hp is at 0 or less (the laser keeps flying without a target)
+		if (enemies->hp[target] <= 0) {
+			projectiles->target[laser] = -1;
+			Defeat_Hoshu (target);
+		}
+		// Activate laser hit timer otherwise
+		else
+			projectiles->hit_timer[laser] = 0;
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Move_Projectiles
+|
+| Input: Called from Update_Projectiles (on any job thread)
+| Output: Moves the live projectiles in slots start to end - 1 by their
+|   velocity times the seconds pointed to by data.
+|___________________________________________________________________*/
+
+static void Move_Projectiles (void *data, int start, int end)
+{
+	Projectiles *projectiles = &frame.projectiles;
+	float seconds = *(float *)data;
+
+	for (int i = start; i < end; i++) {
+		if (NOT projectiles->live[i])
+			continue;
+		projectiles->x[i] += projectiles->vx[i] * seconds;
+		projectiles->y[i] += projectiles->vy[i] * seconds;
+		projectiles->z[i] += projectiles->vz[i] * seconds;
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Schedule_Laser_Hit
+|
+| Input: Called from Process_Input, Reschedule_Laser_Hits
+| Output: Finds the first Hoshu that character laser i will hit and
+|   adds the hit to the queue (replacing any hit already queued for
+|   the laser).  Hoshus stand still in the world frame, so the time of
+|   impact only depends on the laser's own trajectory.
+|___________________________________________________________________*/
+
+static void Schedule_Laser_Hit (int i)
+{
+	Projectiles *projectiles = &frame.projectiles;
+	Enemy *enemies = &frame.enemies;
+	float radii = projectiles->radius[i] + config.hoshu_sphere.radius;
+	int start, end;
+
+	Cancel_Laser_Hit (i);
+	projectiles->target[i] = -1;
+
+	// Only the Hoshus ahead of the laser along z can be hit
+	if (projectiles->vz[i] >= 0) {
+		start = Find_Hoshu (projectiles->z[i] - radii, false);
+		end = enemies->count;
+	}
+	else {
+		start = 0;
+		end = Find_Hoshu (projectiles->z[i] + radii, true);
+	}
+
+	float earliest = 0;
+	for (int k = start; k < end; k++) {
+		int j = HOSHU_SLOT(enemies, k);
+		float collision_time;
+
+		if (enemies->active[j] AND enemies->explosion_timer[j] == -1 AND Laser_Hit_Time (i, j, &collision_time))
+			if (projectiles->target[i] == -1 OR collision_time < earliest) {
+				projectiles->target[i] = j;
+				earliest = collision_time;
+			}
+	}
+
+	if (projectiles->target[i] >= 0)
+		Queue_Laser_Hit (i, laser_clock + (unsigned)ceilf(earliest));
+}
+
+/*____________________________________________________________________
+|
+| Function: Reschedule_Laser_Hits
+|
+| Input: Called from Spawn_Hoshu, Defeat_Hoshu, Retire_Hoshus
+| Output: Updates the queued hits after Hoshu i spawned or is gone.
+|   Lasers aimed at it look for a new target, and lasers that would
+|   reach a newly spawned Hoshu first are aimed at it.
+|___________________________________________________________________*/
+
+static void Reschedule_Laser_Hits (int i)
+{
+	Enemy *enemies = &frame.enemies;
+	Projectiles *projectiles = &frame.projectiles;
+	bool spawned = enemies->active[i] AND enemies->explosion_timer[i] == -1;
+
+	for (int n = 0; n < num_raiu_lasers; n++) {
+		int j = raiu_laser[n];
+		float collision_time;
+
+		// Skip lasers that are not flying towards a target
+		if (projectiles->hit_timer[j] >= 0)
+			continue;
+
+		if (projectiles->target[j] == i AND NOT spawned)
+			Schedule_Laser_Hit (j);
+		else if (spawned AND Laser_Hit_Time (j, i, &collision_time)) {
+			unsigned time = laser_clock + (unsigned)ceilf(collision_time);
+			int n = Find_Laser_Hit (j);
+			if (n == -1 OR time < laser_hits[n].time) {
+				projectiles->target[j] = i;
+				Queue_Laser_Hit (j, time);
+			}
+		}
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Laser_Hit_Time
+|
+| Input: Called from Schedule_Laser_Hit, Reschedule_Laser_Hits
+| Output: Returns true if the character laser in projectile slot laser
+|   will hit Hoshu i.  On return collision_time is the time until
+|   impact in milliseconds.
+|___________________________________________________________________*/
+
+static bool Laser_Hit_Time (int laser, int i, float *collision_time)
+{
+	Projectiles *projectiles = &frame.projectiles;
+	simSphere laser_sphere = { { projectiles->x[laser], projectiles->y[laser], projectiles->z[laser] }, projectiles->radius[laser] };
+	simTrajectory laser_trajectory = { { projectiles->vx[laser], projectiles->vy[laser], projectiles->vz[laser] }, 1 }; // velocity is already in the direction
+	simTrajectory hoshu_trajectory = { { 0, 0, -1 }, 0 }; // not moving in the world frame
+
+	return (Collide_Moving_Spheres (&laser_sphere, &laser_trajectory, FLT_MAX, &frame.enemies.sphere[i], &hoshu_trajectory, collision_time));
+}
+
+/*____________________________________________________________________
+|
+| Function: Queue_Laser_Hit
+|
+| Input: Called from Schedule_Laser_Hit, Reschedule_Laser_Hits
+| Output: Adds (or moves) the hit of character laser i in the time
+|   ordered queue.
+|___________________________________________________________________*/
+
+static void Queue_Laser_Hit (int i, unsigned time)
+{
+	Cancel_Laser_Hit (i);
+
+	// Keep the queue sorted by time (it holds at most one hit per laser)
+	int n = num_laser_hits++;
+	while (n > 0 AND laser_hits[n - 1].time > time) {
+		laser_hits[n] = laser_hits[n - 1];
+		n--;
+	}
+	laser_hits[n].time = time;
+	laser_hits[n].laser = i;
+}
+
+/*____________________________________________________________________
+|
+| Function: Cancel_Laser_Hit
+|
+| Input: Called from Update_Projectiles, Remove_Projectile,
+|   Schedule_Laser_Hit, Queue_Laser_Hit
+| Output: Removes the hit of character laser i from the queue, if any.
+|___________________________________________________________________*/
+
+static void Cancel_Laser_Hit (int i)
+{
+	int n = Find_Laser_Hit (i);
+
+	if (n == -1)
+		return;
+	for (num_laser_hits--; n < num_laser_hits; n++)
+		laser_hits[n] = laser_hits[n + 1];
+}
+
+/*____________________________________________________________________
+|
+| Function: Find_Laser_Hit
+|
+| Input: Called from Reschedule_Laser_Hits, Cancel_Laser_Hit
+| Output: Returns the position of the hit of character laser i in the
+|   queue (-1 if it has none).
+|___________________________________________________________________*/
+
+static int Find_Laser_Hit (int i)
+{
+	for (int n = 0; n < num_laser_hits; n++)
+		if (laser_hits[n].laser == i)
+			return (n);
+
+	return (-1);
+}
+
+/*____________________________________________________________________
+|
+| Function: Update_Raiu
+|
+| Input: Called from Run_Step
+| Output: Updates the character's effect, animation and blade timers.
+|___________________________________________________________________*/
+
+static void Update_Raiu (unsigned elapsed_time)
+{
+	Raiu *raiu = &frame.raiu;
+
+	// Update level up effect timer
+	if (frame.level_up_fx_timer >= 0) {
+		if (frame.level_up_fx_timer >= FX_NORMAL_DURATION)
+			frame.level_up_fx_timer = -1;
+		else
+			frame.level_up_fx_timer += elapsed_time;
+	}
+
+	// Running animation timer (-1 at the start of the animation)
+	if (frame.ani_raiu_run_time == -1)
+		frame.ani_raiu_run_time = 0;
+	else
+		frame.ani_raiu_run_time += elapsed_time;
+
+	// Update blade swing timer only if it is active
+	if (raiu->blade_timer >= 0) {
+
+		// Set blade to active on a specific time window depending on the type of blade swing animation
+		if (frame.play_swing_1 AND NOT frame.play_swing_2)
+			frame.blade_active = (raiu->blade_timer <= 300);
+		else if (frame.play_swing_2)
+			frame.blade_active = (raiu->blade_timer <= 400);
+
+		// Deactivate swing timer when its time limit is reached
+		if (raiu->blade_timer >= raiu->blade_delay) {
+			raiu->blade_timer = -1;
+			frame.play_swing_1 = false;
+			frame.play_swing_2 = false;
+		}
+		else
+			raiu->blade_timer += elapsed_time;
+	}
+
+	// Update heal effect timer
+	if (frame.heal_fx_timer >= 0 AND frame.heal_fx_timer < FX_NORMAL_DURATION * 2)
+		frame.heal_fx_timer += elapsed_time;
+	else if (frame.heal_fx_timer >= FX_NORMAL_DURATION)
+		frame.heal_fx_timer = -1;
+}
+
+/*____________________________________________________________________
+|
+| Function: Update_Ending
+|
+| Input: Called from Run_Step
+| Output: Plays the self destruct sequence, switching to the game over
+|   state once the self destruct sound effect has finished.
+|___________________________________________________________________*/
+
+static void Update_Ending (SimInput *input, unsigned elapsed_time)
+{
+	// Deactivate swing timer when it is active
+	if (frame.raiu.blade_timer != -1) {
+		frame.raiu.blade_timer = -1;
+		frame.play_swing_1 = false;
+		frame.play_swing_2 = false;
+	}
+
+	// The self destruct starts right after the speed had decreased to 0
+	if (frame.game_ending_speed_timer <= ENDING_SLOWDOWN_DURATION)
+		return;
+
+	// Activate the timer for self destruct
+	if (frame.ani_raiu_ending_time == -1) {
+		frame.ani_raiu_ending_time = 0;
+		Add_Event (SIM_EVENT_OUTRO_START, -1, &frame.raiu.pos);
+	}
+
+	// State switches to Game Over after the self destruct
+	else if (input->outro_done) {
+		frame.state = STATE_GAME_OVER;
+
+		// Destroy all enemies on screen and add their score values to the total score
+		for (int k = 0; k < frame.enemies.count; k++) {
+			int i = HOSHU_SLOT(&frame.enemies, k);
+			if (frame.enemies.active[i]) {
+				frame.score += frame.enemies.score_amt[i];
+				frame.enemies_defeated++;
+				frame.hoshus_defeated++;
+			}
+		}
+		frame.enemies.first = 0;
+		frame.enemies.count = 0;
+		frame.enemies.live = 0;
+	}
+
+	// Update otherwise
+	else
+		frame.ani_raiu_ending_time += elapsed_time;
+}
+
+/*____________________________________________________________________
+|
+| Function: Defeat_Hoshu
+|
+| Input: Called from Update_Hoshus, Update_Projectiles
+| Output: Awards score and experience for a destroyed enemy and starts
+|   its explosion.
+|___________________________________________________________________*/
+
+static void Defeat_Hoshu (int i)
+{
+	// add the enemy score amount to the total score if the max score is not reached (sets it to max score when reached)
+	if (frame.score != MAX_SCORE)
+		frame.score += frame.enemies.score_amt[i];
+	else
+		frame.score = MAX_SCORE;
+	// add the enemy exp amount to the character's total exp
+	frame.raiu.exp += frame.enemies.exp_amt[i];
+
+	// increment enemies defeated and Hoshus defeated
+	frame.enemies_defeated++;
+	frame.hoshus_defeated++;
+
+	// Initialize explosion timer on the enemy
+	frame.enemies.explosion_timer[i] = 0;
+
+	// Lasers aimed at it look for another target
+	Reschedule_Laser_Hits (i);
+}
+
+/*____________________________________________________________________
+|
+| Function: Retire_Hoshus
+|
+| Input: Called from Update_Hoshus
+| Output: Frees the slots at the front of the ring that are behind the
+|   camera or whose explosion has finished.  Character lasers aimed at
+|   a freed slot look for another target.
+|___________________________________________________________________*/
+
+static void Retire_Hoshus ()
+{
+	Enemy *enemies = &frame.enemies;
+
+	while (enemies->count > 0) {
+		int i = enemies->first;
+
+		if (enemies->active[i] AND enemies->pos[i].z > frame.ground_init_z + frame.scroll)
+			break;
+
+		if (enemies->active[i]) {
+			enemies->active[i] = false;
+			enemies->live--;
+			Reschedule_Laser_Hits (i);
+		}
+
+		// Lasers still showing a hit effect on it fall back to their own position
+		for (int n = 0; n < num_raiu_lasers; n++)
+			if (frame.projectiles.target[raiu_laser[n]] == i)
+				frame.projectiles.target[raiu_laser[n]] = -1;
+
+		enemies->first = (enemies->first + 1) % MAX_ENEMY_COUNT;
+		enemies->count--;
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Find_Hoshu
+|
+| Input: Called from Update_Blade, Schedule_Laser_Hit
+| Output: Returns the position in the ring (0 to count) of the nearest
+|   Hoshu with pos.z >= z (pos.z > z when after is true).
+|___________________________________________________________________*/
+
+static int Find_Hoshu (float z, bool after)
+{
+	Enemy *enemies = &frame.enemies;
+	int low = 0;
+	int high = enemies->count;
+
+	while (low < high) {
+		int k = (low + high) / 2;
+		float hoshu_z = enemies->pos[HOSHU_SLOT(enemies, k)].z;
+		if (hoshu_z < z OR (after AND hoshu_z == z))
+			low = k + 1;
+		else
+			high = k;
+	}
+
+	return (low);
+}
+
+/*____________________________________________________________________
+|
+| Function: Collide_Moving_Spheres
+|
+| Input: Called from Laser_Hit_Time
+| Output: Returns true if two moving spheres intersect within max_time
+|   milliseconds.  Trajectory velocities are in feet per second.  On
+|   return collision_time is the time of first contact in milliseconds
+|   (0 if the spheres are already intersecting).
+|___________________________________________________________________*/
+
+static bool Collide_Moving_Spheres (simSphere *s1, simTrajectory *t1, float max_time, simSphere *s2, simTrajectory *t2, float *collision_time)
+{
+	// Position and velocity of sphere 2 relative to sphere 1
+	float dx = s2->center.x - s1->center.x;
+	float dy = s2->center.y - s1->center.y;
+	float dz = s2->center.z - s1->center.z;
+	float vx = t2->direction.x * t2->velocity - t1->direction.x * t1->velocity;
+	float vy = t2->direction.y * t2->velocity - t1->direction.y * t1->velocity;
+	float vz = t2->direction.z * t2->velocity - t1->direction.z * t1->velocity;
+	float r = s1->radius + s2->radius;
+
+	// Already intersecting?
+	float c = dx * dx + dy * dy + dz * dz - r * r;
+	if (c <= 0) {
+		*collision_time = 0;
+		return (true);
+	}
+
+	// Solve |d + vt| = r for the first time of contact
+	float a = vx * vx + vy * vy + vz * vz;
+	float b = dx * vx + dy * vy + dz * vz;
+	if (a == 0 OR b >= 0) // not moving towards each other
+		return (false);
+	float discriminant = b * b - a * c;
+	if (discriminant < 0)
+		return (false);
+	float t = ((-b - sqrtf(discriminant)) / a) * 1000.0f;
+	if (t > max_time)
+		return (false);
+
+	*collision_time = t;
+	return (true);
+}
+
+/*____________________________________________________________________
+|
+| Function: Add_Event
+|
+| Input: Called from Run_Step functions
+| Output: Records an event for the renderer.
+|___________________________________________________________________*/
+
+static void Add_Event (int type, int index, simVector *pos)
+{
+	if (frame.num_events < MAX_SIM_EVENTS) {
+		frame.event[frame.num_events].type = type;
+		frame.event[frame.num_events].index = index;
+		frame.event[frame.num_events].pos = *pos;
+		frame.event[frame.num_events].step = frame.steps;
+		frame.num_events++;
+	}
+}
+
+/*____________________________________________________________________
+|
+| Function: Add_World_Event
+|
+| Input: Called from Run_Step functions
+| Output: Records an event at a position in the world frame (events
+|   are reported in the character's frame).
+|___________________________________________________________________*/
+
+static void Add_World_Event (int type, int index, simVector *pos)
+{
+	simVector view_pos = *pos;
+
+	view_pos.z = SIM_VIEW_Z(&frame, pos->z);
+	Add_Event (type, index, &view_pos);
+}
+
+/*____________________________________________________________________
+|
+| Function: Random_Float
+|
+| Input: Called from Run_Step functions
+| Output: Returns a random number between 0 and 1.  Uses its own
+|   generator (xorshift) so a game is repeatable from its seed.
+|___________________________________________________________________*/
+
+static float Random_Float ()
+{
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return ((random_state >> 8) * (1.0f / 16777216.0f));
+}
+
+/*____________________________________________________________________
+|
+| Function: Random_Int
+|
+| Input: Called from Run_Step functions
+| Output: Returns a random number between low and high (inclusive).
+|___________________________________________________________________*/
+
+static int Random_Int (int low, int high)
+{
+	int n = low + (int)(Random_Float() * (high - low + 1));
+	return (n > high ? high : n);
+}
+
+/*____________________________________________________________________
+|
+| Function: Fast_Acos
+|
+| Input: Called from Aim_Hoshus
+| Output: Returns the arc cosine of x (-1 to 1) in radians, within
+|   0.0001 radians.  A polynomial fit (Abramowitz and Stegun 4.4.45),
+|   about 3 times faster than acosf.
+|___________________________________________________________________*/
+
+static float Fast_Acos (float x)
+{
+	float a = fabsf(x);
+	float r = (((-0.0187293f * a + 0.0742610f) * a - 0.2121144f) * a + 1.5707288f) * sqrtf(1 - a);
+
+	return (x < 0 ? 3.14159265f - r : r);
+}
+
+/*____________________________________________________________________
+|
+| Function: Inverse_Lerp
+|
+| Input: Called from sim.cpp, render.cpp and position.cpp
+| Output: Similar to gx3d_Lerp but calculates with decreasing values
+|___________________________________________________________________*/
+
+float Inverse_Lerp (float start, float end, float t)
+{
+	return (start - (1.0f - t) * (start - end));
+}
@@ -0,0 +1,275 @@
+/*____________________________________________________________________
+|
+| File: sim.h
+|
+| Description: Gameplay simulation for the game screen.  Owns the
+|   character, enemies, world structures, health pad and all gameplay
+|   timers.  Has no dependency on the graphics, sound or event layers.
+|___________________________________________________________________*/
+
+// Game States
+#define STATE_TITLE_SCREEN	0
+#define STATE_HELP_SCREEN	1
+#define STATE_STARTING		2
+#define STATE_RUNNING		3
+#define STATE_GAME_ENDING	4
+#define STATE_GAME_OVER		5
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#define MAX_STRUCTURE_COUNT		10
+#ifndef MAX_ENEMY_COUNT
+#define MAX_ENEMY_COUNT			100
+#endif
+#define MAX_GAME_TIME			359999000 // 99 hrs 59 mins 59 secs all in milliseconds
+#define NORMAL_SPEED			((float) 100.0) // ((float)60.0) // feet per second
+#define RAIU_MAX_HP				1000
+#define HOSHU_MAX_HP			100
+#define HOSHU_MAX_LV			10
+#define HOSHU_SCORE				200
+#define HOSHU_EXP				100
+#define HOSHU_LASER_SCALE		3
+#define MAX_SCORE				999999999
+#define MAX_LV					10
+#define MAX_GROUND_LENGTH		((float)5000.0)
+#define MAX_PROJECTILE_DISTANCE 4000 // 4000 ft max projectile distance
+#ifndef MAX_PROJECTILE_COUNT
+#define MAX_PROJECTILE_COUNT	1024 // lasers in flight for the character and all enemies
+#endif
+#define PROJECTILE_OWNER_RAIU	0 // owner of the character's lasers (Hoshu ids start at 1)
+#define FX_NORMAL_DURATION		1000 // 1 second
+#define ENDING_SLOWDOWN_DURATION 2000 // time it takes the character to stop running at game ending
+#define STRUCTURE_SIDE_LEFT		-1
+#define STRUCTURE_SIDE_RIGHT	1
+#define STRUCTURE_SIDE_BOTH		0
+#define MAX_SIM_EVENTS			256
+#define SIM_STEP_TIME			8 // milliseconds per simulation step (125 Hz)
+#define SIM_MAX_STEPS			8 // most steps run by one update (longer hitches slow the game down)
+
+// Input buttons (held unless noted)
+#define SIM_INPUT_FAST			0x1 // run faster
+#define SIM_INPUT_SLOW			0x2 // run slower
+#define SIM_INPUT_FIRE			0x4 // shoot the ray gun (pressed this step)
+#define SIM_INPUT_SWING			0x8 // swing the blade (pressed this step)
+
+// Events generated during a step, for the renderer to play sounds, lights, etc.
+#define SIM_EVENT_INTRO_START		0 // starting animation begins
+#define SIM_EVENT_OUTRO_START		1 // self destruct animation begins
+#define SIM_EVENT_RAIU_FIRE			2 // character shot a laser
+#define SIM_EVENT_BLADE_SWING_1		3
+#define SIM_EVENT_BLADE_SWING_2		4
+#define SIM_EVENT_RAIU_HURT			5 // character was hit by an enemy laser
+#define SIM_EVENT_RAIU_LEVEL_UP		6
+#define SIM_EVENT_HOSHU_LEVEL_UP	7
+#define SIM_EVENT_HOSHU_FIRE		8
+#define SIM_EVENT_HOSHU_EXPLODE		9 // index = explosion type
+#define SIM_EVENT_EXPLOSION_END		10
+#define SIM_EVENT_HEAL_PAD_SPAWN	11
+#define SIM_EVENT_HEAL_PAD_TOUCH	12
+#define SIM_EVENT_HEAL_PAD_DESPAWN	13
+
+/*___________________
+|
+| Type definitions
+|__________________*/
+
+struct simVector {
+	float x, y, z;
+};
+
+struct simSphere {
+	simVector center;
+	float radius;
+};
+
+struct simTrajectory {
+	simVector direction;
+	float velocity;									// feet per second
+};
+
+// Structure for world structures
+struct World_Structures {
+	int type;
+	simVector pos;
+	int side;				// (-1) left | (0) both left and right | (1) right
+	bool spawned;			// is the structure currently spawned?
+	bool rotated = false;	// has the structure already been rotated when needed?
+};
+
+// Structure for the electric fence (or health pad)
+struct Health_Pad {
+	simSphere sphere;
+	simVector pos;
+	int heal_amt;
+	bool ps_enable = false;		// is the particle system activated on the pad?
+	bool draw = false;			// is it currently drawn in the world?
+};
+
+// Pool of laser projectiles for the character and the enemies (structure of arrays)
+// Free slots are reused from a free list; slots that were never used start at used.
+struct Projectiles {
+	int count;										// number of live projectiles
+	int used;										// slots [0, used) have been handed out at least once
+	int free_list[MAX_PROJECTILE_COUNT];			// released slots below used
+	int num_free;
+	bool live[MAX_PROJECTILE_COUNT];				// is the slot currently a projectile?
+	float x[MAX_PROJECTILE_COUNT];					// center of the bounding sphere
+	float y[MAX_PROJECTILE_COUNT];
+	float z[MAX_PROJECTILE_COUNT];
+	float vx[MAX_PROJECTILE_COUNT];					// velocity through the world (feet per second)
+	float vy[MAX_PROJECTILE_COUNT];
+	float vz[MAX_PROJECTILE_COUNT];
+	float radius[MAX_PROJECTILE_COUNT];				// radius of the bounding sphere
+	unsigned owner[MAX_PROJECTILE_COUNT];			// PROJECTILE_OWNER_RAIU or the id of the Hoshu that fired it
+	int damage[MAX_PROJECTILE_COUNT];				// damage given to the character (enemy lasers)
+	int target[MAX_PROJECTILE_COUNT];				// slot of the Hoshu a character laser is going to hit first (-1 if none)
+	float hit_timer[MAX_PROJECTILE_COUNT];			// timer that starts when the laser had just hit an object, enemies, or the character (-1 otherwise)
+	bool hit[MAX_PROJECTILE_COUNT];					// has the laser hit the character? (enemy lasers)
+	bool destroyed[MAX_PROJECTILE_COUNT];			// used on enemy lasers when the character has the blade active on the moment of impact
+};
+
+// Structure for enemies (structure of arrays)
+// Hoshus are kept in a ring in spawn order.  They all spawn at the same
+// distance ahead of the character and stand still in the world frame, so
+// the ring is also sorted by z (nearest first).  Hoshus retire from the
+// front once they are behind the camera, and z range queries can binary
+// search the ring.
+struct Enemy {
+	int first;										// slot of the nearest Hoshu
+	int count;										// number of slots in use, from first (including finished explosions)
+	int live;										// number of Hoshus still in the world
+	bool active[MAX_ENEMY_COUNT];					// false once its explosion has finished (slot is freed when it reaches the front)
+	unsigned id[MAX_ENEMY_COUNT];					// unique id given when spawned
+	simVector pos[MAX_ENEMY_COUNT];					// position
+	simSphere sphere[MAX_ENEMY_COUNT];				// bounding sphere
+	float angle[MAX_ENEMY_COUNT];					// rotation of the "top" layer towards the character (degrees)
+	int lv[MAX_ENEMY_COUNT];						// level
+	int hp[MAX_ENEMY_COUNT];						// health
+	int score_amt[MAX_ENEMY_COUNT];					// amount of score given when defeated
+	int exp_amt[MAX_ENEMY_COUNT];					// amount of experience points given when defeated
+	int gun_damage[MAX_ENEMY_COUNT];				// gun damage
+	unsigned gun_delay[MAX_ENEMY_COUNT];			// delay for shooting a laser
+	unsigned gun_timer[MAX_ENEMY_COUNT];			// timer for shooting delay
+	float fire_rate[MAX_ENEMY_COUNT];				// how fast the Hoshu can shoot a projectile with respect to the delay
+	float explosion_timer[MAX_ENEMY_COUNT];			// timer that starts for when the Hoshu was just destroyed (-1 disables the timer)
+	int explosion_type[MAX_ENEMY_COUNT];			// type of explosion initialized (-1 when not exploding)
+	bool blade_mark_1[MAX_ENEMY_COUNT];				// has the Hoshu already taken damage from blade swing 1?
+	bool blade_mark_2[MAX_ENEMY_COUNT];				// has the Hoshu already taken damage from blade swing 2?
+	int laser_index[MAX_ENEMY_COUNT];				// projectile of the last laser it fired (-1 if none)
+	unsigned next_id;								// id of the next spawned Hoshu
+};
+
+// Slot of the k-th nearest Hoshu (0 <= k < count)
+#define HOSHU_SLOT(enemies,k)	((enemies)->first + (k) < MAX_ENEMY_COUNT ? (enemies)->first + (k) : (enemies)->first + (k) - MAX_ENEMY_COUNT)
+
+// Structure for Raiu
+struct Raiu {
+	simSphere sphere;					// bounding sphere
+	simVector pos;						// position
+	simVector view;						// Raiu's normal view vector
+	int hp;								// health
+	int blade_lv;						// blade level
+	int blade_damage;					// blade damage
+	float blade_delay;					// delay for using the blade
+	float blade_timer;					// timer for using the blade
+	int gun_lv;							// gun level
+	int gun_damage;						// gun damage
+	unsigned gun_delay;					// delay for shooting the ray gun
+	unsigned gun_timer;					// timer for shooting delay
+	int exp;							// experience points
+};
+
+// Something that happened during a step (sound, light, etc.)
+struct SimEvent {
+	int type;
+	int index;							// entity index, if any (-1 otherwise)
+	simVector pos;
+	unsigned step;						// step it happened in (SimFrame steps)
+};
+
+// Parameters the simulation needs from loaded assets
+struct SimConfig {
+	simSphere raiu_sphere;				// bounding spheres of the models
+	simSphere hoshu_sphere;
+	simSphere laser_sphere;
+	simSphere fence_sphere;
+	float boundary_x;					// character and spawn boundary on the x axis
+	unsigned seed;						// random number seed
+};
+
+// Input for one step
+struct SimInput {
+	unsigned buttons;					// SIM_INPUT_*
+	simVector pos;						// character position (from Position_Update)
+	simVector view;						// character heading (from Position_Update)
+	bool paused;
+	bool intro_done;					// has the starting sound effect finished?
+	bool outro_done;					// has the self destruct sound effect finished?
+};
+
+// Time being drawn, between the last two steps
+struct SimDraw {
+	float scroll;						// scroll at the time being drawn
+	float lag;							// time the drawn world lags behind the last step (seconds)
+};
+
+// State of the game after a step
+// The world (structures, ground, health pad, enemies and projectiles) is
+// stored in a world frame that does not scroll.  The character, the
+// events and ground_init_z are in the character's frame, which moves
+// forward by distance every step.  Use SIM_VIEW_Z to go from one to the
+// other.
+struct SimFrame {
+	int state;							// STATE_STARTING, STATE_RUNNING, STATE_GAME_ENDING or STATE_GAME_OVER
+	Raiu raiu;
+	Enemy enemies;
+	Projectiles projectiles;			// lasers fired by the character and the enemies
+	World_Structures structure[MAX_STRUCTURE_COUNT];
+	Health_Pad heal_pad;
+	int score;
+	unsigned game_timer;				// amount of time since the game has started
+	int enemies_defeated;				// number of enemies defeated so far
+	int hoshus_defeated;				// number of Hoshus defeated since the last enemy level up
+	int hoshu_lv;
+	int current_max_enemy_count;
+	float speed;						// world speed (feet per second)
+	float spd_multiplier;
+	float distance;						// world shift performed in this step
+	float scroll;						// world z of the character's frame origin (reset to 0 now and then to keep precision)
+	SimDraw draw;						// time being drawn when the update ended
+	unsigned steps;						// number of steps run since the game started
+	float ground_init_z, ground_1_z, ground_2_z;
+	float entrance_delay_timer;
+	float ani_raiu_entrance_time, ani_raiu_run_time, ani_raiu_ending_time;
+	unsigned game_ending_speed_timer;
+	float level_up_fx_timer;			// level up effect timer (-1 when inactive)
+	float heal_fx_timer;				// heal effect timer (-1 when inactive)
+	bool play_swing_1, play_swing_2, blade_active;
+	SimEvent event[MAX_SIM_EVENTS];		// events generated in the last update
+	int num_events;
+};
+
+// z of a world frame position in the character's frame
+#define SIM_VIEW_Z(frame,z)	((z) - (frame)->scroll)
+
+// Same as SIM_VIEW_Z at the time being drawn
+#define SIM_DRAW_Z(draw,z)	((z) - (draw)->scroll)
+
+/*___________________
+|
+| Functions
+|__________________*/
+
+// Starts a new game
+void Sim_Init (SimConfig *config);
+
+// Advances the game in fixed steps of SIM_STEP_TIME, carrying over the time left
+const SimFrame *Sim_Update (SimInput *input, unsigned elapsed_time);
+
+// Returns the state after the last step
+const SimFrame *Sim_Get_Frame ();
+
+float Inverse_Lerp (float start, float end, float t);
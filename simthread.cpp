@@ -0,0 +1,343 @@
+/*____________________________________________________________________
+|
+| File: simthread.cpp
+|
+| Description: Runs the gameplay simulation on its own thread so the
+|   steps for the next frame overlap the drawing of the current one.
+|   - Frame snapshots go to the game screen through a triple buffer: the
+|     simulation thread fills its back buffer and swaps it with the
+|     newest one, and the game screen swaps the newest one with the one
+|     it holds.  Neither side waits and the held snapshot never changes
+|     while it is being drawn.
+|   - Input comes back through a second triple buffer.  Presses are
+|     collected in an atomic mask so none are lost or repeated.
+|   - Events go through a single producer, single consumer ring.  The
+|     game screen only reads the ones from steps its snapshot includes.
+|
+| Functions: Sim_Thread_Start
+|            Sim_Thread_Stop
+|            Sim_Thread_Set_Input
+|            Sim_Thread_Get_Frame
+|            Sim_Thread_Get_Event
+|             Sim_Thread_Run
+|             Wait_Until
+|             Clock
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "sim.h"
+#include "simthread.h"
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define BUFFER_INDEX		3 // mask of the buffer index in a latest_* value
+#define BUFFER_NEW			4 // set in a latest_* value until the other side takes the buffer
+#define SIM_PRESSES			(SIM_INPUT_FIRE | SIM_INPUT_SWING)
+#define EVENT_RING_SIZE		(MAX_SIM_EVENTS * 4) // power of 2
+
+#if defined(_WIN32) AND NOT defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION	0x00000002
+#endif
+
+/*___________________
+|
+| Type definitions
+|__________________*/
+
+// A frame published by the simulation thread
+struct Snapshot {
+	SimFrame frame;
+	double time;						// Clock() when it was published (seconds)
+};
+
+/*___________________
+|
+| Function prototypes
+|__________________*/
+
+static void Sim_Thread_Run ();
+static void Wait_Until (double deadline);
+static double Clock ();
+
+/*___________________
+|
+| Global variables
+|__________________*/
+
+static std::thread sim_thread;
+static std::atomic<bool> running;
+
+// Frame snapshots (simulation thread -> game screen)
+static Snapshot snapshot[3];
+static std::atomic<unsigned> latest_snapshot;
+static unsigned back_snapshot;			// owned by the simulation thread
+static unsigned front_snapshot;			// owned by the game screen
+
+// Input (game screen -> simulation thread)
+static SimInput input_buffer[3];
+static std::atomic<unsigned> latest_input;
+static unsigned back_input;				// owned by the game screen
+static unsigned front_input;			// owned by the simulation thread
+static std::atomic<unsigned> presses;	// SIM_PRESSES not taken by a step yet
+
+#ifdef _WIN32
+static HANDLE step_timer;				// high resolution timer the simulation thread waits on (NULL if not supported)
+#endif
+
+// Events (simulation thread -> game screen)
+static SimEvent event_ring[EVENT_RING_SIZE];
+static std::atomic<unsigned> event_read, event_write;
+
+/*____________________________________________________________________
+|
+| Function: Sim_Thread_Start
+|
+| Input: Called from Render_GameScreen
+| Output: Starts the simulation thread from the state set by Sim_Init.
+|___________________________________________________________________*/
+
+void Sim_Thread_Start (SimInput *input)
+{
+	Sim_Thread_Stop ();
+
+	// Every buffer starts with the state before the first step
+	for (int i = 0; i < 3; i++) {
+		snapshot[i].frame = *Sim_Get_Frame ();
+		snapshot[i].time = Clock ();
+		input_buffer[i] = *input;
+		input_buffer[i].buttons &= ~SIM_PRESSES;
+	}
+	back_snapshot = 0;
+	latest_snapshot.store (1);
+	front_snapshot = 2;
+	back_input = 0;
+	latest_input.store (1);
+	front_input = 2;
+	presses.store (input->buttons & SIM_PRESSES);
+	event_read.store (0);
+	event_write.store (0);
+
+	running.store (true);
+	sim_thread = std::thread (Sim_Thread_Run);
+}
+
+/*____________________________________________________________________
+|
+| Function: Sim_Thread_Stop
+|
+| Input: Called from Render_Game_Loop, Sim_Thread_Start
+| Output: Waits for the simulation thread to finish its update and
+|   stop.  Sim_Get_Frame is safe to call afterwards.
+|___________________________________________________________________*/
+
+void Sim_Thread_Stop ()
+{
+	if (NOT sim_thread.joinable ())
+		return;
+
+	running.store (false, std::memory_order_release);
+	sim_thread.join ();
+}
+
+/*____________________________________________________________________
+|
+| Function: Sim_Thread_Set_Input
+|
+| Input: Called from Render_GameScreen
+| Output: Publishes the input for the next update of the simulation.
+|___________________________________________________________________*/
+
+void Sim_Thread_Set_Input (SimInput *input)
+{
+	presses.fetch_or (input->buttons & SIM_PRESSES, std::memory_order_release);
+
+	input_buffer[back_input] = *input;
+	input_buffer[back_input].buttons &= ~SIM_PRESSES;
+	back_input = latest_input.exchange (back_input | BUFFER_NEW, std::memory_order_acq_rel) & BUFFER_INDEX;
+}
+
+/*____________________________________________________________________
+|
+| Function: Sim_Thread_Get_Frame
+|
+| Input: Called from Render_GameScreen
+| Output: Returns the newest snapshot and sets draw to the time to draw
+|   it at: the time being drawn when it was published, moved up by the
+|   time since, so the world keeps moving smoothly between steps.
+|___________________________________________________________________*/
+
+const SimFrame *Sim_Thread_Get_Frame (SimDraw *draw)
+{
+	if (latest_snapshot.load (std::memory_order_acquire) & BUFFER_NEW)
+		front_snapshot = latest_snapshot.exchange (front_snapshot, std::memory_order_acq_rel) & BUFFER_INDEX;
+
+	const Snapshot *s = &snapshot[front_snapshot];
+	const SimFrame *frame = &s->frame;
+
+	// Draw up to the last step (it is the newest state there is)
+	float lag = frame->draw.lag - (float)(Clock () - s->time);
+	if (lag < 0)
+		lag = 0;
+	draw->scroll = frame->scroll - frame->distance * lag / (SIM_STEP_TIME / 1000.0f);
+	draw->lag = lag;
+
+	return (frame);
+}
+
+/*____________________________________________________________________
+|
+| Function: Sim_Thread_Get_Event
+|
+| Input: Called from Render_GameScreen
+| Output: Copies the oldest unread event to event.  Returns false if
+|   there are no unread events from the steps of the snapshot returned
+|   by the last Sim_Thread_Get_Frame (newer ones wait for the snapshot
+|   that shows them).
+|___________________________________________________________________*/
+
+bool Sim_Thread_Get_Event (SimEvent *event)
+{
+	unsigned read = event_read.load (std::memory_order_relaxed);
+
+	if (read == event_write.load (std::memory_order_acquire))
+		return (false);
+
+	const SimEvent *e = &event_ring[read & (EVENT_RING_SIZE - 1)];
+	if (e->step > snapshot[front_snapshot].frame.steps)
+		return (false);
+
+	*event = *e;
+	event_read.store (read + 1, std::memory_order_release);
+
+	return (true);
+}
+
+/*____________________________________________________________________
+|
+| Function: Sim_Thread_Run
+|
+| Input: Called from Sim_Thread_Start (on the simulation thread)
+| Output: Updates the game until stopped, publishing a snapshot after
+|   every update that ran a step.  Sleeps until the next step is due
+|   between updates.
+|___________________________________________________________________*/
+
+static void Sim_Thread_Run ()
+{
+	double last_time = Clock ();
+	double time_left = 0; // fraction of a millisecond not passed to Sim_Update yet (seconds)
+	unsigned last_steps = Sim_Get_Frame ()->steps;
+
+#ifdef _WIN32
+	step_timer = CreateWaitableTimerExW (NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+#endif
+
+	while (running.load (std::memory_order_acquire)) {
+		double new_time = Clock ();
+		time_left += new_time - last_time;
+		last_time = new_time;
+		unsigned elapsed_time = (unsigned)(time_left * 1000);
+		time_left -= elapsed_time / 1000.0;
+
+		// Take the newest input and the presses since the last update
+		if (latest_input.load (std::memory_order_acquire) & BUFFER_NEW)
+			front_input = latest_input.exchange (front_input, std::memory_order_acq_rel) & BUFFER_INDEX;
+		SimInput input = input_buffer[front_input];
+		input.buttons |= presses.exchange (0, std::memory_order_acq_rel);
+
+		// Time stands still while the game is paused
+		const SimFrame *frame = Sim_Update (&input, input.paused ? 0 : elapsed_time);
+
+		// Queue the events (the newest ones are dropped if the game screen has fallen too far behind)
+		for (int i = 0; i < frame->num_events; i++) {
+			unsigned write = event_write.load (std::memory_order_relaxed);
+			if (write - event_read.load (std::memory_order_acquire) == EVENT_RING_SIZE)
+				break;
+			event_ring[write & (EVENT_RING_SIZE - 1)] = frame->event[i];
+			event_write.store (write + 1, std::memory_order_release);
+		}
+
+		// Publish the new state
+		if (frame->steps != last_steps) {
+			last_steps = frame->steps;
+			snapshot[back_snapshot].frame = *frame;
+			snapshot[back_snapshot].time = Clock ();
+			back_snapshot = latest_snapshot.exchange (back_snapshot | BUFFER_NEW, std::memory_order_acq_rel) & BUFFER_INDEX;
+		}
+
+		// The next step is due once the part of a step not simulated yet has passed
+		Wait_Until (last_time + frame->draw.lag - time_left);
+	}
+
+#ifdef _WIN32
+	if (step_timer) {
+		CloseHandle (step_timer);
+		step_timer = NULL;
+	}
+#endif
+}
+
+/*____________________________________________________________________
+|
+| Function: Wait_Until
+|
+| Input: Called from Sim_Thread_Run
+| Output: Sleeps until Clock() reaches deadline (seconds).  Returns at
+|   once if it has already passed.
+|___________________________________________________________________*/
+
+static void Wait_Until (double deadline)
+{
+	double wait = deadline - Clock ();
+
+	if (wait <= 0)
+		return;
+
+#ifdef _WIN32
+	// Sleep() and sleep_for() round up to the 15.6 ms system tick, which is longer than a step
+	if (step_timer) {
+		LARGE_INTEGER due;
+		due.QuadPart = -(LONGLONG)(wait * 10000000); // relative, in 100 ns units
+		if (SetWaitableTimer (step_timer, &due, 0, NULL, NULL, FALSE)) {
+			WaitForSingleObject (step_timer, INFINITE);
+			return;
+		}
+	}
+#endif
+
+	std::this_thread::sleep_for (std::chrono::duration<double> (wait));
+}
+
+/*____________________________________________________________________
+|
+| Function: Clock
+|
+| Input: Called from simthread.cpp functions
+| Output: Returns a steady time in seconds.
+|___________________________________________________________________*/
+
+static double Clock ()
+{
+	return (std::chrono::duration<double> (std::chrono::steady_clock::now ().time_since_epoch ()).count ());
+}
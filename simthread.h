@@ -0,0 +1,26 @@
+/*____________________________________________________________________
+|
+| File: simthread.h
+|
+| Description: Runs the gameplay simulation on its own thread.  The
+|   game screen hands over its input and reads the newest frame snapshot
+|   and the events without ever waiting on the simulation.  Include
+|   after sim.h.
+|___________________________________________________________________*/
+
+// Starts stepping the game on the simulation thread (call after Sim_Init)
+void Sim_Thread_Start (SimInput *input);
+
+// Stops the simulation thread (does nothing if it is not running)
+void Sim_Thread_Stop ();
+
+// Sends the input for the next steps (presses are kept until a step uses them)
+void Sim_Thread_Set_Input (SimInput *input);
+
+// Returns the newest snapshot of the game, unchanged until the next call,
+// and the time to draw it at
+const SimFrame *Sim_Thread_Get_Frame (SimDraw *draw);
+
+// Takes the oldest event not read yet from the steps of that snapshot.
+// Returns false if there is none.
+bool Sim_Thread_Get_Event (SimEvent *event);
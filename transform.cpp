@@ -0,0 +1,297 @@
+/*____________________________________________________________________
+|
+| File: transform.cpp
+|
+| Description: Transform cache.  gx3d keeps the hierarchy of an object's
+|   layers and recomputes the world matrix of every layer whenever it is
+|   asked to, whether or not a local matrix changed.  Here each layer
+|   (node) keeps a copy of its local matrix and each object a dirty bit,
+|   set when one of its layers gets a different matrix and cleared when
+|   its transforms are updated.  The world matrices gx3d computed are
+|   then reused until a layer of the object really moves.
+|   Nodes and objects are found by address in two small open addressed
+|   tables.  When a table is full the cache steps aside: matrices are
+|   always set and transforms always updated.
+|
+| Functions: Transform_Reset
+|            Transform_Begin_Frame
+|            Transform_Set
+|            Transform_Update
+|            Transform_Frame_Stats
+|            Transform_Report
+|             Find_Node
+|             Find_Object
+|             Hash
+|___________________________________________________________________*/
+
+/*___________________
+|
+| Include Files
+|__________________*/
+
+#include <first_header.h>
+#include "dp.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "transform.h"
+
+/*___________________
+|
+| Constants
+|__________________*/
+
+#ifndef NOT
+#define NOT	!
+#define AND	&&
+#define OR	||
+#endif
+
+#define MAX_TRANSFORM_NODES		1024 // layers (and objects) with a cached matrix, a power of 2
+#define MAX_TRANSFORM_OBJECTS	128  // objects with a dirty bit, a power of 2
+
+/*___________________
+|
+| Type definitions
+|__________________*/
+
+// Matrix last set on a layer (or on an object when layer is 0)
+struct Transform_Node {
+	gx3dObject *object;					// 0 marks a free entry
+	gx3dObjectLayer *layer;
+	gx3dMatrix local;
+};
+
+// Objects whose world matrices may be out of date
+struct Transform_Object {
+	gx3dObject *object;					// 0 marks a free entry
+	bool dirty;
+};
+
+/*___________________
+|
+| Function prototypes
+|__________________*/
+
+static Transform_Node *Find_Node (gx3dObject *object, gx3dObjectLayer *layer, bool *found);
+static Transform_Object *Find_Object (gx3dObject *object);
+static unsigned Hash (void *p);
+
+/*___________________
+|
+| Global variables
+|__________________*/
+
+static Transform_Node node[MAX_TRANSFORM_NODES];
+static Transform_Object object_state[MAX_TRANSFORM_OBJECTS];
+
+// Transforms recomputed and reused in the current frame, the last frame
+// and all the frames since the last report
+static unsigned recomputed, reused;
+static unsigned last_recomputed, last_reused;
+static unsigned total_recomputed, total_reused, total_frames;
+
+/*____________________________________________________________________
+|
+| Function: Transform_Reset
+|
+| Input: Called from Free_TitleScreen, Free_GameScreen,
+|   Free_GameOverScreen
+| Output: Forgets every cached matrix.
+|___________________________________________________________________*/
+
+void Transform_Reset ()
+{
+	memset (node, 0, sizeof(node));
+	memset (object_state, 0, sizeof(object_state));
+}
+
+/*____________________________________________________________________
+|
+| Function: Transform_Begin_Frame
+|
+| Input: Called from Display_LoadingScreen, Render_TitleScreen,
+|   Render_GameScreen, Render_GameOverScreen
+| Output: Keeps the counts of the frame that ended and starts new ones.
+|___________________________________________________________________*/
+
+void Transform_Begin_Frame ()
+{
+	last_recomputed = recomputed;
+	last_reused = reused;
+	total_recomputed += recomputed;
+	total_reused += reused;
+	total_frames++;
+	recomputed = 0;
+	reused = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Transform_Set
+|
+| Input: Called from render.cpp, Glyphs_Draw, Draw_List_Execute
+| Output: Sets the matrix of a layer (or object) if it differs from the
+|   one last set, marking the object dirty.  Returns true if it changed.
+|___________________________________________________________________*/
+
+bool Transform_Set (gx3dObject *object, gx3dObjectLayer *layer, gx3dMatrix *m)
+{
+	bool found;
+	Transform_Node *n = Find_Node (object, layer, &found);
+
+	if (found AND memcmp (&n->local, m, sizeof(gx3dMatrix)) == 0)
+		return (false);
+
+	if (layer == 0)
+		gx3d_SetObjectMatrix (object, m);
+	else
+		gx3d_SetObjectLayerMatrix (object, layer, m);
+	Transform_Object *o = Find_Object (object);
+	if (o)
+		o->dirty = true;
+
+	if (n) {
+		n->object = object;
+		n->layer = layer;
+		n->local = *m;
+	}
+
+	return (true);
+}
+
+/*____________________________________________________________________
+|
+| Function: Transform_Update
+|
+| Input: Called from render.cpp, Glyphs_Draw, Draw_List_Execute
+| Output: Updates the transforms of an object that has a layer matrix
+|   changed since its last update.
+|___________________________________________________________________*/
+
+void Transform_Update (gx3dObject *object)
+{
+	Transform_Object *o = Find_Object (object);
+
+	if (o AND NOT o->dirty) {
+		reused++;
+		return;
+	}
+
+	gx3d_Object_UpdateTransforms (object);
+	if (o)
+		o->dirty = false;
+	recomputed++;
+}
+
+/*____________________________________________________________________
+|
+| Function: Transform_Frame_Stats
+|
+| Input: Called from Transform_Report
+| Output: Returns the transforms recomputed and reused in the last whole
+|   frame.
+|___________________________________________________________________*/
+
+void Transform_Frame_Stats (unsigned *frame_recomputed, unsigned *frame_reused)
+{
+	*frame_recomputed = last_recomputed;
+	*frame_reused = last_reused;
+}
+
+/*____________________________________________________________________
+|
+| Function: Transform_Report
+|
+| Input: Called from Render_TitleScreen, Render_GameScreen,
+|   Render_GameOverScreen
+| Output: Writes to DEBUG.TXT the average transforms recomputed and
+|   reused per frame since the last report, and starts counting again.
+|___________________________________________________________________*/
+
+void Transform_Report (char *screen)
+{
+	char str[200];
+	unsigned frame_recomputed, frame_reused;
+
+	Transform_Frame_Stats (&frame_recomputed, &frame_reused);
+	if (total_frames) {
+		sprintf (str, "%s: %u transforms recomputed, %u reused per frame (last frame %u, %u) over %u frames",
+			screen, total_recomputed / total_frames, total_reused / total_frames, frame_recomputed, frame_reused, total_frames);
+		DEBUG_WRITE (str);
+	}
+
+	total_recomputed = 0;
+	total_reused = 0;
+	total_frames = 0;
+}
+
+/*____________________________________________________________________
+|
+| Function: Find_Node
+|
+| Input: Called from Transform_Set
+| Output: Returns the node of a layer, setting found, or the free entry
+|   for it with found false.  Returns 0 if the table is full.
+|___________________________________________________________________*/
+
+static Transform_Node *Find_Node (gx3dObject *object, gx3dObjectLayer *layer, bool *found)
+{
+	unsigned h = Hash (layer ? (void *)layer : (void *)object);
+
+	*found = false;
+	for (int i = 0; i < MAX_TRANSFORM_NODES; i++) {
+		Transform_Node *n = &node[(h + i) & (MAX_TRANSFORM_NODES - 1)];
+		if (n->object == 0)
+			return (n);
+		if (n->object == object AND n->layer == layer) {
+			*found = true;
+			return (n);
+		}
+	}
+
+	return (0);
+}
+
+/*____________________________________________________________________
+|
+| Function: Find_Object
+|
+| Input: Called from Transform_Set, Transform_Update
+| Output: Returns the dirty bit entry of an object, adding it (dirty) if
+|   it is new.  Returns 0 if the table is full.
+|___________________________________________________________________*/
+
+static Transform_Object *Find_Object (gx3dObject *object)
+{
+	unsigned h = Hash (object);
+
+	for (int i = 0; i < MAX_TRANSFORM_OBJECTS; i++) {
+		Transform_Object *o = &object_state[(h + i) & (MAX_TRANSFORM_OBJECTS - 1)];
+		if (o->object == object)
+			return (o);
+		if (o->object == 0) {
+			o->object = object;
+			o->dirty = true;
+			return (o);
+		}
+	}
+
+	return (0);
+}
+
+/*____________________________________________________________________
+|
+| Function: Hash
+|
+| Input: Called from Find_Node, Find_Object
+| Output: Returns a hash of an address.
+|___________________________________________________________________*/
+
+static unsigned Hash (void *p)
+{
+	uintptr_t a = (uintptr_t)p >> 4; // heap blocks are aligned
+
+	return (((unsigned)(a ^ (a >> 15)) * 2654435761u) >> 16);
+}
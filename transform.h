@@ -0,0 +1,36 @@
+/*____________________________________________________________________
+|
+| File: transform.h
+|
+| Description: Cache of the object and layer matrices set on gx3d
+|   objects.  Each layer remembers the local matrix last set on it and
+|   each object whether one of its layers changed since its transforms
+|   were last updated, so setting a matrix a layer already has and
+|   updating an object nothing changed on are both skipped.  Everything
+|   that sets these matrices must go through here, or the cache no
+|   longer knows what is set.
+|   Include after dp.h.
+|___________________________________________________________________*/
+
+// Forgets every cached matrix (call when objects are freed, since a new
+// object can be loaded at the same address)
+void Transform_Reset ();
+
+// Starts counting the updates of a new frame
+void Transform_Begin_Frame ();
+
+// Sets the local matrix of a layer of an object (the object matrix when
+// layer is 0), unless it already has it.  Returns true if it changed.
+bool Transform_Set (gx3dObject *object, gx3dObjectLayer *layer, gx3dMatrix *m);
+
+// Recomputes the world matrices of the layers of an object, if a layer
+// matrix changed since the last update
+void Transform_Update (gx3dObject *object);
+
+// Gets the number of object transforms recomputed and reused in the last
+// whole frame
+void Transform_Frame_Stats (unsigned *recomputed, unsigned *reused);
+
+// Writes to DEBUG.TXT the transforms recomputed and reused per frame
+// since the last report
+void Transform_Report (char *screen);